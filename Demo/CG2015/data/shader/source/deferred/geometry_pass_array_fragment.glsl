@@ -0,0 +1,78 @@
+#version 330 core
+
+in vec2 uv;
+smooth in vec3 vertexWorldSpace;
+smooth in vec3 normalVectorWorldSpace;
+
+// Material textures, packed into texture arrays
+uniform sampler2DArray diffuse_texture;
+uniform sampler2DArray normal_texture;
+uniform sampler2DArray specular_texture;
+uniform sampler2DArray glow_texture;
+
+// Actually not needed here
+uniform sampler2DArray alpha_texture;
+
+// Two channel (BC5) normal maps only store x and y
+uniform bool normal_two_channel;
+
+// Layers of the material textures
+uniform int diffuse_layer;
+uniform int normal_layer;
+uniform int specular_layer;
+uniform int glow_layer;
+uniform int alpha_layer;
+
+// Diffuse color and glow value
+layout(location = 0) out vec4 diffuse_glow;
+// Normals and specular value
+layout(location = 1) out vec4 normal_specular;
+
+mat3 cotangent_frame( vec3 N, vec3 p, vec2 uv )
+{
+    // get edge vectors of the pixel triangle
+    vec3 dp1 = dFdx( p );
+    vec3 dp2 = dFdy( p );
+    vec2 duv1 = dFdx( uv );
+    vec2 duv2 = dFdy( uv );
+    
+    // solve the linear system
+    vec3 dp2perp = cross( dp2, N );
+    vec3 dp1perp = cross( N, dp1 );
+    vec3 T = dp2perp * duv1.x + dp1perp * duv2.x;
+    vec3 B = dp2perp * duv1.y + dp1perp * duv2.y;
+    
+    // construct a scale-invariant frame
+    float invmax = inversesqrt( max( dot(T,T), dot(B,B) ) );
+    return mat3( T * invmax, B * invmax, N );
+}
+
+vec3 perturb_normal( vec3 N, vec3 V, vec2 texcoord )
+{
+    vec3 map = texture( normal_texture, vec3( texcoord, normal_layer ) ).xyz * 255./127. - 128./127.;
+    if ( normal_two_channel )
+    {
+        // Reconstruct z of the unit length normal
+        map.z = sqrt( max( 1. - dot( map.xy, map.xy ), 0. ) );
+    }
+    mat3 TBN = cotangent_frame( N, -V, texcoord );
+    return normalize( TBN * map );
+}
+
+void main(void)
+{
+	vec3 color = texture(diffuse_texture, vec3(uv, diffuse_layer)).rgb;
+	vec3 normal = texture(normal_texture, vec3(uv, normal_layer)).rgb;
+	
+	float specular = texture(specular_texture, vec3(uv, specular_layer)).r;
+	float glow = texture(glow_texture, vec3(uv, glow_layer)).r;
+	//float alpha = texture(alpha_texture, vec3(uv, alpha_layer)).r;
+
+	// Write diffuse map with glow
+	diffuse_glow.rgb = color;
+	diffuse_glow.a = glow;
+	
+	// normal.rgb = textureNormal;
+    normal_specular.rgb = perturb_normal(normalVectorWorldSpace, vertexWorldSpace, uv);
+	normal_specular.a = specular;
+}
\ No newline at end of file
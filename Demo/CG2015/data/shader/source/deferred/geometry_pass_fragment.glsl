@@ -13,6 +13,9 @@ uniform sampler2D glow_texture;
 // Actually not needed here
 uniform sampler2D alpha_texture;
 
+// Two channel (BC5) normal maps only store x and y
+uniform bool normal_two_channel;
+
 // Diffuse color and glow value
 layout(location = 0) out vec4 diffuse_glow;
 // Normals and specular value
@@ -39,8 +42,12 @@ mat3 cotangent_frame( vec3 N, vec3 p, vec2 uv )
 
 vec3 perturb_normal( vec3 N, vec3 V, vec2 texcoord )
 {
-    vec3 map = texture( normal_texture, texcoord ).xyz;
-    map = map * 255./127. - 128./127.;
+    vec3 map = texture( normal_texture, texcoord ).xyz * 255./127. - 128./127.;
+    if ( normal_two_channel )
+    {
+        // Reconstruct z of the unit length normal
+        map.z = sqrt( max( 1. - dot( map.xy, map.xy ), 0. ) );
+    }
     mat3 TBN = cotangent_frame( N, -V, texcoord );
     return normalize( TBN * map );
 }
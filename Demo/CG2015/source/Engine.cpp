@@ -5,6 +5,7 @@
 #include <fmtlog/fmtlog.h>
 #include <kern/audio/SoundSystem.h>
 #include <kern/foundation/IniFile.h>
+#include <kern/foundation/JobSystem.h>
 #include <kern/foundation/JsonUtil.h>
 #include <kern/foundation/StringUtil.h>
 #include <kern/game/GameSystem.h>
@@ -33,7 +34,7 @@
 #include "state/TitleState.h"
 #include "state/WinState.h"
 
-Engine::Engine() {}
+Engine::Engine() : m_jobSystem(std::make_unique<JobSystem>(0)) {}
 
 Engine::~Engine() { m_gameSystem = nullptr; }
 
@@ -67,9 +68,13 @@ bool Engine::init(const char *configFile)
         loge("Failed to initialize resource manager.");
         return false;
     }
+#ifndef NDEBUG
+    // Reload edited shader sources while running
+    m_resourceManager->setHotReload(true);
+#endif
 
     // Create and initialize graphics system
-    m_graphicsSystem = std::make_shared<GraphicsSystem>();
+    m_graphicsSystem = std::make_shared<GraphicsSystem>(*m_jobSystem);
     if (!m_graphicsSystem->init(*m_resourceManager))
     {
         loge("Failed to initialize graphics system.");
@@ -253,6 +258,9 @@ void Engine::run()
         // Sound update
         m_soundSystem->update(timeDiff);
 
+        // Reload modified resource files
+        m_resourceManager->update();
+
         // Draw active scene from active camera with active rendering device
         m_graphicsSystem->draw(*m_window);
 
@@ -307,7 +315,7 @@ bool Engine::initGameSystem(const std::string &gameFile)
     // TODO Load from game file
     m_gameSystem->addState("load", new LoadState("data/world/load_1.json", 10.f));
     m_gameSystem->addState("title", new TitleState("data/world/intro_1.json"));
-    m_gameSystem->addState("game", new GamePlayState());
+    m_gameSystem->addState("game", new GamePlayState(*m_jobSystem));
     m_gameSystem->addState("lose", new LoseState("data/world/lose.json"));
     m_gameSystem->addState("win", new WinState("data/world/win.json"));
     if (!m_gameSystem->init("load", m_graphicsSystem.get(), m_inputProvider.get(), m_resourceManager.get(),
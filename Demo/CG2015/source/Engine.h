@@ -20,6 +20,9 @@ class Window;
 class IInputProvider;
 class SoundSystem;
 
+// Foundation
+class JobSystem;
+
 /**
  * \brief Demo application class.
  */
@@ -59,6 +62,9 @@ class Engine
     // Engine configuration
     EngineConfig m_engineConfig;
 
+    // Worker threads shared by all subsystems, destroyed after them
+    std::unique_ptr<JobSystem> m_jobSystem;
+
     // TODO Should use interface instead of concrete class.
     std::shared_ptr<GameSystem> m_gameSystem;           /**< Game system. */
     std::shared_ptr<IGraphicsSystem> m_graphicsSystem;   /**< Graphics system. */
@@ -1,7 +1,6 @@
 #include "control/HealthController.h"
 
 #include <kern/game/GameObject.h>
-#include <kern/graphics/collision/Collidable.h>
 
 HealthController::HealthController(float health) : m_health(health), m_active(true) { return; }
 
@@ -13,10 +12,20 @@ void HealthController::detach() { m_object = nullptr; }
 
 void HealthController::update(float dtime)
 {
-    if (m_active && m_object != nullptr && m_object->hasCollidable())
+    // Damage arrives as message
+}
+
+void HealthController::setActive(bool state) { m_active = state; }
+
+void HealthController::receiveMessage(Message msg) {}
+
+void HealthController::handleMessage(const SMessage &message)
+{
+    const SDamageMessage *damage = message.get<SDamageMessage>();
+    if (m_active && m_object != nullptr && message.type == Message::DAMAGE && damage != nullptr)
     {
         // Set health
-        m_health -= m_object->getCollidable()->getDamageReceived();
+        m_health -= damage->damage;
         if (m_health <= 0.f)
         {
             // Set object into death state
@@ -25,6 +34,4 @@ void HealthController::update(float dtime)
     }
 }
 
-void HealthController::setActive(bool state) { m_active = state; }
-
-void HealthController::receiveMessage(Message msg) {}
\ No newline at end of file
+bool HealthController::isParallel() const { return true; }
@@ -41,6 +41,16 @@ class HealthController : public IGameObjectController
 
     void receiveMessage(Message msg);
 
+    /**
+     * \brief Applies damage messages.
+     */
+    void handleMessage(const SMessage &message);
+
+    /**
+     * \brief Only writes to the attached object.
+     */
+    bool isParallel() const;
+
    private:
     GameObject *m_object = nullptr; /**< Controlled game object. */
     float m_health;                  /**< Health value. */
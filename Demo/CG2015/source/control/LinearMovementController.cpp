@@ -27,4 +27,6 @@ void LinearMovementController::update(float dtime)
 
 void LinearMovementController::setActive(bool state) { m_active = state; }
 
-void LinearMovementController::receiveMessage(Message msg) {}
\ No newline at end of file
+void LinearMovementController::receiveMessage(Message msg) {}
+
+bool LinearMovementController::isParallel() const { return true; }
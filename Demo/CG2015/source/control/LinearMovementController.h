@@ -19,6 +19,7 @@ class LinearMovementController : public IGameObjectController
     void update(float dtime);
     void setActive(bool state);
     void receiveMessage(Message msg);
+    bool isParallel() const;
 
    private:
     GameObject *m_object = nullptr; /**< Controlled game object. */
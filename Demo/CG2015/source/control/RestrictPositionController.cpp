@@ -61,4 +61,6 @@ void RestrictPositionController::update(float dtime)
 void RestrictPositionController::receiveMessage(Message msg)
 {
     // Empty
-}
\ No newline at end of file
+}
+
+bool RestrictPositionController::isParallel() const { return true; }
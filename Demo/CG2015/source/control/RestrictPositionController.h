@@ -48,6 +48,11 @@ class RestrictPositionController : public IGameObjectController
      */
     void receiveMessage(Message msg);
 
+    /**
+     * \brief Only writes to the attached object.
+     */
+    bool isParallel() const;
+
    private:
     GameObject *m_object = nullptr; /**< Controlled game object. */
     glm::vec2 m_minCoords;
@@ -61,6 +61,8 @@ void WeaponController::update(float dtime)
             m_resourceManager->getMesh(m_mesh, bulletVertices, bulletIndices, bulletNormals, bulletUvs, bulletType);
             bullet->setCollidable(m_collisionSystem->add(AABBox::create(bulletVertices), m_collisionGroup));
             bullet->getCollidable()->setDamage(50.f);
+            // Bullets are fast enough to pass through ships within one step
+            bullet->getCollidable()->setContinuous(true);
 
             // Create scene proxy
             SceneObjectProxy *proxy =
@@ -25,7 +25,7 @@
 const std::string exitStr = "lose";
 const std::string exitStrW = "win";
 
-GamePlayState::GamePlayState() : m_enemyCount(6), m_enemyTime(4.f), m_enemyXPosition(-75.f) {}
+GamePlayState::GamePlayState(JobSystem &jobs) : AGameState(jobs), m_enemyCount(6), m_enemyTime(4.f), m_enemyXPosition(-75.f) {}
 
 GamePlayState::~GamePlayState()
 {
@@ -37,7 +37,7 @@ bool GamePlayState::init(IGraphicsSystem *graphicsSystem, IInputProvider *inputP
 {
     // Sound
     m_soundSystem = soundSystem;
-    m_soundSystem->getManager()->registerSound("playbgm", "bgm/kim-lightyear-stardust-vision-ii-135754.mp3");
+    m_soundSystem->getManager()->registerSound("playbgm", "bgm/kim-lightyear-stardust-vision-ii-135754.mp3", true);
     m_soundSystem->getManager()->registerSound("shotsfx", "sfx/shoot02wav-14562.mp3");
     m_soundSystem->getManager()->registerSound("explosfx", "sfx/explosion-91872.mp3");
 
@@ -45,7 +45,7 @@ bool GamePlayState::init(IGraphicsSystem *graphicsSystem, IInputProvider *inputP
     m_bgmEmitter = m_soundSystem->getGlobalSoundEmitter();
     auto shotEmitter = m_soundSystem->createEmitter(soundSystem->getManager()->getSound("shotsfx"));
 
-    m_collisionSystem = new CollisionSystem();
+    m_collisionSystem = new CollisionSystem(getGameWorld().getJobSystem());
     m_graphicsSystem = graphicsSystem;
     m_inputProvider = inputProvider;
     m_resourceManager = resourceManager;
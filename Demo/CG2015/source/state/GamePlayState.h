@@ -16,7 +16,7 @@
 class GamePlayState : public AGameState
 {
    public:
-    GamePlayState();
+    GamePlayState(JobSystem &jobs);
     ~GamePlayState();
 
     bool init(IGraphicsSystem *graphicsSystem, IInputProvider *inputProvider, IResourceManager *resourceManager,
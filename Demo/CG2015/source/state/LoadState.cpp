@@ -47,7 +47,7 @@ bool LoadState::init(IGraphicsSystem *graphicsSystem, IInputProvider *inputProvi
     }
 
     // Load sound
-    soundSystem->getManager()->registerSound("loadbgm", "bgm/sion_-_ambients_-_stars_at_night.mp3");
+    soundSystem->getManager()->registerSound("loadbgm", "bgm/sion_-_ambients_-_stars_at_night.mp3", true);
     m_bgmSound = soundSystem->getManager()->getSound("loadbgm");
     m_bgmEmitter = soundSystem->getGlobalSoundEmitter();
     return true;
@@ -7,6 +7,9 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 #include <kern/audio/SoundSystem.h>
+#include <kern/foundation/AllocationCounter.h>
+#include <kern/foundation/JobSystem.h>
+#include <kern/foundation/MemoryReport.h>
 #include <kern/graphics/Window.h>
 #include <kern/graphics/animation/AnimationWorld.h>
 #include <kern/graphics/camera/FirstPersonCamera.h>
@@ -23,6 +26,7 @@
 
 RTRDemo::RTRDemo()
 {
+    m_jobSystem = std::make_unique<JobSystem>(0);
     m_soundSystem = std::make_unique<SoundSystem>("data/audio");
     m_bgMusic = m_soundSystem->createEmitter();
     m_bgSfx = m_soundSystem->createEmitter();
@@ -53,6 +57,10 @@ int RTRDemo::init(const std::string& configFile)
         loge("Failed to initialize resource manager.");
         return 1;
     }
+#ifndef NDEBUG
+    // Reload edited shader sources while running
+    m_resourceManager->setHotReload(true);
+#endif
 
     // Create animation world
     m_animationWorld = std::make_shared<AnimationWorld>();
@@ -85,13 +93,13 @@ int RTRDemo::init(const std::string& configFile)
     m_window->addListener(m_cameraController.get());
 
     // Sound
-    m_soundSystem->getManager()->registerSound("demobgm", "inspiring-cinematic-ambient-116199.mp3");
+    m_soundSystem->getManager()->registerSound("demobgm", "inspiring-cinematic-ambient-116199.mp3", true);
     auto soundBgm = m_soundSystem->getManager()->getSound("demobgm");
     m_bgMusic->setSound(soundBgm);
     m_bgMusic->setVolume(0.8);
     m_bgMusic->setLooping(true);
 
-    m_soundSystem->getManager()->registerSound("demosfx", "electric-windmill-74468.mp3");
+    m_soundSystem->getManager()->registerSound("demosfx", "electric-windmill-74468.mp3", true);
     auto soundSfx = m_soundSystem->getManager()->getSound("demosfx");
     m_bgSfx->setSound(soundSfx);
     m_bgSfx->setVolume(0.3);
@@ -106,6 +114,7 @@ int RTRDemo::run()
     double f2Cooldown = 0.0;
     double f3Cooldown = 0.0;
     double f5Cooldown = 0.0;
+    double f6Cooldown = 0.0;
     double k1Cooldown = 0.0;
     double timeDiff = 0.0;
 
@@ -122,12 +131,14 @@ int RTRDemo::run()
     do
     {
         double startTime = glfwGetTime();
+        beginAllocationFrame();
 
         // Cooldowns
         f1Cooldown -= timeDiff;
         f2Cooldown -= timeDiff;
         f3Cooldown -= timeDiff;
         f5Cooldown -= timeDiff;
+        f6Cooldown -= timeDiff;
         k1Cooldown -= timeDiff;
         fpsCoolDown -= timeDiff;
 
@@ -162,13 +173,32 @@ int RTRDemo::run()
             m_cameraController->loadSequence("data/democam.json");
         }
 
+        if (glfwGetKey(m_window->getGlfwHandle(), GLFW_KEY_F6) == GLFW_PRESS && f6Cooldown <= 0.f)
+        {
+            f6Cooldown = 0.3f;
+            MemoryReport report;
+            m_resourceManager->reportMemory(report);
+            m_graphicsResourceManager->reportMemory(report);
+            m_renderer->reportMemory(report);
+            m_soundSystem->getManager()->reportMemory(report);
+            if (report.save("memory.json"))
+            {
+                logi("Saved memory report to memory.json.");
+            }
+        }
+
         m_cameraController->animate((float)timeDiff);
 
+        m_resourceManager->update();
+        m_graphicsResourceManager->update();
         m_renderer->draw(*m_scene.get(), *m_camera.get(), *m_window.get(), *m_graphicsResourceManager.get());
 
         // Perform animation update
         m_animationWorld->update((float)timeDiff);
 
+        // Keeps streamed music playing
+        m_soundSystem->update((float)timeDiff);
+
         m_window->swapBuffer();
 
         // Update input
@@ -283,7 +313,7 @@ bool RTRDemo::initRenderer()
 
 bool RTRDemo::initScene()
 {
-    m_scene = std::make_shared<Scene>(m_graphicsResourceManager.get());
+    m_scene = std::make_shared<Scene>(m_graphicsResourceManager.get(), *m_jobSystem);
     SceneLoader loader(*m_resourceManager);
 
     // Get startup scene from config
@@ -17,6 +17,7 @@ class IGraphicsResourceManager;
 class AnimationWorld;
 class SoundSystem;
 class SoundEmitter;
+class JobSystem;
 
 /**
  * \brief Demo application class.
@@ -44,6 +45,8 @@ class RTRDemo
 
     IniFile m_config;
 
+    std::unique_ptr<JobSystem> m_jobSystem; /**< Worker threads shared by all subsystems, destroyed after them. */
+
     std::shared_ptr<IResourceManager> m_resourceManager = nullptr; /**< Resource loader and manager. */
     std::shared_ptr<IGraphicsResourceManager> m_graphicsResourceManager =
         nullptr; /**< Resource manager for graphics resources. */
@@ -26,7 +26,7 @@ RenderApplication::RenderApplication()
 
     // Sound
     m_soundSystem = std::make_shared<SoundSystem>("data/sounds/bgm");
-    m_soundSystem->getManager()->registerSound("bg", "lofi-chill-medium-version-159456.mp3");
+    m_soundSystem->getManager()->registerSound("bg", "lofi-chill-medium-version-159456.mp3", true);
 
     m_backgroundSoundEmitter = m_soundSystem->createEmitter();
     m_backgroundSoundEmitter->setLooping(true);
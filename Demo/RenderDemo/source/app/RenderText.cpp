@@ -8,105 +8,35 @@ RenderText::~RenderText()
 
 bool RenderText::setup()
 {
-    static const char* vertexCode = R"##(
-#version 460 core
-layout (location = 0) in vec4 vertex;
-out vec2 TexCoords;
-
-uniform mat4 projection;
-
-void main()
-{
-    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
-    TexCoords = vertex.zw;
-} 
-)##";
-
-    static const char* fragmentCode = R"##(
-#version 460 core
-
-in vec2 TexCoords;
-out vec4 color;
-
-uniform sampler2D text;
-uniform vec3 textColor;
-
-void main()
-{    
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-    color = vec4(textColor, 1.0) * sampled;
-} 
-)##";
-
-    // Shader
-    shader = std::make_unique<Shader>(vertexCode, fragmentCode);
-
     font = std::make_unique<Font>("data/fonts/OpenSans-Regular.ttf");
+    textBatch = std::make_unique<TextBatch>();
 
-    glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 600.0f);
-    shader->setActive();
-    shader->set("projection", projection);
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     return true;
 }
 
-void RenderText::renderText(std::string text, float x, float y, float scale, glm::vec3 color)
+void RenderText::render()
 {
-    // activate corresponding render state
-    shader->setActive();
-    shader->set("textColor", color);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
-
-    // iterate through all characters
-    for (char c : text)
+    // Dense debug text, thousands of glyphs share the draw calls of the lines below
+    std::string line;
+    for (int i = 0; i < 16; ++i)
     {
-        auto character = font->characters.at(c);
-
-        float xpos = x + character.bearing.x * scale;
-        float ypos = y - (character.size.y - character.bearing.y) * scale;
-
-        float w = character.size.x * scale;
-        float h = character.size.y * scale;
-        // update VBO for each character
-        float vertices[6][4] = {
-            {xpos, ypos + h, 0.0f, 0.0f}, {xpos, ypos, 0.0f, 1.0f},     {xpos + w, ypos, 1.0f, 1.0f},
-
-            {xpos, ypos + h, 0.0f, 0.0f}, {xpos + w, ypos, 1.0f, 1.0f}, {xpos + w, ypos + h, 1.0f, 0.0f}};
-        // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, character.textureId);
-        // update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-        x += (character.advance >> 6) * scale;  // bitshift by 6 to get value in pixels (2^6 = 64)
+        line += "0123456789 ";
+    }
+    for (int i = 0; i < 40; ++i)
+    {
+        textBatch->add(*font, line, glm::vec2(0.f, 130.f + i * 6.f), 0.12f, glm::vec4(0.4f, 0.4f, 0.4f, 1.f));
     }
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-}
 
-void RenderText::render()
-{
-    //
+    textBatch->add(*font, "This is sample text", glm::vec2(0.f, 0.f), 1.f, glm::vec4(1.f, 0.f, 0.f, 1.f));
+    textBatch->add(*font, "This is sample text", glm::vec2(25.f, 25.f), 1.f, glm::vec4(0.5f, 0.8f, 0.2f, 1.f));
+    textBatch->add(*font, "Grüße, señor! Ça va?\nÅngström", glm::vec2(25.f, 420.f), 0.75f,
+                   glm::vec4(1.f, 0.8f, 0.2f, 1.f));
+    textBatch->add(*font, "(C) LearnOpenGL.com", glm::vec2(540.f, 570.f), 0.5f, glm::vec4(0.3f, 0.7f, 0.9f, 1.f));
+    textBatch->add(*font, "Draw calls: " + std::to_string(textBatch->getDrawCount()), glm::vec2(540.f, 540.f), 0.4f,
+                   glm::vec4(1.f));
 
-    renderText("This is sample text", 0.0f, 0.0f, 1.0f, glm::vec3(1.f, 0.f, 0.f));
-    renderText("This is sample text", 25.0f, 25.0f, 1.0f, glm::vec3(0.5, 0.8f, 0.2f));
-    renderText("(C) LearnOpenGL.com", 540.0f, 570.0f, 0.5f, glm::vec3(0.3, 0.7f, 0.9f));
-}
\ No newline at end of file
+    textBatch->draw(glm::ortho(0.0f, 800.0f, 0.0f, 600.0f));
+}
@@ -2,70 +2,181 @@
 
 #include <fmtlog/fmtlog.h>
 
-Font::Font(const std::string& font)
+#include <algorithm>
+#include <stdexcept>
+
+// Empty border around glyphs, keeps linear filtering from bleeding in neighbours
+const int glyphPadding = 1;
+
+Font::Font(const std::string& font, unsigned int pixelSize, unsigned int size) : pageSize(size)
 {
-    FT_Library ft;
-    if (FT_Init_FreeType(&ft))
+    if (FT_Init_FreeType(&library))
     {
-        loge("Could not init FreeType Library");
-        return;
+        throw std::runtime_error("Could not init FreeType Library");
     }
 
-    FT_Face face;
-    if (FT_New_Face(ft, font.c_str(), 0, &face))
+    if (FT_New_Face(library, font.c_str(), 0, &face))
     {
-        loge("Failed to load font");
-        return;
+        FT_Done_FreeType(library);
+        throw std::runtime_error("Failed to load font " + font);
     }
 
-    FT_Set_Pixel_Sizes(face, 0, 48);
+    FT_Set_Pixel_Sizes(face, 0, pixelSize);
+    lineHeight = (unsigned int)(face->size->metrics.height >> 6);
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  // disable byte-alignment restriction
+    // Printable ASCII up front, everything else is inserted on first use
+    for (char32_t c = 32; c < 127; ++c)
+    {
+        getGlyph(c);
+    }
+}
+
+Font::~Font()
+{
+    glDeleteTextures((GLsizei)pages.size(), pages.data());
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+}
 
-    for (unsigned char c = 0; c < 128; c++)
+const Font::Glyph& Font::getGlyph(char32_t codePoint)
+{
+    auto iter = glyphs.find(codePoint);
+    if (iter != glyphs.end())
     {
-        // load character glyph
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-        {
-            loge("Failed to load Glyph");
-            continue;
-        }
+        return iter->second;
+    }
 
-        // generate texture
-        GLuint texture = 0;
-        glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    // Code points missing in the font load the missing glyph
+    Glyph glyph;
+    if (FT_Load_Char(face, codePoint, FT_LOAD_RENDER))
+    {
+        logw("Failed to load glyph {}", (unsigned int)codePoint);
+        return glyphs[codePoint] = glyph;
+    }
 
-        // set texture options
-        glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    const FT_Bitmap& bitmap = face->glyph->bitmap;
+    glyph.size = glm::ivec2(bitmap.width, bitmap.rows);
+    glyph.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+    glyph.advance = (unsigned int)(face->glyph->advance.x >> 6);
 
-        if (face->glyph->bitmap.buffer != nullptr)
+    // Whitespace has no bitmap and only advances
+    glm::ivec2 position;
+    if (bitmap.buffer != nullptr && bitmap.width > 0 && bitmap.rows > 0)
+    {
+        if (!allocate(bitmap.width, bitmap.rows, glyph.page, position))
         {
-            // create storage
-            glTextureStorage2D(texture, 1, GL_R8, face->glyph->bitmap.width, face->glyph->bitmap.rows);
-            // Write data
-            glTextureSubImage2D(texture, 0, 0, 0, face->glyph->bitmap.width, face->glyph->bitmap.rows, GL_RED,
-                                GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
+            logw("Glyph {} does not fit into an atlas page", (unsigned int)codePoint);
+            return glyphs[codePoint] = Glyph();
         }
-        else
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  // disable byte-alignment restriction
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, bitmap.pitch);
+        glTextureSubImage2D(pages[glyph.page], 0, position.x, position.y, bitmap.width, bitmap.rows, GL_RED,
+                            GL_UNSIGNED_BYTE, bitmap.buffer);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+        glyph.uvMin = glm::vec2(position) / (float)pageSize;
+        glyph.uvMax = glm::vec2(position + glyph.size) / (float)pageSize;
+    }
+    return glyphs[codePoint] = glyph;
+}
+
+GLuint Font::getPageTexture(unsigned int page) const { return pages.at(page); }
+
+std::size_t Font::getPageCount() const { return pages.size(); }
+
+unsigned int Font::getLineHeight() const { return lineHeight; }
+
+char32_t Font::nextCodePoint(const std::string& text, std::size_t& offset)
+{
+    const char32_t replacement = 0xFFFD;
+    unsigned char lead = (unsigned char)text[offset++];
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    // Lead byte gives the length of the sequence
+    unsigned int continuation = 0;
+    char32_t codePoint = 0;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        continuation = 1;
+        codePoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        continuation = 2;
+        codePoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        continuation = 3;
+        codePoint = lead & 0x07;
+    }
+    else
+    {
+        return replacement;
+    }
+
+    for (unsigned int i = 0; i < continuation; ++i)
+    {
+        if (offset >= text.size() || ((unsigned char)text[offset] & 0xC0) != 0x80)
         {
-            // Glyph has no data -> not present in our font
-            // Create dummy texture with single blank pixel
-            uint8_t p = 0;
-            glTextureStorage2D(texture, 1, GL_R8, 1, 1);
-            glTextureSubImage2D(texture, 0, 0, 0, 1, 1, GL_RED, GL_UNSIGNED_BYTE, &p);
+            return replacement;
         }
+        codePoint = (codePoint << 6) | ((unsigned char)text[offset++] & 0x3F);
+    }
+    return codePoint <= 0x10FFFF ? codePoint : replacement;
+}
 
-        // now store character for later use
-        Character character = {texture, glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-                               glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                               (unsigned int)face->glyph->advance.x};
+bool Font::allocate(unsigned int width, unsigned int height, unsigned int& page, glm::ivec2& position)
+{
+    int paddedWidth = (int)width + glyphPadding;
+    int paddedHeight = (int)height + glyphPadding;
+    if (paddedWidth + glyphPadding > (int)pageSize || paddedHeight + glyphPadding > (int)pageSize)
+    {
+        return false;
+    }
 
-        characters.insert(std::pair<char, Character>(c, character));
+    if (pages.empty())
+    {
+        addPage();
+    }
+    // Next row
+    if (cursor.x + paddedWidth > (int)pageSize)
+    {
+        cursor = glm::ivec2(glyphPadding, cursor.y + (int)rowHeight);
+        rowHeight = 0;
+    }
+    // Next page
+    if (cursor.y + paddedHeight > (int)pageSize)
+    {
+        addPage();
     }
 
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
-}
\ No newline at end of file
+    page = (unsigned int)pages.size() - 1;
+    position = cursor;
+    cursor.x += paddedWidth;
+    rowHeight = std::max(rowHeight, (unsigned int)paddedHeight);
+    return true;
+}
+
+void Font::addPage()
+{
+    GLuint texture = 0;
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureStorage2D(texture, 1, GL_R8, pageSize, pageSize);
+
+    // Cleared so padding samples as empty
+    const GLubyte zero = 0;
+    glClearTexImage(texture, 0, GL_RED, GL_UNSIGNED_BYTE, &zero);
+
+    pages.push_back(texture);
+    cursor = glm::ivec2(glyphPadding);
+    rowHeight = 0;
+}
@@ -6,22 +6,61 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include FT_FREETYPE_H
 
-#include "gfx/Shader.h"
-
+// Rasterizes glyphs on demand into atlas pages
+// Each page is a single channel texture, glyphs are packed in rows of similar height. A new page is started once a
+// glyph does not fit anymore.
 class Font
 {
    public:
-    struct Character
+    struct Glyph
     {
-        GLuint textureId = 0;      // ID handle of the glyph texture
-        glm::ivec2 size;           // Size of glyph
-        glm::ivec2 bearing;        // Offset from baseline to left/top of glyph
-        unsigned int advance = 0;  // Offset to advance to next glyph
+        glm::ivec2 size = glm::ivec2(0);     // Size of glyph in pixels
+        glm::ivec2 bearing = glm::ivec2(0);  // Offset from baseline to left/top of glyph
+        unsigned int advance = 0;            // Offset to advance to next glyph in pixels
+        unsigned int page = 0;               // Atlas page of the glyph
+        glm::vec2 uvMin = glm::vec2(0.f);    // Top left texture coordinates in the page
+        glm::vec2 uvMax = glm::vec2(0.f);    // Bottom right texture coordinates in the page
     };
 
-    Font(const std::string& font);
+    // pixelSize - glyph height in pixels
+    // pageSize - width and height of the atlas pages
+    Font(const std::string& font, unsigned int pixelSize = 48, unsigned int pageSize = 1024);
+    ~Font();
+
+    Font(const Font&) = delete;
+    Font& operator=(const Font&) = delete;
+
+    // Returns the glyph of the code point, rasterizes and inserts it on first use
+    // Code points missing in the font return the glyph of the font's missing glyph
+    const Glyph& getGlyph(char32_t codePoint);
+
+    GLuint getPageTexture(unsigned int page) const;
+    std::size_t getPageCount() const;
+
+    // Distance between baselines in pixels
+    unsigned int getLineHeight() const;
+
+    // Decodes the UTF-8 sequence at offset and advances offset past it
+    // Invalid sequences decode to U+FFFD
+    static char32_t nextCodePoint(const std::string& text, std::size_t& offset);
+
+   private:
+    // Reserves a region in the current page, starts a new page if full
+    bool allocate(unsigned int width, unsigned int height, unsigned int& page, glm::ivec2& position);
+    void addPage();
+
+    FT_Library library = nullptr;
+    FT_Face face = nullptr;
+    unsigned int pageSize = 0;
+    unsigned int lineHeight = 0;
+
+    std::unordered_map<char32_t, Glyph> glyphs;
+    std::vector<GLuint> pages;
 
-    std::unordered_map<char, Character> characters;
-};
\ No newline at end of file
+    // Packing state of the last page, rows are filled left to right
+    glm::ivec2 cursor = glm::ivec2(0);
+    unsigned int rowHeight = 0;
+};
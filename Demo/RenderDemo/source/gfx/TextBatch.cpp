@@ -0,0 +1,165 @@
+#include "gfx/TextBatch.h"
+
+#include <cstddef>
+
+static const char* vertexCode = R"##(
+#version 460 core
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 texCoords;
+layout (location = 2) in vec4 color;
+
+out vec2 TexCoords;
+out vec4 Color;
+
+uniform mat4 projection;
+
+void main()
+{
+    gl_Position = projection * vec4(position, 0.0, 1.0);
+    TexCoords = texCoords;
+    Color = color;
+}
+)##";
+
+static const char* fragmentCode = R"##(
+#version 460 core
+
+in vec2 TexCoords;
+in vec4 Color;
+out vec4 color;
+
+uniform sampler2D atlas;
+
+void main()
+{
+    color = vec4(Color.rgb, Color.a * texture(atlas, TexCoords).r);
+}
+)##";
+
+TextBatch::TextBatch(std::size_t maxGlyphs) : m_maxGlyphs(maxGlyphs)
+{
+    m_shader = std::make_unique<Shader>(vertexCode, fragmentCode);
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, m_maxGlyphs * 6 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+TextBatch::~TextBatch()
+{
+    glDeleteBuffers(1, &m_vbo);
+    glDeleteVertexArrays(1, &m_vao);
+}
+
+void TextBatch::add(Font& font, const std::string& text, const glm::vec2& position, float scale,
+                    const glm::vec4& color)
+{
+    glm::vec2 pen = position;
+    std::size_t offset = 0;
+    while (offset < text.size())
+    {
+        char32_t codePoint = Font::nextCodePoint(text, offset);
+        if (codePoint == '\n')
+        {
+            pen = glm::vec2(position.x, pen.y - font.getLineHeight() * scale);
+            continue;
+        }
+
+        const Font::Glyph& glyph = font.getGlyph(codePoint);
+        float x = pen.x + glyph.bearing.x * scale;
+        float y = pen.y - (glyph.size.y - glyph.bearing.y) * scale;
+        float w = glyph.size.x * scale;
+        float h = glyph.size.y * scale;
+        pen.x += glyph.advance * scale;
+        if (glyph.size.x == 0 || glyph.size.y == 0)
+        {
+            continue;
+        }
+        if (m_glyphCount == m_maxGlyphs)
+        {
+            return;
+        }
+        ++m_glyphCount;
+
+        // Few pages per frame, a linear search beats a map
+        GLuint texture = font.getPageTexture(glyph.page);
+        Page* page = nullptr;
+        for (auto& entry : m_pages)
+        {
+            if (entry.texture == texture)
+            {
+                page = &entry;
+                break;
+            }
+        }
+        if (page == nullptr)
+        {
+            m_pages.push_back(Page());
+            page = &m_pages.back();
+            page->texture = texture;
+        }
+
+        Vertex topLeft = {glm::vec2(x, y + h), glyph.uvMin, color};
+        Vertex bottomLeft = {glm::vec2(x, y), glm::vec2(glyph.uvMin.x, glyph.uvMax.y), color};
+        Vertex bottomRight = {glm::vec2(x + w, y), glyph.uvMax, color};
+        Vertex topRight = {glm::vec2(x + w, y + h), glm::vec2(glyph.uvMax.x, glyph.uvMin.y), color};
+        page->vertices.insert(page->vertices.end(), {topLeft, bottomLeft, bottomRight, topLeft, bottomRight, topRight});
+    }
+}
+
+void TextBatch::draw(const glm::mat4& projection)
+{
+    m_drawCount = 0;
+    if (m_glyphCount == 0)
+    {
+        return;
+    }
+
+    // Orphan the buffer so the driver does not wait for draws of the last frame, then upload all pages at once
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, m_maxGlyphs * 6 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+    std::size_t first = 0;
+    for (const auto& page : m_pages)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(Vertex), page.vertices.size() * sizeof(Vertex),
+                        page.vertices.data());
+        first += page.vertices.size();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_shader->setActive();
+    m_shader->set("projection", projection);
+    m_shader->set("atlas", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(m_vao);
+    first = 0;
+    for (auto& page : m_pages)
+    {
+        if (!page.vertices.empty())
+        {
+            glBindTexture(GL_TEXTURE_2D, page.texture);
+            glDrawArrays(GL_TRIANGLES, (GLint)first, (GLsizei)page.vertices.size());
+            first += page.vertices.size();
+            ++m_drawCount;
+        }
+        // Keeps the capacity for the next frame
+        page.vertices.clear();
+    }
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_glyphCount = 0;
+}
+
+std::size_t TextBatch::getDrawCount() const { return m_drawCount; }
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gfx/Font.h"
+#include "gfx/Shader.h"
+
+// Collects the glyph quads of all text in a frame and draws them with one draw call per atlas page
+// Quads are written into a single streaming vertex buffer which is orphaned every frame.
+class TextBatch
+{
+   public:
+    // maxGlyphs - glyphs per frame, further glyphs are dropped
+    TextBatch(std::size_t maxGlyphs = 16384);
+    ~TextBatch();
+
+    TextBatch(const TextBatch&) = delete;
+    TextBatch& operator=(const TextBatch&) = delete;
+
+    // Queues UTF-8 text with its first baseline starting at position, newlines start a new line
+    // Positions are in pixels with the origin at the bottom left
+    void add(Font& font, const std::string& text, const glm::vec2& position, float scale, const glm::vec4& color);
+
+    // Draws all queued text and clears the batch
+    void draw(const glm::mat4& projection);
+
+    // Number of draw calls issued by the last draw
+    std::size_t getDrawCount() const;
+
+   private:
+    struct Vertex
+    {
+        glm::vec2 position;
+        glm::vec2 texCoords;
+        glm::vec4 color;
+    };
+
+    // Quads sampling the same atlas page
+    struct Page
+    {
+        GLuint texture = 0;
+        std::vector<Vertex> vertices;
+    };
+
+    std::unique_ptr<Shader> m_shader;
+    GLuint m_vao = 0;
+    GLuint m_vbo = 0;
+    std::size_t m_maxGlyphs = 0;
+    std::size_t m_glyphCount = 0;
+    std::size_t m_drawCount = 0;
+    std::vector<Page> m_pages;
+};
@@ -0,0 +1,65 @@
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/Transformer.h>
+
+TEST_CASE("Transformer matrices", "[benchmark][foundation]")
+{
+    const unsigned int count = 10000;
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<float> value(-100.f, 100.f);
+    std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> rotations;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        positions.emplace_back(value(generator), value(generator), value(generator));
+        rotations.push_back(glm::quat(glm::vec3(angle(generator), angle(generator), angle(generator))));
+    }
+    glm::mat4 view = glm::lookAt(glm::vec3(0.f, 10.f, 20.f), glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 500.f);
+
+    // Every object moves each frame, all matrices are rebuilt
+    std::vector<Transformer> transformers(count);
+    BENCHMARK("Model matrix, 10000 objects")
+    {
+        float sum = 0.f;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            transformers[i].setPosition(positions[i]);
+            transformers[i].setRotation(rotations[i]);
+            transformers[i].setScale(glm::vec3(2.f));
+            sum += transformers[i].getModelMatrix()[3][0];
+        }
+        return sum;
+    };
+
+    BENCHMARK("Model view projection matrix, 10000 objects")
+    {
+        float sum = 0.f;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            transformers[i].setPosition(positions[i]);
+            transformers[i].setRotation(rotations[i]);
+            transformers[i].setViewMatrix(view);
+            transformers[i].setProjectionMatrix(projection);
+            sum += transformers[i].getModelViewProjectionMatrix()[3][0];
+        }
+        return sum;
+    };
+
+    BENCHMARK("Inverse model matrix, 10000 objects")
+    {
+        float sum = 0.f;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            transformers[i].setPosition(positions[i]);
+            sum += transformers[i].getInverseModelMatrix()[3][0];
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,72 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <glm/ext.hpp>
+
+#include <kern/graphics/collision/AABBox.h>
+#include <kern/graphics/collision/BoundingSphere.h>
+#include <kern/graphics/collision/Frustum.h>
+#include <kern/graphics/collision/FrustumCulling.h>
+#include <kern/resource/LoadMesh.h>
+
+TEST_CASE("Frustum culling", "[benchmark][collision]")
+{
+    glm::mat4 view = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 500.f);
+    Frustum frustum;
+    frustum.setFromViewProjectionClipSpaceApproach(view, projection);
+
+    for (unsigned int count : {1000u, 10000u, 100000u})
+    {
+        // Spread around the camera, roughly a tenth is visible
+        float extent = std::cbrt((float)count) * 4.f;
+        std::mt19937 generator(1337);
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::uniform_real_distribution<float> radius(0.5f, 2.f);
+
+        std::vector<BoundingSphere> spheres;
+        spheres.reserve(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            spheres.emplace_back(glm::vec3(position(generator), position(generator), position(generator)),
+                                 radius(generator));
+        }
+
+        BENCHMARK(std::to_string(count) + " spheres")
+        {
+            unsigned int visible = 0;
+            for (const auto &sphere : spheres)
+            {
+                visible += frustum.isInsideOrIntersects(sphere) ? 1 : 0;
+            }
+            return visible;
+        };
+
+        SSphereArray batch;
+        batch.resize(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            batch.set(i, spheres[i]);
+        }
+        std::vector<unsigned int> indices(count);
+        BENCHMARK(std::to_string(count) + " spheres, batch " + getCullingInstructionSet())
+        {
+            return getVisibleSpheres(frustum, batch, indices.data());
+        };
+    }
+}
+
+TEST_CASE("Bounding volume creation", "[benchmark][collision]")
+{
+    SMesh mesh;
+    REQUIRE(loadMeshFromObj(std::string(KERN_DEMO_DIRECTORY) + "/RTR2014/data/mesh/cave.obj", mesh));
+    std::string vertices = std::to_string(mesh.m_vertices.size() / 3) + " vertices";
+
+    BENCHMARK("Bounding sphere, " + vertices) { return BoundingSphere::create(mesh.m_vertices); };
+    BENCHMARK("Axis aligned box, " + vertices) { return AABBox::create(mesh.m_vertices); };
+}
@@ -0,0 +1,74 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/JobSystem.h>
+#include <kern/graphics/collision/Collidable.h>
+#include <kern/graphics/collision/CollisionSystem.h>
+
+// Fills the collision system with randomly placed collidables split over two groups
+static void createCollidables(CollisionSystem &system, unsigned int count)
+{
+    unsigned int groups[2] = {system.getNewGroupId(), system.getNewGroupId()};
+
+    // Keep the density roughly constant for all counts
+    float extent = std::cbrt((float)count) * 4.f;
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.5f, 2.f);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        Collidable *collidable = system.add(AABBox(), groups[i % 2]);
+        collidable->setTranslation(glm::vec3(position(generator), position(generator), position(generator)));
+        collidable->setScale(glm::vec3(size(generator)));
+        collidable->setDamage(1.f + (float)(i % 7) * 0.1f);
+    }
+}
+
+TEST_CASE("Collision system update", "[benchmark][collision]")
+{
+    for (unsigned int count : {1000u, 10000u, 100000u})
+    {
+        for (unsigned int threadCount : {1u, 0u})
+        {
+            JobSystem jobs(threadCount);
+            CollisionSystem system(jobs);
+            createCollidables(system, count);
+
+            BENCHMARK(std::to_string(count) + " collidables, " + std::to_string(jobs.getThreadCount()) +
+                      " threads")
+            {
+                system.update();
+            };
+        }
+    }
+}
+
+TEST_CASE("Collision system spatial queries", "[benchmark][collision]")
+{
+    JobSystem jobs(1);
+    CollisionSystem system(jobs);
+    createCollidables(system, 100000);
+    system.update();
+
+    Collidable *results[64];
+    float distances[64];
+    BENCHMARK("Ray cast, 100000 collidables")
+    {
+        SRayHit hit;
+        return system.rayCast(glm::vec3(-200.f, 1.f, 2.f), glm::vec3(1.f, 0.f, 0.f), 1000.f, hit);
+    };
+    BENCHMARK("Sphere overlap, 100000 collidables")
+    {
+        return system.overlap(BoundingSphere(glm::vec3(0.f), 8.f), results, 64);
+    };
+    BENCHMARK("8 nearest, 100000 collidables")
+    {
+        return system.findNearest(glm::vec3(10.f, 0.f, -10.f), 8, results, distances);
+    };
+}
@@ -0,0 +1,147 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <kern/foundation/JsonUtil.h>
+#include <kern/graphics/IScene.h>
+#include <kern/graphics/animation/AnimationWorld.h>
+#include <kern/graphics/io/SceneLoader.h>
+#include <kern/resource/ResourceManager.h>
+
+// Counts created objects, keeps the benchmark free of graphics resources
+class CountingScene : public IScene
+{
+   public:
+    SceneObjectId createObject(ResourceId, const glm::vec3 &, const glm::quat &, const glm::vec3 &) override
+    {
+        return m_objectCount++;
+    }
+    SceneObjectId createObject(ResourceId, ResourceId, const glm::vec3 &, const glm::quat &,
+                               const glm::vec3 &) override
+    {
+        return m_objectCount++;
+    }
+    bool getObject(SceneObjectId, ResourceId &, ResourceId &, glm::vec3 &, glm::quat &, glm::vec3 &,
+                   bool &) const override
+    {
+        return false;
+    }
+    void setObject(SceneObjectId, ResourceId, ResourceId, const glm::vec3 &, const glm::quat &, const glm::vec3 &,
+                   bool) override
+    {
+    }
+    SceneObjectId createPointLight(const glm::vec3 &, float, const glm::vec3 &, float, bool) override
+    {
+        return m_objectCount++;
+    }
+    bool getPointLight(SceneObjectId, glm::vec3 &, float &, glm::vec3 &, float &, bool &) const override
+    {
+        return false;
+    }
+    void setPointLight(SceneObjectId, const glm::vec3 &, float, const glm::vec3 &, float, bool) override {}
+    SceneObjectId createDirectionalLight(const glm::vec3 &, const glm::vec3 &, float, bool) override
+    {
+        return m_objectCount++;
+    }
+    bool getDirectionalLight(SceneObjectId, glm::vec3 &, glm::vec3 &, float &, bool &) const override
+    {
+        return false;
+    }
+    void setDirectionalLight(SceneObjectId, const glm::vec3 &, const glm::vec3 &, float, bool) override {}
+    void setAmbientLight(const glm::vec3 &, float) override {}
+    bool getAmbientLight(glm::vec3 &, float &) const override { return false; }
+    void getVisibleObjects(const ICamera &, ISceneQuery &) const override {}
+    void getVisibleLights(const ICamera &, ISceneQuery &) const override {}
+    void setOccluder(SceneObjectId, const std::vector<float> &, const std::vector<unsigned int> &) override {}
+    unsigned int getVisibleObjects(const SCullingView *, std::size_t, ISceneQuery *const *) const override
+    {
+        return 0;
+    }
+
+    SceneObjectId m_objectCount = 0;
+};
+
+// Scene files reference resources relative to the demo directory
+class DemoDirectory
+{
+   public:
+    DemoDirectory() : m_previous(std::filesystem::current_path())
+    {
+        std::filesystem::current_path(std::string(KERN_DEMO_DIRECTORY) + "/RTR2014");
+    }
+    ~DemoDirectory() { std::filesystem::current_path(m_previous); }
+
+   private:
+    std::filesystem::path m_previous;
+};
+
+// Writes a scene of many objects sharing the meshes and materials of the test scene
+static std::string writeSyntheticScene(unsigned int objectCount, unsigned int lightCount)
+{
+    const char *materials[] = {"data/material/brick_1_diffuse.ini", "data/material/moss_1_diffuse_normal.ini",
+                               "data/material/metal_1_diffuse_specular.ini"};
+    nlohmann::json root;
+    for (unsigned int i = 0; i < objectCount; ++i)
+    {
+        float x = (float)(i % 100) * 2.f;
+        float z = (float)(i / 100) * 2.f;
+        root["scene_objects"].push_back({{"mesh", "data/mesh/cube.obj"},
+                                         {"material", materials[i % 3]},
+                                         {"position", {x, 0.f, z}},
+                                         {"rotation", {0.f, (float)(i % 360), 0.f}},
+                                         {"scale", {1.f, 1.f, 1.f}}});
+    }
+    for (unsigned int i = 0; i < lightCount; ++i)
+    {
+        root["point_lights"].push_back({{"position", {(float)(i % 10) * 20.f, 2.f, (float)(i / 10) * 20.f}},
+                                        {"color", {1.f, 0.9f, 0.8f}},
+                                        {"radius", 10.f},
+                                        {"intensity", 2.f},
+                                        {"casts_shadow", false}});
+    }
+    root["ambient_light"] = {{"color", {1.f, 1.f, 1.f}}, {"intensity", 0.2f}};
+
+    std::string file = (std::filesystem::temp_directory_path() / "kern_synthetic_scene.json").string();
+    std::ofstream(file) << root.dump(4);
+    return file;
+}
+
+TEST_CASE("Scene loading", "[benchmark][scene]")
+{
+    DemoDirectory directory;
+    std::string syntheticFile = writeSyntheticScene(10000, 100);
+
+    BENCHMARK("json parse, 10000 objects")
+    {
+        nlohmann::json root;
+        load(syntheticFile, root);
+        return root.size();
+    };
+
+    // Fresh resource manager, includes loading meshes and images of the scene
+    BENCHMARK("Test scene with resources")
+    {
+        ResourceManager resourceManager;
+        AnimationWorld animationWorld;
+        CountingScene scene;
+        SceneLoader(resourceManager).load("data/scene/test/test_1.json", scene, animationWorld);
+        return scene.m_objectCount;
+    };
+
+    // Resources are cached after the first run, measures the loader itself
+    ResourceManager resourceManager;
+    BENCHMARK("Synthetic scene, 10000 objects, 100 lights")
+    {
+        AnimationWorld animationWorld;
+        CountingScene scene;
+        SceneLoader(resourceManager).load(syntheticFile, scene, animationWorld);
+        return scene.m_objectCount;
+    };
+
+    std::filesystem::remove(syntheticFile);
+}
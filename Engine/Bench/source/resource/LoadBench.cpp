@@ -0,0 +1,41 @@
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/resource/LoadImage.h>
+#include <kern/resource/LoadMesh.h>
+
+TEST_CASE("Mesh loading", "[benchmark][resource]")
+{
+    std::string directory = std::string(KERN_DEMO_DIRECTORY) + "/RTR2014/data/mesh/";
+    for (std::string file : {"duck.obj", "cave.obj"})
+    {
+        BENCHMARK("obj " + file)
+        {
+            SMesh mesh;
+            loadMeshFromObj(directory + file, mesh);
+            return mesh.m_vertices.size();
+        };
+    }
+}
+
+TEST_CASE("Image loading", "[benchmark][resource]")
+{
+    std::string directory = std::string(KERN_DEMO_DIRECTORY) + "/RTR2014/data/image/";
+    for (std::string file : {"brick_1_diffuse.png", "skybox.png"})
+    {
+        BENCHMARK("png " + file)
+        {
+            Image image;
+            load(directory + file, image);
+            return image.m_data.size();
+        };
+        BENCHMARK("png " + file + " to RGBA32")
+        {
+            Image image;
+            load(directory + file, ColorFormat::RGBA32, image);
+            return image.m_data.size();
+        };
+    }
+}
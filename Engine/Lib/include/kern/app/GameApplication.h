@@ -1,9 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+
+#include "kern/foundation/JobSystem.h"
 #include "kern/resource/IResourceManager.h"
 #include "kern/game/GameSystem.h"
 #include "kern/audio/SoundSystem.h"
 
+class InterpolatedScene;
+
 class GameApplication
 {
    public:
@@ -11,13 +17,63 @@ class GameApplication
     virtual ~GameApplication();
 
     bool init();
+
+    /**
+     * \brief Runs the simulation at a fixed tick on a separate thread and renders on the calling thread.
+     *
+     * Returns after simulate or render returned false or stop was called. The scene snapshot is published after
+     * every tick and applied interpolated before every render, see InterpolatedScene.
+     */
     void run();
 
+    /**
+     * \brief Stops the loop of run, may be called from any thread.
+     */
+    void stop();
+
+    /**
+     * \brief Sets the simulation ticks per second, call before run.
+     */
+    void setTickRate(unsigned int ticksPerSecond);
+
+    /**
+     * \brief Returns the job system shared by all subsystems, sized to the hardware concurrency.
+     */
+    JobSystem &getJobSystem();
+
    protected:
+    /**
+     * \brief Advances the simulation by one tick, called on the simulation thread.
+     *
+     * Updates the game system and sound system by default.
+     * \return False to stop the application.
+     */
+    virtual bool simulate(float dtime);
+
+    /**
+     * \brief Renders a frame, called on the calling thread of run with the scene mutex locked.
+     * \param alpha Time since the last tick in ticks, in [0, 1].
+     * \return False to stop the application.
+     */
+    virtual bool render(float alpha);
+
+    // Worker threads shared by all subsystems, destroyed after them
+    std::unique_ptr<JobSystem> m_jobSystem;
     // Resource manager
     std::unique_ptr<IResourceManager> m_resourceManager;
     // Manages game states and state transitions
     std::unique_ptr<GameSystem> m_gameSystem;
     // Creates and manages sounds and sound emitters
     std::unique_ptr<SoundSystem> m_soundSystem;
-};
\ No newline at end of file
+    // Scene used by the simulation, set up by derived applications
+    InterpolatedScene *m_scene = nullptr;
+
+   private:
+    // Simulation thread loop
+    void runSimulation();
+
+    std::chrono::steady_clock::duration m_tick;
+    std::atomic<bool> m_running{false};
+    // Time of the last published tick in steady clock ticks
+    std::atomic<std::chrono::steady_clock::rep> m_lastTick{0};
+};
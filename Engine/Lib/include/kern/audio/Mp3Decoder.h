@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include <minimp3_ex.h>
+
+#include "kern/audio/SoundDecoder.h"
+
+// Decodes mp3 files frame by frame, the file is memory mapped instead of read at once
+class Mp3Decoder : public SoundDecoder
+{
+   public:
+    // Throws if the file can not be opened
+    Mp3Decoder(const std::string& fileName);
+    ~Mp3Decoder();
+
+    Mp3Decoder(const Mp3Decoder&) = delete;
+    Mp3Decoder& operator=(const Mp3Decoder&) = delete;
+
+    std::size_t read(std::int16_t* samples, std::size_t count) override;
+    bool rewind() override;
+
+    unsigned short getChannels() const override;
+    unsigned int getFrequency() const override;
+
+   private:
+    mp3dec_ex_t decoder;
+};
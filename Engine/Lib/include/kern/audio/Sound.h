@@ -3,6 +3,10 @@
 #include <AL/al.h>
 
 #include <cstdlib>
+#include <functional>
+#include <memory>
+
+#include "kern/audio/SoundDecoder.h"
 
 // Represents playable audio data
 class Sound
@@ -15,14 +19,25 @@ class Sound
     // frequency - the sampling frequency
     Sound(const void* pcmSampleData, std::size_t sizeInBytes, unsigned short channels, unsigned short bitsPerSample,
           unsigned int frequency);
+    // Streamed sound without buffer, every playback opens its own decoder, see SoundStream
+    Sound(const std::function<std::unique_ptr<SoundDecoder>()>& decoderFactory);
     ~Sound();
 
     ALuint getBuffer() const;
     ALenum getOALFormat() const;
 
+    bool isStreaming() const;
+    std::unique_ptr<SoundDecoder> openDecoder() const;
+
+    // Length in seconds, 0 for streamed sounds
     float getLength() const;
+    // Size of the buffer in bytes, 0 for streamed sounds
+    std::size_t getSize() const;
 
    private:
     ALuint buffer = 0;
     ALenum format = 0;
+    float length = 0.f;
+    std::size_t size = 0;
+    std::function<std::unique_ptr<SoundDecoder>()> decoderFactory;
 };
\ No newline at end of file
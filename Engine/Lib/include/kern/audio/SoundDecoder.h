@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Decodes compressed audio into interleaved 16 bit pcm samples on demand
+// Used by streamed sounds, see SoundStream
+class SoundDecoder
+{
+   public:
+    virtual ~SoundDecoder() = default;
+
+    // Decodes up to count samples, a sample is a single value of one channel
+    // Returns the number of decoded samples, 0 at the end of the data
+    virtual std::size_t read(std::int16_t* samples, std::size_t count) = 0;
+
+    // Restarts decoding at the beginning of the data
+    virtual bool rewind() = 0;
+
+    virtual unsigned short getChannels() const = 0;
+    virtual unsigned int getFrequency() const = 0;
+};
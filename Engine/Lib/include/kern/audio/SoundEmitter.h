@@ -7,8 +7,13 @@
 
 #include "kern/audio/Sound.h"
 #include "kern/audio/SoundPriority.h"
+#include "kern/audio/SoundStream.h"
+
+class SoundSystem;
 
 // Represents a sound source in 3d space
+// Emitters are virtual voices, the sound system assigns them one of its hardware voices while they are among the
+// most important audible emitters. Without a voice playback continues silently.
 class SoundEmitter
 {
    public:
@@ -20,6 +25,11 @@ class SoundEmitter
     void play(const std::shared_ptr<Sound>& sound);
     void stop();
 
+    // Whether the emitter is playing, also without voice
+    bool isPlaying() const;
+    // Whether the emitter currently owns a hardware voice
+    bool hasVoice() const;
+
     void setSound(const std::shared_ptr<Sound>& sound);
 
     void setPosition(const glm::vec3& position);
@@ -28,6 +38,7 @@ class SoundEmitter
     void setVelocity(const glm::vec3& velocity);
     const glm::vec3& getVelocity() const;
 
+    // Emitters with higher priority steal voices from lower ones, Always is never culled
     SoundPriority getPriority() const;
     void setPriority(SoundPriority prio);
 
@@ -37,16 +48,35 @@ class SoundEmitter
     bool getLooping() const;
     void setLooping(bool loop);
 
+    // Distance to the listener beyond which the emitter is culled, 0 for unlimited
     float getRadius() const;
     void setRadius(float radius);
 
    private:
+    friend class SoundSystem;
+
+    // Advances playback, keeps streamed sounds playing
+    // Delta time in seconds
+    void update(float dtime);
+
+    // Takes the hardware voice and continues playback on it
+    void assignVoice(ALuint voice);
+    // Stops playback on the hardware voice and returns it, playback continues virtually
+    ALuint releaseVoice();
+    // Applies all properties to the voice and starts it at the current playback time
+    void startVoice();
+
     ALuint source = 0;
     glm::vec3 position = glm::vec3(0.f);
     glm::vec3 velocity = glm::vec3(0.f);
     std::shared_ptr<Sound> sound;
+    // Active playback of a streamed sound
+    std::unique_ptr<SoundStream> stream;
     SoundPriority priority = SoundPriority::Low;
-    float volume = 0.f;
+    float volume = 1.f;
     bool looping = false;
     float radius = 0.f;
-};
\ No newline at end of file
+    bool playing = false;
+    // Playback position in seconds
+    float playTime = 0.f;
+};
@@ -3,26 +3,37 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "kern/audio/Sound.h"
 
+class MemoryReport;
+
 class SoundManager
 {
    public:
     SoundManager(const std::string& soundDirectory);
     // Registers a sound name to filename mapping
-    void registerSound(const std::string& name, const std::string& fileName);
+    // Streamed sounds are decoded in chunks while playing instead of at once, meant for long music tracks
+    void registerSound(const std::string& name, const std::string& fileName, bool streaming = false);
     // Retrieves sound by previously registered name
     std::shared_ptr<Sound> getSound(const std::string& name);
     bool hasSound(const std::string& name) const;
+    // Adds the loaded sounds, OpenAL keeps buffers in client memory
+    void reportMemory(MemoryReport& report) const;
 
    private:
     std::shared_ptr<Sound> loadFromFile(const std::string& fileName);
     std::shared_ptr<Sound> loadFromWav(const std::string& fileName);
     std::shared_ptr<Sound> loadFromMp3(const std::string& fileName);
+    std::shared_ptr<Sound> loadStreamFromMp3(const std::string& fileName);
+    std::shared_ptr<Sound> loadFromOgg(const std::string& fileName);
+    std::shared_ptr<Sound> loadStreamFromOgg(const std::string& fileName);
 
     std::string directory;
     std::unordered_map<std::string, std::string> namesToFiles;
     // File name to sound
     std::unordered_map<std::string, std::shared_ptr<Sound>> filesToSounds;
+    // Files registered for streaming
+    std::unordered_set<std::string> streamedFiles;
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AL/al.h>
+
+#include "kern/audio/SoundDecoder.h"
+
+// Plays a decoder on a source through a small set of rotating buffers
+// A background thread decodes chunks ahead of playback, update queues them on the source. Memory stays constant
+// regardless of the length of the sound.
+class SoundStream
+{
+   public:
+    SoundStream(std::unique_ptr<SoundDecoder> decoder, bool looping);
+    // The source must not have buffers of this stream queued anymore
+    ~SoundStream();
+
+    SoundStream(const SoundStream&) = delete;
+    SoundStream& operator=(const SoundStream&) = delete;
+
+    // Queues decoded chunks on the source and starts it, also restarts it after running dry
+    // Returns false once all data was played
+    bool update(ALuint source);
+
+    // Stops the source and takes back the buffers queued on it, their unplayed data plays first when attached again
+    void detach(ALuint source);
+
+    void setLooping(bool loop);
+
+   private:
+    // Background thread, decodes chunks until the queue is full
+    void decode();
+
+    std::unique_ptr<SoundDecoder> decoder;
+    ALenum format = 0;
+    unsigned int channels = 0;
+    unsigned int frequency = 0;
+
+    // Buffers not queued on the source
+    std::vector<ALuint> buffers;
+    std::vector<ALuint> freeBuffers;
+    // Data of the buffers queued on the source in queue order, kept to resume after detaching
+    std::deque<std::vector<std::int16_t>> queuedChunks;
+
+    // Decoded chunks waiting for a free buffer
+    std::deque<std::vector<std::int16_t>> chunks;
+    bool decoded = false;
+    bool quit = false;
+    std::atomic<bool> looping;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::thread thread;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <unordered_set>
+#include <vector>
 
 #include <AL/al.h>
 #include <AL/alc.h>
@@ -14,7 +15,8 @@
 class SoundSystem
 {
    public:
-    SoundSystem(const std::string& directory);
+    // voiceCount - number of hardware voices shared by all emitters
+    SoundSystem(const std::string& directory, unsigned int voiceCount = 32);
     ~SoundSystem();
 
     SoundListener& getListener();
@@ -25,12 +27,17 @@ class SoundSystem
     // Global background sound emitter
     std::shared_ptr<SoundEmitter>& getGlobalSoundEmitter();
 
+    // Assigns voices to the highest priority audible emitters, nearer emitters first within the same priority
+    // Emitters only referenced by the system are released once they stopped playing
     // Delta time in seconds
     void update(float dtime);
    private:
     // Global background sound emitter
     std::shared_ptr<SoundEmitter> bgmEmitter;
     std::unordered_set<std::shared_ptr<SoundEmitter>> emitters;
+    // Hardware voices
+    std::vector<ALuint> voices;
+    std::vector<ALuint> freeVoices;
 
     // The current listener
     SoundListener listener;
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+#include <vorbis/vorbisfile.h>
+
+#include "kern/audio/SoundDecoder.h"
+
+// Decodes Ogg Vorbis files packet by packet
+class VorbisDecoder : public SoundDecoder
+{
+   public:
+    // Throws if the file can not be opened
+    VorbisDecoder(const std::string& fileName);
+    ~VorbisDecoder();
+
+    VorbisDecoder(const VorbisDecoder&) = delete;
+    VorbisDecoder& operator=(const VorbisDecoder&) = delete;
+
+    std::size_t read(std::int16_t* samples, std::size_t count) override;
+    bool rewind() override;
+
+    unsigned short getChannels() const override;
+    unsigned int getFrequency() const override;
+
+    // Total number of samples over all channels, 0 if unknown
+    std::size_t getSampleCount();
+
+   private:
+    OggVorbis_File file;
+    unsigned short channels = 0;
+    unsigned int frequency = 0;
+};
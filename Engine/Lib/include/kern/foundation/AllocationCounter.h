@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief Returns true if global operator new is replaced to count allocations.
+ *
+ * Enabled by building with the KERN_ALLOCATION_HOOK option, the tests always count allocations.
+ */
+bool isAllocationCounterEnabled();
+
+/**
+ * \brief Marks the counter as enabled, called once by the replaced operator new.
+ */
+void installAllocationHook();
+
+/**
+ * \brief Counts a heap allocation, called by the replaced operator new.
+ */
+void countAllocation(std::size_t size);
+
+/**
+ * \brief Returns the number of heap allocations of the calling thread, 0 if the counter is disabled.
+ *
+ * Compare counts before and after a block of code to check it for heap allocations.
+ */
+std::uint64_t getAllocationCount();
+
+/**
+ * \brief Returns the number of heap allocations of all threads, 0 if the counter is disabled.
+ */
+std::uint64_t getTotalAllocationCount();
+
+/**
+ * \brief Returns the allocated bytes of all threads, frees are not subtracted, 0 if the counter is disabled.
+ */
+std::uint64_t getTotalAllocatedBytes();
+
+/**
+ * \brief Ends the current frame, call once per frame to update the frame allocation counts.
+ */
+void beginAllocationFrame();
+
+/**
+ * \brief Returns the heap allocations of all threads during the last frame, see beginAllocationFrame.
+ */
+std::uint64_t getFrameAllocationCount();
+
+/**
+ * \brief Returns the allocated bytes of all threads during the last frame, see beginAllocationFrame.
+ */
+std::uint64_t getFrameAllocatedBytes();
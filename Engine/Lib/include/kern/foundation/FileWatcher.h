@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief Reports modified files, used for hot reloading resources.
+ *
+ * Uses inotify on Linux, watched files only cost a read on the event descriptor per poll. Other platforms fall back
+ * to comparing the modification times of every watched file on each poll.
+ * Editors often replace files instead of writing them, parent directories are watched to catch renames as well.
+ */
+class FileWatcher
+{
+   public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    /**
+     * \brief Adds the file to the watched files.
+     * \return False if the file can not be watched.
+     */
+    bool watch(const std::string &file);
+
+    /**
+     * \brief Appends files modified since the last poll, does not block.
+     *
+     * Every modified file is reported once, also if it was written multiple times.
+     */
+    void poll(std::vector<std::string> &changed);
+
+   private:
+    /**
+     * \brief Watched file.
+     */
+    struct SFile
+    {
+        std::string file;       /**< File as passed to watch. */
+        long long modified = 0; /**< Last modification time, only used without inotify. */
+    };
+
+    int m_descriptor = -1;                              /**< Inotify descriptor, -1 if not available. */
+    std::unordered_map<int, std::string> m_directories; /**< Maps watch descriptor to watched directory. */
+    std::unordered_map<std::string, SFile> m_files;     /**< Maps normalized path to watched file. */
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * \brief Bump allocator for temporaries living at most one frame.
+ *
+ * Allocations advance an offset into one buffer and are freed together by reset at the start of the next frame.
+ * Allocations not fitting into the buffer are served from the heap, the next reset grows the buffer to the peak
+ * usage. Frames with usage below the peak of earlier frames do not allocate from the heap at all.
+ * Not thread safe, use one arena per thread.
+ */
+class FrameArena
+{
+   public:
+    /**
+     * \param capacity Initial buffer size in bytes.
+     */
+    explicit FrameArena(std::size_t capacity = 64 * 1024);
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /**
+     * \brief Returns uninitialized memory valid until the next reset.
+     * \param alignment Power of two alignment.
+     */
+    void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * \brief Returns memory to the arena, only reclaimed if it was the latest allocation.
+     *
+     * Growing a vector frees its old storage right after allocating the new one, only the latest allocation is
+     * reclaimed to keep the arena a plain bump allocator.
+     */
+    void deallocate(void *pointer, std::size_t size);
+
+    /**
+     * \brief Frees all allocations, grows the buffer if the last frame did not fit.
+     */
+    void reset();
+
+    /**
+     * \brief Returns the bytes used in the buffer since the last reset.
+     */
+    std::size_t getUsed() const;
+
+    /**
+     * \brief Returns the buffer size in bytes.
+     */
+    std::size_t getCapacity() const;
+
+    /**
+     * \brief Returns the number of allocations served from the heap since the last reset.
+     */
+    std::size_t getOverflowCount() const;
+
+   private:
+    std::unique_ptr<unsigned char[]> m_buffer;                /**< Bump allocated buffer. */
+    std::size_t m_capacity = 0;                               /**< Buffer size. */
+    std::size_t m_offset = 0;                                 /**< First unused byte of the buffer. */
+    std::vector<std::unique_ptr<unsigned char[]>> m_overflow; /**< Heap allocations of the current frame. */
+    std::size_t m_overflowSize = 0;                           /**< Bytes allocated from the heap. */
+};
+
+/**
+ * \brief Standard allocator adapter for frame arenas, e.g. for containers of per-frame temporaries.
+ *
+ * Allocators without arena use the heap, containers may use either with the same type.
+ */
+template <typename T>
+class ArenaAllocator
+{
+   public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+
+    ArenaAllocator(FrameArena *arena) : m_arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : m_arena(other.getArena())
+    {
+    }
+
+    T *allocate(std::size_t count)
+    {
+        if (m_arena == nullptr)
+        {
+            return std::allocator<T>().allocate(count);
+        }
+        return (T *)m_arena->allocate(count * sizeof(T), alignof(T));
+    }
+
+    void deallocate(T *pointer, std::size_t count)
+    {
+        if (m_arena == nullptr)
+        {
+            std::allocator<T>().deallocate(pointer, count);
+            return;
+        }
+        m_arena->deallocate(pointer, count * sizeof(T));
+    }
+
+    FrameArena *getArena() const { return m_arena; }
+
+   private:
+    FrameArena *m_arena = nullptr; /**< Arena, nullptr for the heap. */
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &first, const ArenaAllocator<U> &second)
+{
+    return first.getArena() == second.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &first, const ArenaAllocator<U> &second)
+{
+    return first.getArena() != second.getArena();
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
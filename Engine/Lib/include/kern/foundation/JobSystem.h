@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+/**
+ * \brief Submitted job with the counter it decrements when finished.
+ */
+struct SJob
+{
+    std::function<void()> function; /**< Work of the job. */
+    JobCounter *counter = nullptr;  /**< Counter decremented after the job ran, may be nullptr. */
+};
+
+/**
+ * \brief Counts unfinished jobs, used to wait for jobs and to make jobs depend on other jobs.
+ *
+ * A counter must outlive all jobs counted by it or depending on it and must only be used with one job system.
+ */
+class JobCounter
+{
+   public:
+    /**
+     * \brief Returns true if all counted jobs finished.
+     */
+    bool isDone() const;
+
+   private:
+    friend class JobSystem;
+
+    std::atomic<std::size_t> m_pending{0};     /**< Unfinished counted jobs. */
+    std::atomic<unsigned int> m_finishing{0}; /**< Threads still accessing the counter after finishing a job. */
+    std::mutex m_mutex;                        /**< Guards the continuations. */
+    std::vector<SJob> m_continuations;         /**< Jobs submitted once the counted jobs finished. */
+};
+
+/**
+ * \brief Runs jobs on a fixed set of worker threads with work-stealing.
+ *
+ * Every worker owns a queue, jobs submitted by a worker go to its own queue and run last in first out. Idle workers
+ * steal the oldest jobs of other queues. Jobs submitted by other threads go to a shared queue. Waiting threads help
+ * running jobs and only block once no job is queued, jobs may submit and wait for other jobs without starving the
+ * workers.
+ * A system with a thread count of 1 has no workers, jobs run on the waiting thread.
+ */
+class JobSystem
+{
+   public:
+    /**
+     * \brief Creates the system with the total number of threads including the calling thread.
+     *
+     * A count of 0 uses the hardware concurrency.
+     */
+    explicit JobSystem(unsigned int threadCount);
+
+    /**
+     * \brief Joins all worker threads, submitted jobs have to be waited for before.
+     */
+    ~JobSystem();
+
+    /**
+     * \brief Returns the total number of threads including the calling thread.
+     */
+    unsigned int getThreadCount() const;
+
+    /**
+     * \brief Submits the job, may be called from any thread and from within jobs.
+     *
+     * \param counter Counter incremented now and decremented after the job ran, may be nullptr.
+     * \param dependency The job only starts after all jobs counted by the dependency finished, may be nullptr.
+     */
+    void submit(std::function<void()> function, JobCounter *counter = nullptr,
+                JobCounter *dependency = nullptr);
+
+    /**
+     * \brief Runs jobs until all jobs counted by the counter finished.
+     *
+     * Blocks while no job is queued and the counted jobs are still running on other threads.
+     */
+    void wait(const JobCounter &counter);
+
+    /**
+     * \brief Runs the function for consecutive ranges of [0, count) in parallel and waits for all ranges.
+     *
+     * Range k is [k * grainSize, min((k + 1) * grainSize, count)), functions may identify their range by
+     * begin / grainSize. The calling thread runs the first range.
+     */
+    void parallelFor(std::size_t count, std::size_t grainSize,
+                     const std::function<void(std::size_t, std::size_t)> &function);
+
+   private:
+    /**
+     * \brief Job queue of one thread.
+     */
+    struct SQueue
+    {
+        std::mutex mutex;      /**< Guards the jobs. */
+        std::deque<SJob> jobs; /**< Queued jobs, the owner uses the back and thieves the front. */
+    };
+
+    /**
+     * \brief Worker thread main loop.
+     */
+    void workerMain(unsigned int queue);
+
+    /**
+     * \brief Queues the job on the queue of the calling thread.
+     */
+    void push(SJob job);
+
+    /**
+     * \brief Runs one job from the own queue or stolen from another queue.
+     * \return False if no job was queued.
+     */
+    bool runJob();
+
+    /**
+     * \brief Returns the queue of the calling thread, 0 for threads other than the workers.
+     */
+    unsigned int getQueue() const;
+
+    std::vector<std::thread> m_threads;           /**< Worker threads, excludes the calling thread. */
+    std::vector<std::unique_ptr<SQueue>> m_queues; /**< Shared queue followed by one queue per worker. */
+    std::atomic<std::size_t> m_queuedJobs{0};     /**< Jobs in all queues. */
+    std::atomic<unsigned int> m_sleepingWorkers{0}; /**< Workers and waiting threads sleeping until jobs are queued. */
+    std::atomic<unsigned int> m_sleepingWaiters{0}; /**< Waiting threads sleeping until jobs finished. */
+    std::mutex m_sleepMutex;                      /**< Guards sleeping and shutdown. */
+    std::condition_variable m_wakeup;             /**< Signals new jobs or shutdown to the workers. */
+    bool m_shutdown = false;                      /**< Stops the worker threads. */
+};
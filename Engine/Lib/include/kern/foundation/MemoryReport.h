@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * \brief Memory used by one category of resources.
+ */
+struct SMemoryUsage
+{
+    std::size_t count = 0;    /**< Number of resources. */
+    std::size_t cpuBytes = 0; /**< Bytes in client memory. */
+    std::size_t gpuBytes = 0; /**< Estimated bytes in driver or video memory. */
+};
+
+/**
+ * \brief Collects memory usage of subsystems by category, e.g. "resource/mesh" or "graphics/texture".
+ *
+ * Subsystems add their usage in their reportMemory function. Sizes count resource data only, bookkeeping of the
+ * containers is not included. GPU sizes are estimates from formats and dimensions, drivers may pad or compress.
+ */
+class MemoryReport
+{
+   public:
+    /**
+     * \brief Adds usage to the category, repeated calls accumulate.
+     */
+    void add(const std::string &category, std::size_t count, std::size_t cpuBytes, std::size_t gpuBytes = 0);
+
+    /**
+     * \brief Returns the usage of the category, empty usage for unknown categories.
+     */
+    SMemoryUsage getUsage(const std::string &category) const;
+
+    /**
+     * \brief Returns the usage of all categories.
+     */
+    const std::map<std::string, SMemoryUsage> &getCategories() const;
+
+    /**
+     * \brief Returns the sum of all categories.
+     */
+    SMemoryUsage getTotal() const;
+
+    /**
+     * \brief Returns the report with the heap allocation counters, see AllocationCounter.h.
+     */
+    nlohmann::json toJson() const;
+
+    /**
+     * \brief Writes the report as json file.
+     */
+    bool save(const std::string &file) const;
+
+   private:
+    std::map<std::string, SMemoryUsage> m_categories; /**< Usage by category, sorted for stable output. */
+};
@@ -11,6 +11,11 @@
 class AGameState : public IGameState
 {
    public:
+    /**
+     * \brief Creates the state, parallel game object updates run on the job system.
+     */
+    AGameState(JobSystem &jobs);
+
     virtual ~AGameState();
 
     GameWorld &getGameWorld();
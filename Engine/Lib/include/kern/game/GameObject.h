@@ -1,7 +1,7 @@
 #pragma once
 
-#include <list>
 #include <memory>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -73,6 +73,18 @@ class GameObject
      */
     const glm::vec3 &getScale() const;
 
+    /**
+     * \brief Returns the attached controllers.
+     */
+    const std::vector<std::shared_ptr<IGameObjectController>> &getControllers() const;
+
+    /**
+     * \brief Returns true if controllers were added since the last call and resets the flag.
+     *
+     * Used by the game world to register new controllers.
+     */
+    bool fetchControllersChanged();
+
     /**
      * \brief Updates object and returns state
      *
@@ -80,6 +92,13 @@ class GameObject
      */
     void update(float dtime);
 
+    /**
+     * \brief Passes a changed transformation on to the scene object and collidable.
+     *
+     * Called by update after the controllers.
+     */
+    void updateTransformation();
+
     /**
      * \brief Marks this object for deletion.
      */
@@ -96,6 +115,11 @@ class GameObject
      */
     void sendMessage(Message msg);
 
+    /**
+     * \brief Passes a queued message with payload to all controllers.
+     */
+    void receiveMessage(const SMessage &message);
+
     /**
      * \brief Sets the collision entity for the object.
      */
@@ -130,8 +154,9 @@ class GameObject
     glm::vec3 m_scale = glm::vec3(1.f);               /**< Scale. */
     bool m_transformationChanged = false;             /**< Transformation dirty flag. */
     bool m_deleteRequested = false;                   /**< Deletion of this object is requested. */
-    std::list<std::shared_ptr<IGameObjectController>>
+    std::vector<std::shared_ptr<IGameObjectController>>
         m_controllers;                   /**< Controllers attached to the object. */
+    bool m_controllersChanged = false;   /**< Controllers were added. */
     Collidable *m_collidable = nullptr; /**< Collidable object. */
     bool m_dead = false;                 /**< Death flag. */
 };
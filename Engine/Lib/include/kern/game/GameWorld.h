@@ -1,16 +1,39 @@
 #pragma once
 
-#include <list>
 #include <memory>
+#include <typeindex>
+#include <vector>
 
 #include "kern/game/GameObject.h"
+#include "kern/game/MessageQueue.h"
+
+class IGameObjectController;
+class JobSystem;
 
 /**
  * \brief Stores game objects and manages object lifetime.
+ *
+ * Controllers are updated type by type instead of object by object. Controllers which declare
+ * themselves parallel are spread over worker threads. Added and deleted objects are applied
+ * at the end of the update, objects added during an update are first updated on the next tick.
+ * Damage received by collidables is posted as Message::DAMAGE, queued messages are
+ * dispatched after the controller update.
  */
 class GameWorld
 {
    public:
+    /**
+     * \brief Creates the game world, parallel controllers run on the job system.
+     *
+     * The job system must outlive the game world.
+     */
+    GameWorld(JobSystem &jobs);
+
+    /**
+     * \brief Destroys all game objects.
+     */
+    ~GameWorld();
+
     /**
      * \brief Updates all game objects.
      */
@@ -20,9 +43,59 @@ class GameWorld
      * \brief Adds game object.
      *
      * The object must be created on the heap and is owned by the game world.
+     * The object is added at the end of the current update.
      */
     void addObject(GameObject *object);
 
+    /**
+     * \brief Returns the job system parallel controllers run on.
+     */
+    JobSystem &getJobSystem();
+
+    /**
+     * \brief Returns the message queue, dispatched once per update.
+     */
+    MessageQueue &getMessageQueue();
+
    private:
-    std::list<std::unique_ptr<GameObject>> m_objects; /**< Game objects. */
+    /**
+     * \brief Controller with the object it is attached to.
+     */
+    struct SControllerEntry
+    {
+        IGameObjectController *controller = nullptr; /**< Updated controller. */
+        GameObject *object = nullptr;                /**< Owning game object. */
+    };
+
+    /**
+     * \brief All controllers of the same type.
+     */
+    struct SControllerBucket
+    {
+        std::type_index type = typeid(void);       /**< Controller type. */
+        bool parallel = true;                      /**< All controllers may run in parallel. */
+        std::vector<SControllerEntry> controllers; /**< Controllers of this type. */
+    };
+
+    /**
+     * \brief Applies added objects, new controllers and deleted objects.
+     */
+    void applyChanges();
+
+    /**
+     * \brief Adds the controllers of the object, starting at the first unregistered controller.
+     */
+    void registerControllers(GameObject *object, std::size_t first);
+
+    /**
+     * \brief Updates the controllers in the bucket.
+     */
+    void updateBucket(SControllerBucket &bucket, float dtime);
+
+    std::vector<std::unique_ptr<GameObject>> m_objects;      /**< Game objects. */
+    std::vector<std::unique_ptr<GameObject>> m_addedObjects; /**< Objects added during the update. */
+    std::vector<std::size_t> m_registeredControllers;       /**< Registered controller count per object. */
+    std::vector<SControllerBucket> m_buckets;                /**< Controllers by type, in registration order. */
+    JobSystem &m_jobs;                                       /**< Shared threads for parallel controllers. */
+    MessageQueue m_messages;                                 /**< Messages for game objects. */
 };
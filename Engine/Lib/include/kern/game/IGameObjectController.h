@@ -42,4 +42,20 @@ class IGameObjectController
      * \brief Receives message from game object.
      */
     virtual void receiveMessage(Message message) = 0;
+
+    /**
+     * \brief Handles a queued message with payload.
+     *
+     * Called by the message queue dispatch. Default forwards the message type to receiveMessage.
+     */
+    virtual void handleMessage(const SMessage &message);
+
+    /**
+     * \brief Returns whether the update may run in parallel.
+     *
+     * Parallel controllers only write to their own state and the attached game object.
+     * The game world updates them concurrently with other controllers of the same type.
+     * Default is false.
+     */
+    virtual bool isParallel() const;
 };
\ No newline at end of file
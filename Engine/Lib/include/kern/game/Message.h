@@ -1,8 +1,52 @@
 #pragma once
 
+#include <cstddef>
+
 enum class Message
 {
     DAMAGE,
     COLLISION,
-    DEATH
-};
\ No newline at end of file
+    DEATH,
+
+    NumMessages
+};
+
+/**
+ * \brief Payload of damage messages.
+ */
+struct SDamageMessage
+{
+    float damage = 0.f; /**< Received damage. */
+};
+
+/**
+ * \brief Returns an id unique to the payload type, the address of a static of its own instantiation.
+ */
+template <typename T>
+const void *getPayloadType()
+{
+    static const char tag = 0;
+    return &tag;
+}
+
+/**
+ * \brief Message with payload delivered by the message queue.
+ *
+ * The payload is only valid while the message is handled.
+ */
+struct SMessage
+{
+    Message type = Message::NumMessages; /**< Message type. */
+    const void *payload = nullptr;       /**< Payload data, may be null. */
+    const void *payloadType = nullptr;   /**< Payload type id, see getPayloadType. */
+    std::size_t size = 0;                /**< Payload size in bytes. */
+
+    /**
+     * \brief Returns the payload as type T or null if the payload has another type.
+     */
+    template <typename T>
+    const T *get() const
+    {
+        return payload != nullptr && payloadType == getPayloadType<T>() ? static_cast<const T *>(payload) : nullptr;
+    }
+};
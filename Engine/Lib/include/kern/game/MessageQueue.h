@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "kern/game/Message.h"
+
+class GameObject;
+
+/**
+ * \brief Queues messages for game objects and delivers them in batches.
+ *
+ * Payloads are copied into a per-frame byte arena which keeps its capacity, steady state
+ * frames do not allocate. Dispatch delivers all messages of one type before the next type,
+ * in posting order. Messages posted while dispatching are delivered on the next dispatch.
+ */
+class MessageQueue
+{
+   public:
+    /**
+     * \brief Queues a message with payload for the target object.
+     *
+     * The payload must be trivially copyable.
+     */
+    template <typename T>
+    void post(GameObject *target, Message type, const T &payload)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Message payload must be trivially copyable");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Message payload is over-aligned");
+        std::size_t offset = allocate(sizeof(T), alignof(T));
+        std::memcpy(m_frames[m_current].data.data() + offset, &payload, sizeof(T));
+        push(target, type, offset, sizeof(T), getPayloadType<T>());
+    }
+
+    /**
+     * \brief Queues a message without payload for the target object.
+     */
+    void post(GameObject *target, Message type);
+
+    /**
+     * \brief Delivers all queued messages to their targets.
+     *
+     * Targets which requested deletion receive no messages.
+     */
+    void dispatch();
+
+    /**
+     * \brief Drops queued messages for targets which requested deletion.
+     *
+     * Must be called before deleted objects are destroyed.
+     */
+    void removeDeleted();
+
+    /**
+     * \brief Drops all queued messages.
+     */
+    void clear();
+
+    /**
+     * \brief Returns the number of queued messages.
+     */
+    std::size_t size() const;
+
+   private:
+    /**
+     * \brief Queued message.
+     */
+    struct SRecord
+    {
+        GameObject *target = nullptr;      /**< Receiving object. */
+        std::size_t offset = 0;            /**< Payload offset in the arena. */
+        std::size_t size = 0;              /**< Payload size. */
+        const void *payloadType = nullptr; /**< Payload type id, see getPayloadType. */
+    };
+
+    /**
+     * \brief Messages and payloads of one frame.
+     */
+    struct SFrame
+    {
+        std::vector<unsigned char> data;                                       /**< Payload arena. */
+        std::size_t used = 0;                                                  /**< Used arena bytes. */
+        std::vector<SRecord> records[static_cast<std::size_t>(Message::NumMessages)]; /**< Messages by type. */
+    };
+
+    /**
+     * \brief Reserves aligned payload storage and returns the offset.
+     */
+    std::size_t allocate(std::size_t size, std::size_t alignment);
+
+    /**
+     * \brief Stores the message record.
+     */
+    void push(GameObject *target, Message type, std::size_t offset, std::size_t size, const void *payloadType);
+
+    SFrame m_frames[2];         /**< Posting and dispatching frame. */
+    unsigned int m_current = 0; /**< Frame receiving posted messages. */
+};
@@ -7,6 +7,7 @@ class Material;
 class Model;
 class Texture;
 class ShaderProgram;
+class MemoryReport;
 
 /**
  * \brief Graphics resource manager interface.
@@ -20,6 +21,16 @@ class IGraphicsResourceManager
      */
     virtual ~IGraphicsResourceManager();
 
+    /**
+     * \brief Per frame update, call before drawing.
+     */
+    virtual void update() = 0;
+
+    /**
+     * \brief Adds the memory used by GPU resources by type.
+     */
+    virtual void reportMemory(MemoryReport &report) const = 0;
+
     /**
      * \brief Maps id to internal mesh object.
      */
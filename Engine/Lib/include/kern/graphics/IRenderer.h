@@ -4,6 +4,7 @@ class IScene;
 class Window;
 class ICamera;
 class IGraphicsResourceManager;
+class MemoryReport;
 
 /**
  * \brief Renderer interface class.
@@ -21,4 +22,9 @@ class IRenderer
      */
     virtual void draw(const IScene &scene, const ICamera &camera, const Window &window,
                       const IGraphicsResourceManager &manager) = 0;
+
+    /**
+     * \brief Adds the memory of render targets, renderers without own targets add nothing.
+     */
+    virtual void reportMemory(MemoryReport &report) const;
 };
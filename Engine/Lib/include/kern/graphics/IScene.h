@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <glm/ext.hpp>
 #include <glm/glm.hpp>
@@ -10,6 +12,7 @@
 
 class ICamera;
 class ISceneQuery;
+struct SCullingView;
 
 /**
  * \brief Scene interface class.
@@ -50,6 +53,15 @@ class IScene
                            const glm::vec3 &position, const glm::quat &rotation,
                            const glm::vec3 &scale, bool visible) = 0;
 
+    /**
+     * \brief Sets the occluder mesh of the object for occlusion culling, empty vertices remove it.
+     *
+     * Vertices are object space xyz triples, meshes without indices are triangle lists. Occluders are usually
+     * simplified meshes and must lie inside the object, objects behind them in view are culled.
+     */
+    virtual void setOccluder(SceneObjectId id, const std::vector<float> &vertices,
+                             const std::vector<unsigned int> &indices) = 0;
+
     /**
      * \brief Creates point light in scene and returns id.
      */
@@ -101,4 +113,19 @@ class IScene
      * \brief Queries scene for objects and lights visible by the camera.
      */
     virtual void getVisibleObjects(const ICamera &camera, ISceneQuery &query) const = 0;
+
+    /**
+     * \brief Queries scene for lights visible by the camera, objects are not added.
+     */
+    virtual void getVisibleLights(const ICamera &camera, ISceneQuery &query) const = 0;
+
+    /**
+     * \brief Queries scene for objects visible in several views with a single traversal of the objects.
+     *
+     * Objects visible in views[i] are added to queries[i], lights are not added. Used to cull the camera and all
+     * shadow views of a frame together.
+     * \return Number of objects culled in the first view.
+     */
+    virtual unsigned int getVisibleObjects(const SCullingView *views, std::size_t viewCount,
+                                           ISceneQuery *const *queries) const = 0;
 };
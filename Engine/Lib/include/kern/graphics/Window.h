@@ -24,7 +24,12 @@ class Window
     Window();
     ~Window();
 
-    bool init(unsigned int width, unsigned int height, const std::string &name);
+    /**
+     * \brief Creates the window and its GL context.
+     *
+     * Hidden windows are never shown, they provide a context for offscreen rendering, e.g. for benchmarks.
+     */
+    bool init(unsigned int width, unsigned int height, const std::string &name, bool visible = true);
 
     void setWidth(unsigned int width);
     void setHeight(unsigned int height);
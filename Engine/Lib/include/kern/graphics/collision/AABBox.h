@@ -51,4 +51,13 @@ class AABBox
 /**
  * \brief Collision check.
  */
-bool collides(const AABBox &b1, const AABBox &b2);
\ No newline at end of file
+bool collides(const AABBox &b1, const AABBox &b2);
+
+/**
+ * \brief Continuous collision check for two moving boxes.
+ *
+ * The boxes start at b1 and b2 and move linearly by move1 and move2 during the step.
+ * On contact the time of impact is stored as fraction of the step in [0, 1].
+ */
+bool collides(const AABBox &b1, const glm::vec3 &move1, const AABBox &b2, const glm::vec3 &move2,
+              float &timeOfImpact);
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "kern/graphics/collision/AABBox.h"
+#include "kern/graphics/collision/BoundingSphere.h"
+
+class Collidable;
+
+/**
+ * \brief Result of a ray cast.
+ */
+struct SRayHit
+{
+    Collidable *entity = nullptr; /**< Hit entity. */
+    float distance = 0.f;         /**< Distance from the ray origin along the normalized direction. */
+};
+
+/**
+ * \brief Bounding volume hierarchy over collidable entities for spatial queries.
+ *
+ * The tree is built from a snapshot of the entity boxes. Queries write into caller provided
+ * buffers and do not allocate. Entities in the ignored group and entities which requested
+ * deletion are skipped.
+ */
+class BoundingVolumeHierarchy
+{
+   public:
+    /**
+     * \brief Group id which matches no entity, used to ignore no group.
+     */
+    static const unsigned int NoGroup = ~0u;
+
+    /**
+     * \brief Removes all entities.
+     */
+    void clear();
+
+    /**
+     * \brief Adds the entity with its current box, takes effect on the next build.
+     */
+    void add(Collidable *entity);
+
+    /**
+     * \brief Builds the tree from all added entities.
+     */
+    void build();
+
+    /**
+     * \brief Removes the entity from the tree without rebuilding.
+     *
+     * Entities of the last build are found by binary search, entities added since are searched linearly.
+     */
+    void remove(const Collidable *entity);
+
+    /**
+     * \brief Returns the closest entity hit by the ray within the maximum distance.
+     *
+     * The direction must be normalized.
+     * \return True if an entity was hit.
+     */
+    bool rayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, SRayHit &hit,
+                 unsigned int ignoredGroup = NoGroup) const;
+
+    /**
+     * \brief Stores up to maxResults entities overlapping the box.
+     * \return Number of stored entities.
+     */
+    std::size_t overlap(const AABBox &box, Collidable **results, std::size_t maxResults,
+                        unsigned int ignoredGroup = NoGroup) const;
+
+    /**
+     * \brief Stores up to maxResults entities overlapping the sphere.
+     * \return Number of stored entities.
+     */
+    std::size_t overlap(const BoundingSphere &sphere, Collidable **results, std::size_t maxResults,
+                        unsigned int ignoredGroup = NoGroup) const;
+
+    /**
+     * \brief Stores the k entities with the closest box mid point, sorted by distance.
+     *
+     * Both buffers must hold k elements, distances receives the distance for every result.
+     * \return Number of stored entities.
+     */
+    std::size_t findNearest(const glm::vec3 &point, std::size_t k, Collidable **results, float *distances,
+                            unsigned int ignoredGroup = NoGroup) const;
+
+   private:
+    /**
+     * \brief Entity snapshot.
+     */
+    struct SEntry
+    {
+        glm::vec3 min;                /**< Minimum corner of the box. */
+        glm::vec3 max;                /**< Maximum corner of the box. */
+        glm::vec3 mid;                /**< Box mid point. */
+        unsigned int groupId = 0;     /**< Collision group id. */
+        Collidable *entity = nullptr; /**< Entity, null if removed. */
+    };
+
+    /**
+     * \brief Entry lookup for removal.
+     */
+    struct SEntryIndex
+    {
+        const Collidable *entity = nullptr; /**< Entity. */
+        unsigned int index = 0;             /**< Entry index. */
+    };
+
+    /**
+     * \brief Tree node, the left child directly follows its parent.
+     */
+    struct SNode
+    {
+        glm::vec3 min;          /**< Minimum corner of the node bounds. */
+        glm::vec3 max;          /**< Maximum corner of the node bounds. */
+        unsigned int index = 0; /**< First entry for leaves, right child for inner nodes. */
+        unsigned int count = 0; /**< Entry count, zero for inner nodes. */
+    };
+
+    /**
+     * \brief Recursively builds the subtree over the entries in [begin, end).
+     */
+    void buildNode(unsigned int begin, unsigned int end);
+
+    /**
+     * \brief Returns whether the entry takes part in queries.
+     */
+    bool isQueryable(const SEntry &entry, unsigned int ignoredGroup) const;
+
+    /**
+     * \brief Visits all entries whose box passes the overlap test.
+     */
+    template <typename T>
+    std::size_t overlap(const T &test, Collidable **results, std::size_t maxResults, unsigned int ignoredGroup) const;
+
+    std::vector<SEntry> m_entries;           /**< Entries, ordered by leaf. */
+    std::vector<SNode> m_nodes;              /**< Tree nodes, root first. */
+    std::vector<SEntryIndex> m_entryIndices; /**< Entries of the last build, sorted by entity. */
+};
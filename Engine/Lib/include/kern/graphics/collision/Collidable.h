@@ -46,6 +46,32 @@ class Collidable
      */
     void receiveDamage(float damage);
 
+    /**
+     * \brief Returns the earliest time of impact of the last update as fraction of the movement during the update.
+     *
+     * Is 1 without collision and for collisions found without continuous testing.
+     */
+    float getTimeOfImpact() const;
+
+    /**
+     * \brief Returns the translation at the earliest impact of the last update.
+     *
+     * Used to move fast continuous entities back to their contact point.
+     */
+    const glm::vec3 &getContactTranslation() const;
+
+    /**
+     * \brief Stores an impact at the fraction of the movement during the update, only the earliest is kept.
+     *
+     * Called by the collision system.
+     */
+    void receiveImpact(float timeOfImpact, const glm::vec3 &move);
+
+    /**
+     * \brief Clears the impact of the last update, called by the collision system before testing.
+     */
+    void resetImpact();
+
     /**
      * \brief Returns the bounding box.
      */
@@ -56,6 +82,31 @@ class Collidable
      */
     void setTranslation(const glm::vec3 &translation);
 
+    /**
+     * \brief Returns the translation at the last collision system update.
+     */
+    const glm::vec3 &getPreviousTranslation() const;
+
+    /**
+     * \brief Stores the current translation as previous translation.
+     *
+     * Called by the collision system after testing.
+     */
+    void storePreviousTranslation();
+
+    /**
+     * \brief Sets continuous collision testing.
+     *
+     * Continuous entities are swept from the previous to the current translation and
+     * can not tunnel through other entities. Used for fast projectiles.
+     */
+    void setContinuous(bool state);
+
+    /**
+     * \brief Returns whether or not the entity is tested continuously.
+     */
+    bool isContinuous() const;
+
     /**
      * \brief Sets the scale matrix
      */
@@ -89,6 +140,11 @@ class Collidable
                                    setTranslation call. */
     AABBox m_box;              /**< The untransformed collision volume. */
     unsigned int m_groupId = 0; /**< Collision group id. */
+    glm::vec3 m_previousTranslation = glm::vec3(0.f); /**< Translation at the last collision update. */
+    bool m_previousTranslationValid = false; /**< False until the first collision update. */
+    bool m_continuous = false;               /**< Swept collision testing. */
+    float m_timeOfImpact = 1.f;              /**< Earliest time of impact of the last update. */
+    glm::vec3 m_contactTranslation = glm::vec3(0.f); /**< Translation at the earliest impact. */
 
     float m_damageReceived = 0.f; /**< Accumulated damage that was received since the last call to
                                      getDamageReceived. */
@@ -1,14 +1,26 @@
 #pragma once
 
 #include <list>
+#include <vector>
+
+#include <glm/glm.hpp>
 
 #include "kern/graphics/collision/AABBox.h"
+#include "kern/graphics/collision/BoundingVolumeHierarchy.h"
 
 class Collidable;
+class JobSystem;
 
 class CollisionSystem
 {
    public:
+    /**
+     * \brief Creates the collision system, collision testing runs on the job system.
+     *
+     * The job system must outlive the collision system.
+     */
+    CollisionSystem(JobSystem &jobs);
+
     /**
      * \brief Cleanup of resources.
      */
@@ -30,6 +42,11 @@ class CollisionSystem
 
     /**
      * \brief Tests the entities for collision
+     *
+     * Colliding pairs are found in parallel, damage is applied afterwards in a fixed pair order.
+     * The received damage is bit-identical for any thread count.
+     * Continuous entities are swept from their previous translation, see Collidable::setContinuous. The earliest
+     * impact of every entity is available until the next update, see Collidable::getContactTranslation.
      */
     void update();
 
@@ -38,13 +55,91 @@ class CollisionSystem
      */
     unsigned int getNewGroupId();
 
+    /**
+     * \brief Returns the closest entity hit by the ray within the maximum distance.
+     *
+     * Spatial queries run against the entity boxes at the last update and do not allocate.
+     * Entities added after the last update are not found, removed entities are skipped.
+     * \param direction Normalized ray direction.
+     * \param ignoredGroup Entities in this group are skipped, e.g. the group of the caller.
+     */
+    bool rayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, SRayHit &hit,
+                 unsigned int ignoredGroup = BoundingVolumeHierarchy::NoGroup) const;
+
+    /**
+     * \brief Stores up to maxResults entities overlapping the box and returns the stored count.
+     */
+    std::size_t overlap(const AABBox &box, Collidable **results, std::size_t maxResults,
+                        unsigned int ignoredGroup = BoundingVolumeHierarchy::NoGroup) const;
+
+    /**
+     * \brief Stores up to maxResults entities overlapping the sphere and returns the stored count.
+     */
+    std::size_t overlap(const BoundingSphere &sphere, Collidable **results, std::size_t maxResults,
+                        unsigned int ignoredGroup = BoundingVolumeHierarchy::NoGroup) const;
+
+    /**
+     * \brief Stores the k entities closest to the point, sorted by distance, and returns the stored count.
+     *
+     * Both buffers must hold k elements.
+     */
+    std::size_t findNearest(const glm::vec3 &point, std::size_t k, Collidable **results, float *distances,
+                            unsigned int ignoredGroup = BoundingVolumeHierarchy::NoGroup) const;
+
    private:
     /**
-     * \brief Tests the entity for collision with all other entities not in the
-     * group
+     * \brief Collidable snapshot used during the update.
+     */
+    struct SEntry
+    {
+        glm::vec3 min;                   /**< Minimum corner of the swept box. */
+        glm::vec3 max;                   /**< Maximum corner of the swept box. */
+        glm::vec3 move;                  /**< Movement since the last update, zero if not continuous. */
+        unsigned int groupId = 0;        /**< Collision group id. */
+        unsigned int order = 0;          /**< Gather order, used as sort tie breaker. */
+        bool continuous = false;         /**< Swept testing requested. */
+        Collidable *entity = nullptr;    /**< Snapshotted entity. */
+    };
+
+    /**
+     * \brief Colliding pair of sorted entries.
+     */
+    struct SPair
+    {
+        unsigned int first = 0;   /**< Index of the first entry. */
+        unsigned int second = 0;  /**< Index of the second entry. */
+        float timeOfImpact = 1.f; /**< Fraction of the movement at the impact, 1 for discrete pairs. */
+    };
+
+    /**
+     * \brief Deletes entities which requested deletion.
      */
-    void testCollision(Collidable *entity, unsigned int groupId);
+    void removeDeleted();
+
+    /**
+     * \brief Gathers all collidable entities sorted along the x axis.
+     *
+     * Stores the current translation of every entity as start of the next sweep.
+     */
+    void gatherEntities();
+
+    /**
+     * \brief Sweeps the sorted entries in [begin, end) and stores colliding pairs.
+     */
+    void testRange(std::size_t begin, std::size_t end, std::vector<SPair> &pairs) const;
+
+    /**
+     * \brief Exact test for two entries with overlapping bounds.
+     *
+     * Stores the time of impact of continuous entries, 1 for discrete entries.
+     */
+    bool testPair(const SEntry &a, const SEntry &b, float &timeOfImpact) const;
 
     std::vector<std::list<Collidable *>>
         m_entities; /**< Stores entities by group id (vector index) in lists. */
-};
\ No newline at end of file
+
+    std::vector<SEntry> m_sorted; /**< Entries sorted by minimum x, rebuilt every update. */
+    std::vector<std::vector<SPair>> m_pairBuffers; /**< Colliding pairs per sweep chunk, merged in chunk order. */
+    JobSystem &m_jobs;                     /**< Shared threads for collision testing. */
+    BoundingVolumeHierarchy m_tree;        /**< Spatial query structure, rebuilt every update. */
+};
@@ -55,6 +55,11 @@ class Frustum
      */
     bool isInsideOrIntersects(const BoundingSphere &sphere) const;
 
+    /**
+     * \brief Returns the six frustum planes, normals point to the inside.
+     */
+    const Plane *getPlanes() const;
+
    private:
     enum PlanePosition
     {
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "kern/graphics/collision/AABBox.h"
+#include "kern/graphics/collision/BoundingSphere.h"
+#include "kern/graphics/collision/Frustum.h"
+
+/**
+ * \brief Bounding spheres in structure of arrays layout for batch culling.
+ */
+struct SSphereArray
+{
+    /**
+     * \brief Resizes all arrays, new spheres are zero sized at the origin.
+     */
+    void resize(std::size_t count);
+
+    /**
+     * \brief Stores the sphere at the index.
+     */
+    void set(std::size_t index, const BoundingSphere &sphere);
+
+    /**
+     * \brief Returns the number of spheres.
+     */
+    std::size_t size() const;
+
+    std::vector<float> x;      /**< Center x coordinates. */
+    std::vector<float> y;      /**< Center y coordinates. */
+    std::vector<float> z;      /**< Center z coordinates. */
+    std::vector<float> radius; /**< Radii. */
+};
+
+/**
+ * \brief Axis aligned boxes in structure of arrays layout for batch culling.
+ */
+struct SBoxArray
+{
+    /**
+     * \brief Resizes all arrays, new boxes are empty at the origin.
+     */
+    void resize(std::size_t count);
+
+    /**
+     * \brief Stores the box at the index.
+     */
+    void set(std::size_t index, const AABBox &box);
+
+    /**
+     * \brief Returns the number of boxes.
+     */
+    std::size_t size() const;
+
+    std::vector<float> x;          /**< Center x coordinates. */
+    std::vector<float> y;          /**< Center y coordinates. */
+    std::vector<float> z;          /**< Center z coordinates. */
+    std::vector<float> halfWidthX; /**< Half widths along x. */
+    std::vector<float> halfWidthY; /**< Half widths along y. */
+    std::vector<float> halfWidthZ; /**< Half widths along z. */
+};
+
+/**
+ * \brief Culling volume of a view for multi-view culling, a frustum or a sphere.
+ */
+struct SCullingView
+{
+    /**
+     * \brief Frustum view, e.g. of a shadow map.
+     */
+    SCullingView(const Frustum &frustum);
+
+    /**
+     * \brief Frustum view of a camera, keeps the view projection for occlusion culling.
+     */
+    SCullingView(const glm::mat4 &view, const glm::mat4 &projection);
+
+    /**
+     * \brief Sphere view, e.g. around a point light for all faces of its shadow cube map.
+     */
+    SCullingView(const BoundingSphere &sphere);
+
+    bool isSphere = false;                     /**< Tests against the sphere instead of the frustum. */
+    bool isCamera = false;                     /**< Frustum view with view projection. */
+    Frustum frustum;                           /**< Volume of frustum views. */
+    BoundingSphere sphere;                     /**< Volume of sphere views. */
+    glm::mat4 viewProjection = glm::mat4(1.f); /**< View projection of camera views. */
+};
+
+/**
+ * \brief Maximum number of views of a single getViewMasks call, one bit per view.
+ */
+const std::size_t maxCullingViewCount = 32;
+
+/**
+ * \brief Returns the number of mask words needed for count bounding volumes.
+ */
+std::size_t getCullingMaskSize(std::size_t count);
+
+/**
+ * \brief Tests all spheres against the frustum.
+ *
+ * Sets bit i % 32 of mask[i / 32] if sphere i is inside or intersects the frustum, like
+ * Frustum::isInsideOrIntersects. The mask must hold getCullingMaskSize words.
+ * \return Number of visible spheres.
+ */
+std::size_t cullSpheres(const Frustum &frustum, const SSphereArray &spheres, std::uint32_t *mask);
+
+/**
+ * \brief Tests all spheres against the frustum and writes the indices of visible spheres in ascending order.
+ *
+ * The index array must hold spheres.size() entries.
+ * \return Number of visible spheres.
+ */
+std::size_t getVisibleSpheres(const Frustum &frustum, const SSphereArray &spheres, unsigned int *visible);
+
+/**
+ * \brief Tests all boxes against the frustum, see cullSpheres for the mask layout.
+ *
+ * Boxes are conservatively accepted if they intersect the planes without touching the frustum near its corners.
+ * \return Number of visible boxes.
+ */
+std::size_t cullBoxes(const Frustum &frustum, const SBoxArray &boxes, std::uint32_t *mask);
+
+/**
+ * \brief Tests all boxes against the frustum and writes the indices of visible boxes in ascending order.
+ * \return Number of visible boxes.
+ */
+std::size_t getVisibleBoxes(const Frustum &frustum, const SBoxArray &boxes, unsigned int *visible);
+
+/**
+ * \brief Tests all spheres against several views in one pass over the spheres.
+ *
+ * Sets bit v of masks[i] if sphere i is inside or intersects view v, every view is tested like cullSpheres does.
+ * The masks must hold spheres.size() entries, at most maxCullingViewCount views are supported.
+ */
+void getViewMasks(const SCullingView *views, std::size_t viewCount, const SSphereArray &spheres,
+                  std::uint32_t *masks);
+
+/**
+ * \brief Returns the instruction set used by the culling functions, "avx2", "sse2" or "scalar".
+ *
+ * Selected at compile time, AVX2 requires building with the KERN_AVX2 option.
+ */
+const char *getCullingInstructionSet();
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "kern/graphics/collision/BoundingSphere.h"
+
+class JobSystem;
+
+/**
+ * \brief Low resolution depth buffer rasterized on the CPU for occlusion culling.
+ *
+ * Occluder triangles are binned into screen tiles and rasterized in parallel, one job per tile. Pixels are covered
+ * if their center is inside the triangle and store the farthest depth of the triangle within the pixel. Bounding
+ * volumes are tested against the maximum depth of 8x8 pixel blocks first and against single pixels only where the
+ * block test fails.
+ * Depth is normalized device depth mapped to [0, 1], cleared to 1.
+ */
+class OcclusionBuffer
+{
+   public:
+    /**
+     * \brief Creates the buffer, the size is rounded up to whole tiles of 32x32 pixels.
+     *
+     * Tiles are rasterized on the job system, which must outlive the buffer.
+     */
+    OcclusionBuffer(JobSystem &jobs, unsigned int width = 256, unsigned int height = 128);
+
+    /**
+     * \brief Clears the buffer and all occluders and sets the view projection of the following frame.
+     */
+    void begin(const glm::mat4 &viewProjection);
+
+    /**
+     * \brief Transforms and bins the triangles of an occluder mesh.
+     *
+     * Vertices are xyz triples, meshes without indices are triangle lists. Triangles crossing the near plane are
+     * skipped, occluders must lie inside the volume of the objects they represent.
+     */
+    void addOccluder(const glm::mat4 &model, const std::vector<float> &vertices,
+                     const std::vector<unsigned int> &indices);
+
+    /**
+     * \brief Rasterizes the binned triangles and builds the hierarchical depth.
+     */
+    void rasterize();
+
+    /**
+     * \brief Returns false if the sphere is completely behind the rasterized occluders.
+     *
+     * Spheres crossing the near plane or partially outside the screen are tested conservatively.
+     */
+    bool isVisible(const BoundingSphere &sphere) const;
+
+    /**
+     * \brief Returns the rasterized depth of the pixel, the origin is the lower left corner.
+     */
+    float getDepth(unsigned int x, unsigned int y) const;
+
+    /**
+     * \brief Returns the number of binned triangles since begin.
+     */
+    std::size_t getTriangleCount() const;
+
+    unsigned int getWidth() const;
+
+    unsigned int getHeight() const;
+
+   private:
+    /**
+     * \brief Screen space triangle with its depth plane.
+     */
+    struct STriangle
+    {
+        float x[3]; /**< Screen x coordinates. */
+        float y[3]; /**< Screen y coordinates. */
+        float z;    /**< Depth at the screen origin. */
+        float dzdx; /**< Depth change per pixel in x. */
+        float dzdy; /**< Depth change per pixel in y. */
+        float maxZ; /**< Farthest vertex depth. */
+    };
+
+    /**
+     * \brief Rasterizes all triangles of the tile and updates its hierarchical depth.
+     */
+    void rasterizeTile(std::size_t tile);
+
+    /**
+     * \brief Rasterizes the part of the triangle inside the pixel rectangle [x0, x1) x [y0, y1).
+     */
+    void rasterizeTriangle(const STriangle &triangle, unsigned int x0, unsigned int y0, unsigned int x1,
+                           unsigned int y1);
+
+    unsigned int m_width;                          /**< Width in pixels. */
+    unsigned int m_height;                         /**< Height in pixels. */
+    unsigned int m_tilesX;                         /**< Tiles per row. */
+    unsigned int m_tilesY;                         /**< Tile rows. */
+    glm::mat4 m_viewProjection;                    /**< View projection of the current frame. */
+    std::vector<float> m_depth;                    /**< Depth per pixel, rows from bottom to top. */
+    std::vector<float> m_hierarchicalDepth;        /**< Maximum depth per 8x8 pixel block. */
+    std::vector<STriangle> m_triangles;            /**< Binned triangles of the current frame. */
+    std::vector<std::vector<unsigned int>> m_bins; /**< Triangle indices per tile. */
+    JobSystem &m_jobs;                             /**< Shared threads for tile rasterization. */
+};
@@ -25,6 +25,11 @@ class Plane
      */
     float distance(const glm::vec3 &point) const;
 
+    /**
+     * \brief Returns normal and offset as (a, b, c, d) with a * x + b * y + c * z + d = 0, the normal is normalized.
+     */
+    glm::vec4 getCoefficients() const;
+
    private:
     glm::vec3 m_normal = glm::vec3(0.f, 1.f, 0.f); /**< Stores the plane normal. */
     float m_d = 0.f; /**< Represents the regular euclidean distance from the origin. */
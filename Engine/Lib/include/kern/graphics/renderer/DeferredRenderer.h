@@ -2,17 +2,21 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 
+#include "kern/foundation/FrameArena.h"
 #include "kern/foundation/Transformer.h"
 
 #include "kern/graphics/IRenderer.h"
 #include "kern/graphics/renderer/FrameBuffer.h"
 #include "kern/graphics/renderer/RenderRequest.h"
 #include "kern/graphics/renderer/pass/ScreenQuadPass.h"
+#include "kern/graphics/scene/SceneQuery.h"
 
 #include "kern/resource/ResourceId.h"
 
 class ShaderProgram;
+class Texture;
 class IResourceManager;
 class ISceneQuery;
 
@@ -30,9 +34,23 @@ class DeferredRenderer : public IRenderer
     void draw(const IScene &scene, const ICamera &camera, const Window &window,
               const IGraphicsResourceManager &manager);
 
+    /**
+     * \brief Adds the estimated video memory of the g-buffer, shadow maps and post processing targets.
+     */
+    void reportMemory(MemoryReport &report) const;
+
     static DeferredRenderer *create(IResourceManager &manager);
 
    protected:
+    /**
+     * \brief Objects visible by the shadow views of a frame, one query per light in the order of the frame query.
+     */
+    struct SShadowQueries
+    {
+        SceneQuery *pointLights = nullptr;       /**< Queries of the shadow cube maps. */
+        SceneQuery *directionalLights = nullptr; /**< Queries of the shadow maps. */
+    };
+
     /**
      * \brief Writes geometry data into g-buffer.
      */
@@ -43,31 +61,33 @@ class DeferredRenderer : public IRenderer
      * \brief Performs shadow map calculation.
      */
     void shadowMapPass(const IScene &scene, const ICamera &camera, const Window &window,
-                       const IGraphicsResourceManager &manager);
+                       const IGraphicsResourceManager &manager, ISceneQuery &query);
 
     /**
      * \brief Performs shadow cube calculation.
      */
     void shadowCubePass(const IScene &scene, const ICamera &camera, const Window &window,
-                        const IGraphicsResourceManager &manager);
+                        const IGraphicsResourceManager &manager, ISceneQuery &query);
 
     /**
      * \brief Writes light data into l-buffer.
      */
     void lightPass(const IScene &scene, const ICamera &camera, const Window &window,
-                   const IGraphicsResourceManager &manager, ISceneQuery &query);
+                   const IGraphicsResourceManager &manager, ISceneQuery &query,
+                   const SShadowQueries &shadowQueries);
 
     /**
      * \brief Writes point light data to l-buffer.
      */
     void pointLightPass(const IScene &scene, const ICamera &camera, const Window &window,
-                        const IGraphicsResourceManager &manager, ISceneQuery &query);
+                        const IGraphicsResourceManager &manager, ISceneQuery &query, SceneQuery *shadowQueries);
 
     /**
      * \brief Writes directional light data to l-buffer.
      */
     void directionalLightPass(const IScene &scene, const ICamera &camera, const Window &window,
-                              const IGraphicsResourceManager &manager, ISceneQuery &query);
+                              const IGraphicsResourceManager &manager, ISceneQuery &query,
+                              SceneQuery *shadowQueries);
 
     /**
      * \brief Performs scene illumination and tone mapping.
@@ -290,8 +310,25 @@ class DeferredRenderer : public IRenderer
               const glm::mat4 &scale, Material *material, const IGraphicsResourceManager &manager,
               ShaderProgram *shader);
 
+    /**
+     * \brief Draws the collected packed draws sorted by their texture arrays, arrays are only bound on change.
+     */
+    void drawPacked(ShaderProgram *shader);
+
    private:
+    /**
+     * \brief Draw with a packed material, see Material::isPacked.
+     */
+    struct SPackedDraw
+    {
+        Mesh *mesh = nullptr;       /**< Drawn mesh. */
+        const Texture *textures[5]; /**< Diffuse, normal, specular, glow and alpha layer, defaults included. */
+        glm::mat4 rotation;         /**< Rotation matrix. */
+        glm::mat4 model;            /**< Model matrix. */
+    };
+
     Transformer m_transformer; /**< Stores current transformation matrices. */
+    FrameArena m_frameArena;   /**< Per frame temporaries like scene queries, reset every draw. */
 
     // Geometry pass
     // TODO Put into geometry pass class
@@ -302,6 +339,8 @@ class DeferredRenderer : public IRenderer
     std::shared_ptr<Texture>
         m_normalSpecularTexture; /**< Normal texture with specularity as alpha. */
     ResourceId m_geometryPassShaderId = InvalidResource;
+    ResourceId m_geometryPassArrayShaderId = InvalidResource; /**< Samples texture arrays, optional. */
+    std::vector<SPackedDraw> m_packedDraws;                   /**< Packed draws of the current frame. */
 
     // Shadow map pass
     ResourceId m_shadowMapPassShaderId = InvalidResource;
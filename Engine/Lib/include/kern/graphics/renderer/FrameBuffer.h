@@ -45,6 +45,11 @@ class FrameBuffer
      */
     std::shared_ptr<Texture> getTexture(TextureSemantic semantic);
 
+    /**
+     * \brief Returns the estimated video memory of the attached textures and render buffers.
+     */
+    std::size_t getGpuSize() const;
+
     static void setDefaultActive();
 
    private:
@@ -38,6 +38,11 @@ class IndexBuffer
 
     unsigned int getSize() const;
 
+    /**
+     * \brief Returns the buffer size in bytes.
+     */
+    std::size_t getGpuSize() const;
+
    private:
     GLuint m_bufferId;
     unsigned int m_size;
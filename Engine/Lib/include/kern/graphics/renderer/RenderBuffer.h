@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "kern/graphics/renderer/RendererCoreConfig.h"
 
 /**
@@ -41,6 +43,11 @@ class RenderBuffer
      */
     GLenum getFormat() const;
 
+    /**
+     * \brief Returns the estimated video memory of the buffer.
+     */
+    std::size_t getGpuSize() const;
+
     /**
      * \brief Sets the render buffer active.
      */
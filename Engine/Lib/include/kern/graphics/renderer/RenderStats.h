@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * \brief GL calls issued by the engine while rendering.
+ *
+ * Counted by the engine wrappers, e.g. draw, ShaderProgram, Texture and FrameBuffer. Calls skipped by state caching
+ * are not counted. Counters are not reset by the renderers, callers reset them per frame with resetRenderStats.
+ */
+struct SRenderStats
+{
+    unsigned int drawCalls = 0;        /**< glDraw* calls. */
+    unsigned int programBinds = 0;     /**< Shader program changes. */
+    unsigned int textureBinds = 0;     /**< Texture and texture array bindings. */
+    unsigned int frameBufferBinds = 0; /**< Frame buffer bindings, including the default frame buffer. */
+    unsigned int uniformUpdates = 0;   /**< glUniform* calls. */
+};
+
+/**
+ * \brief Returns the counters, only valid on the thread owning the GL context.
+ */
+SRenderStats &getRenderStats();
+
+/**
+ * \brief Sets all counters to zero.
+ */
+void resetRenderStats();
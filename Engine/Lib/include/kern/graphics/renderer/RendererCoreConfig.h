@@ -138,6 +138,12 @@ const std::string normalTextureUniformName = "normal_texture";
 const std::string specularTextureUniformName = "specular_texture";
 const std::string glowTextureUniformName = "glow_texture";
 const std::string alphaTextureUniformName = "alpha_texture";
+const std::string diffuseLayerUniformName = "diffuse_layer";
+const std::string normalLayerUniformName = "normal_layer";
+const std::string specularLayerUniformName = "specular_layer";
+const std::string glowLayerUniformName = "glow_layer";
+const std::string alphaLayerUniformName = "alpha_layer";
+const std::string normalTwoChannelUniformName = "normal_two_channel";
 const std::string depthTextureUniformName = "depth_texture";
 const std::string normalSpecularTextureUniformName = "normal_specular_texture";
 const std::string diffuseGlowTextureUniformName = "diffuse_glow_texture";
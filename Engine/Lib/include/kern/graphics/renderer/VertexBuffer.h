@@ -49,6 +49,11 @@ class VertexBuffer
      */
     unsigned int getSize() const;
 
+    /**
+     * \brief Returns the buffer size in bytes.
+     */
+    std::size_t getGpuSize() const;
+
     // TODO we might want to have a CMutableVertexBuffer or something similar
     VertexBuffer(GLenum usage = GL_STATIC_DRAW);
 
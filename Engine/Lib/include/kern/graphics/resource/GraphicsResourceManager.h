@@ -3,15 +3,21 @@
 #include <algorithm>
 #include <list>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "kern/graphics/IGraphicsResourceManager.h"
 #include "kern/graphics/resource/Material.h"
 #include "kern/graphics/resource/Mesh.h"
 #include "kern/graphics/resource/Model.h"
+#include "kern/graphics/resource/ShaderCache.h"
 #include "kern/graphics/resource/ShaderProgram.h"
 #include "kern/graphics/resource/TShaderObject.h"
 #include "kern/graphics/resource/Texture.h"
+#include "kern/graphics/resource/TexturePacker.h"
+#include "kern/graphics/resource/TextureStreamer.h"
+#include "kern/graphics/resource/TextureUploader.h"
 #include "kern/resource/IResourceListener.h"
 #include "kern/resource/ResourceEvent.h"
 #include "kern/resource/ResourceType.h"
@@ -52,6 +58,34 @@ class GraphicsResourceManager : public IGraphicsResourceManager, public IResourc
      */
     void notify(ResourceType type, ResourceId, ResourceEvent event, IResourceManager *resourceManager);
 
+    /**
+     * \brief Selects resident texture levels and streams pending levels within the per frame upload budget.
+     *
+     * Resolves shader programs the driver finished compiling, see resolveShaderPrograms.
+     */
+    void update();
+
+    /**
+     * \brief Adds the estimated video memory of meshes, textures and texture arrays.
+     *
+     * Packed textures are counted with their arrays.
+     */
+    void reportMemory(MemoryReport &report) const;
+
+    /**
+     * \brief Resolves shader programs which were submitted for compiling and linking.
+     *
+     * Logs compile and link errors and stores the binaries of linked programs in the shader cache. Failed relinks
+     * keep the former program.
+     * \param wait Waits for all programs, otherwise only resolves programs the driver finished.
+     */
+    void resolveShaderPrograms(bool wait);
+
+    /**
+     * \brief Sets the memory budget for streamed textures in bytes.
+     */
+    void setTextureBudget(std::size_t budget);
+
     /**
      * \brief Maps id to internal mesh object.
      */
@@ -118,6 +152,11 @@ class GraphicsResourceManager : public IGraphicsResourceManager, public IResourc
      */
     void initDefaultTextures();
 
+    /**
+     * \brief Creates a default texture, packed into a texture array if possible.
+     */
+    std::unique_ptr<Texture> createDefaultTexture(const Image &image);
+
     /**
      * \brief Loads vertex shader from resource manager.
      */
@@ -148,6 +187,22 @@ class GraphicsResourceManager : public IGraphicsResourceManager, public IResourc
      */
     void handleImageEvent(ResourceId, ResourceEvent event, IResourceManager *resourceManager);
 
+    /**
+     * \brief Packs small images into texture arrays, initializes storage and queues the data of other images.
+     */
+    bool initTexture(Texture *texture, Image image);
+
+    /**
+     * \brief Resolves submitted compiles of the stage shader objects and logs compile errors, stages in vertex,
+     * tessellation control, tessellation evaluation, geometry and fragment order.
+     */
+    void logShaderErrors(const ResourceId stages[5]) const;
+
+    /**
+     * \brief Returns the program binary cache key for the shader stages, empty if binaries are not supported.
+     */
+    std::string getShaderCacheKey(const ResourceId stages[5], IResourceManager *resourceManager) const;
+
     /**
      * \brief Handles resource events for mesh resources.
      */
@@ -170,9 +225,9 @@ class GraphicsResourceManager : public IGraphicsResourceManager, public IResourc
 
     /**
      * \brief Handles resource events for string resources.
-     * Stubbed as the renderer does not need string events.
-     * TODO Consider hot reloading of shader source code and on-the-fly
-     * recompiling of shader objects/programs
+     *
+     * Changed shader sources are recompiled and the programs using them relinked without waiting, programs keep
+     * their former link until resolved successfully, see resolveShaderPrograms.
      */
     void handleStringEvent(ResourceId, ResourceEvent event, IResourceManager *resourceManager);
 
@@ -214,6 +269,18 @@ class GraphicsResourceManager : public IGraphicsResourceManager, public IResourc
 
     std::unordered_map<ResourceId, std::unique_ptr<ShaderProgram>>
         m_shaderPrograms; /**< Maps resource ids to linked shader programs. */
+    ShaderCache m_shaderCache; /**< Program binaries of previous runs. */
+
+    /**
+     * \brief Shader program with submitted compile and link.
+     */
+    struct SPendingShaderProgram
+    {
+        ResourceId id = InvalidResource; /**< Shader program id. */
+        ResourceId stages[5];            /**< Stage source ids, see logShaderErrors. */
+        std::string cacheKey;            /**< Shader cache key, empty if not cached. */
+    };
+    std::vector<SPendingShaderProgram> m_pendingShaderPrograms; /**< Programs not resolved yet. */
 
     std::unique_ptr<Texture> m_defaultDiffuseTexture = nullptr;  /**< Default diffuse texture. */
     std::unique_ptr<Texture> m_defaultNormalTexture = nullptr;   /**< Default normal texture. */
@@ -221,6 +288,12 @@ class GraphicsResourceManager : public IGraphicsResourceManager, public IResourc
     std::unique_ptr<Texture> m_defaultGlowTexture = nullptr;     /**< Default glow texture. */
     std::unique_ptr<Texture> m_defaultAlphaTexture = nullptr;    /**< Default alpha texture. */
 
+    std::unique_ptr<TextureUploader> m_textureUploader; /**< Streams image data into textures, declared after the
+                                                           textures to be destroyed first. */
+    std::unique_ptr<TextureStreamer> m_textureStreamer; /**< Selects resident levels of textures with stored mip
+                                                           levels. */
+    std::unique_ptr<TexturePacker> m_texturePacker;     /**< Packs small textures into texture arrays. */
+
     std::list<IResourceManager *> m_registeredManagers; /**< Resource managers,
                                                            this listener is
                                                            attached to. */
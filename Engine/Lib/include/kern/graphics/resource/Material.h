@@ -31,6 +31,18 @@ class Material
     const Texture *getGlow() const;
     const Texture *getAlpha() const;
 
+    /**
+     * \brief Requests the texture resolution for the projected size in pixels from all textures.
+     */
+    void requestScreenSize(float pixels) const;
+
+    /**
+     * \brief Returns whether all textures of the material are layers of texture arrays, see TexturePacker.
+     *
+     * The array and layer of each texture are available from Texture::getArray and Texture::getLayer.
+     */
+    bool isPacked() const;
+
    private:
     const Texture *m_diffuseTexture;  /**< Base color. */
     const Texture *m_normalTexture;   /**< Normal map. */
@@ -77,6 +77,11 @@ class Mesh
      */
     const BoundingSphere &getBoundingSphere() const;
 
+    /**
+     * \brief Returns the video memory of all buffers.
+     */
+    std::size_t getGpuSize() const;
+
     /**
      * \brief Maps primitive type to GL type.
      * Example: Maps PrimitiveType::Triangle to GL_TRIANGLES.
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "kern/graphics/renderer/RendererCoreConfig.h"
+
+/**
+ * KHR_parallel_shader_compile support.
+ *
+ * Compiles and links are submitted without querying their status, the driver may then process them on its own
+ * threads. The status is only queried once GL_COMPLETION_STATUS_KHR reports completion or the result is needed.
+ * Without the extension the status query blocks until the driver is done.
+ */
+
+// Not part of core profile, glad only defines the enum if the extension was generated
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+/**
+ * \brief Returns whether the KHR or ARB parallel shader compile extension is supported by the current context.
+ */
+bool isParallelShaderCompileSupported();
+
+/**
+ * \brief Lets the driver use as many compiler threads as it wants, does nothing without the extension.
+ */
+void enableParallelShaderCompile();
+
+/**
+ * \brief Returns whether the compile of the shader object has finished, always true without the extension.
+ */
+bool isShaderCompileComplete(GLuint shaderId);
+
+/**
+ * \brief Returns whether the link of the program has finished, always true without the extension.
+ */
+bool isProgramLinkComplete(GLuint programId);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "kern/graphics/renderer/RendererCoreConfig.h"
+
+/**
+ * \brief Stores linked shader program binaries on disk to skip compiling and linking on later starts.
+ *
+ * Binaries are stored per key, see getKey. The key has to cover the sources of all stages and the driver, binaries
+ * are only valid for the driver which created them. Drivers may still reject a cached binary, e.g. after an update
+ * without version change, callers fall back to compiling from source then.
+ */
+class ShaderCache
+{
+   public:
+    /**
+     * \brief Creates the cache, the directory is created with the first stored binary.
+     */
+    ShaderCache(const std::string &directory);
+
+    /**
+     * \brief Returns a key over all parts, e.g. driver vendor, renderer, version and stage sources.
+     *
+     * Parts are hashed with their length, moving text from one part to another changes the key.
+     */
+    static std::string getKey(const std::vector<std::string> &parts);
+
+    /**
+     * \brief Loads the binary stored for the key.
+     * \return False if no valid binary is stored.
+     */
+    bool load(const std::string &key, GLenum &binaryFormat, std::vector<char> &binary) const;
+
+    /**
+     * \brief Stores the binary for the key, replaces a previously stored binary.
+     */
+    bool store(const std::string &key, GLenum binaryFormat, const std::vector<char> &binary) const;
+
+    /**
+     * \brief Returns the cache directory.
+     */
+    const std::string &getDirectory() const;
+
+   private:
+    /**
+     * \brief Returns the file name of the binary for the key.
+     */
+    std::string getFile(const std::string &key) const;
+
+    std::string m_directory; /**< Directory of the binary files. */
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -20,12 +21,19 @@ class ShaderProgram
      * Unused shader objects are represented by nullptr. All used shader objects
      * must be valid or program creation will fail and the program object will
      * be in invalid state after creation.
+     * Without waiting, the link is only submitted, see submit.
      */
     ShaderProgram(TShaderObject<GL_VERTEX_SHADER> *vertex,
                    TShaderObject<GL_TESS_CONTROL_SHADER> *tessControl,
                    TShaderObject<GL_TESS_EVALUATION_SHADER> *tessEval,
                    TShaderObject<GL_GEOMETRY_SHADER> *geometry,
-                   TShaderObject<GL_FRAGMENT_SHADER> *fragment);
+                   TShaderObject<GL_FRAGMENT_SHADER> *fragment, bool wait = true);
+
+    /**
+     * \brief Creates shader program from a program binary, see getBinary.
+     * The program is invalid if the driver rejects the binary.
+     */
+    ShaderProgram(GLenum binaryFormat, const std::vector<char> &binary);
 
     /**
      * \brief Deletes GPU shader resource.
@@ -50,6 +58,48 @@ class ShaderProgram
               TShaderObject<GL_GEOMETRY_SHADER> *geometry,
               TShaderObject<GL_FRAGMENT_SHADER> *fragment);
 
+    /**
+     * \brief Starts linking the shader objects without waiting for the result.
+     *
+     * Shader objects may still be compiling, see TShaderObject::submit. The link status of a first link is resolved
+     * on the first query, e.g. isValid or a uniform location lookup, relinks are only resolved by resolve. The program
+     * keeps its former link until then.
+     * \return False if a required stage is missing or a resolved stage is invalid.
+     */
+    bool submit(TShaderObject<GL_VERTEX_SHADER> *vertex, TShaderObject<GL_TESS_CONTROL_SHADER> *tessControl,
+                TShaderObject<GL_TESS_EVALUATION_SHADER> *tessEval, TShaderObject<GL_GEOMETRY_SHADER> *geometry,
+                TShaderObject<GL_FRAGMENT_SHADER> *fragment);
+
+    /**
+     * \brief Returns whether a submitted link has not been resolved yet.
+     */
+    bool isPending() const;
+
+    /**
+     * \brief Returns whether the driver is still compiling or linking a submitted program, polling does not block.
+     */
+    bool isLinking() const;
+
+    /**
+     * \brief Queries the link status of a submitted link and replaces the former link on success.
+     *
+     * Waits for the driver if still linking, see isLinking. A link already resolved by a first query reports its
+     * result again.
+     * \return False if the last submitted link failed, the former link is kept then.
+     */
+    bool resolve() const;
+
+    /**
+     * \brief Initializes the program from a program binary.
+     * \return False if the driver rejects the binary, a valid program keeps its former initialization then.
+     */
+    bool init(GLenum binaryFormat, const std::vector<char> &binary);
+
+    /**
+     * \brief Retrieves the binary of the linked program, see ShaderCache.
+     */
+    bool getBinary(GLenum &binaryFormat, std::vector<char> &binary) const;
+
     /**
      * \brief Sets the shader program as active program for vertex processing.
      */
@@ -68,6 +118,9 @@ class ShaderProgram
 
     /**
      * \brief Returns validity of the shader program.
+     *
+     * Resolves a submitted link only without a valid former link, a relink keeps the former program in use until
+     * resolved explicitly.
      */
     bool isValid() const;
 
@@ -107,7 +160,9 @@ class ShaderProgram
                                             setActive. */
     mutable std::unordered_map<std::string, GLint>
         m_uniformLocations; /**< Caches uniform location ids. */
-    std::string m_infoLog;
-    GLuint m_programId;
-    bool m_valid;
+
+    mutable std::string m_infoLog;
+    mutable GLuint m_programId;
+    mutable GLuint m_pendingId = 0; /**< Submitted program with unresolved link status. */
+    mutable bool m_valid;
 };
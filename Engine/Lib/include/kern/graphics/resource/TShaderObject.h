@@ -6,9 +6,13 @@
 #include <vector>
 
 #include "kern/graphics/renderer/RendererCoreConfig.h"
+#include "kern/graphics/resource/ParallelShaderCompile.h"
 
 /**
  * \brief Represents a compiled shader object.
+ *
+ * Compiles can be submitted without waiting for the result, see ParallelShaderCompile.h. The compile status of a
+ * submitted source is resolved on the first query, recompiles are only resolved by resolve.
  */
 template <GLenum ShaderType>
 class TShaderObject
@@ -16,8 +20,9 @@ class TShaderObject
    public:
     /**
      * \brief Creates shader object from shader type and source code.
+     * \param wait Resolves the compile status immediately, otherwise on the first query.
      */
-    TShaderObject(const std::string &source);
+    TShaderObject(const std::string &source, bool wait = true);
     ~TShaderObject();
 
     /**
@@ -25,6 +30,32 @@ class TShaderObject
      */
     bool init(const std::string &source);
 
+    /**
+     * \brief Starts compiling the source code without waiting for the result.
+     *
+     * The shader object keeps its former compile until the status is resolved, see isValid.
+     * \return False if no shader object could be created.
+     */
+    bool submit(const std::string &source);
+
+    /**
+     * \brief Returns whether a submitted source has not been resolved yet.
+     */
+    bool isPending() const;
+
+    /**
+     * \brief Returns whether the driver is still compiling a submitted source, polling does not block.
+     */
+    bool isCompiling() const;
+
+    /**
+     * \brief Queries the compile status of a submitted source and replaces the former compile on success.
+     *
+     * Waits for the driver if still compiling, see isCompiling.
+     * \return False if the submitted source failed to compile, the former compile is kept then.
+     */
+    bool resolve() const;
+
     /**
      * \brief Returns compile error string if a previous call to init returned
      * false.
@@ -32,35 +63,62 @@ class TShaderObject
     const std::string &getErrorString() const;
 
     /**
-     * \brief Returns shader object id.
+     * \brief Returns shader object id, the id of the submitted source while pending.
      */
     GLuint getId() const;
 
     /**
      * \brief Returns validity flag.
+     *
+     * Resolves a submitted source only without a valid former compile, a recompile keeps the former compile in use
+     * until resolved explicitly.
      */
     bool isValid() const;
 
    private:
-    std::string m_infoLog;
-    GLuint m_objectId;
-    bool m_valid;
+    mutable std::string m_infoLog;
+    mutable GLuint m_objectId;
+    mutable GLuint m_pendingId = 0; /**< Submitted shader object with unresolved compile status. */
+    mutable bool m_valid;
 };
 
 template <GLenum ShaderType>
-TShaderObject<ShaderType>::TShaderObject(const std::string &source) : m_objectId(0), m_valid(false)
+TShaderObject<ShaderType>::TShaderObject(const std::string &source, bool wait) : m_objectId(0), m_valid(false)
 {
-    init(source);
+    if (wait)
+    {
+        init(source);
+    }
+    else
+    {
+        submit(source);
+    }
 }
 
 template <GLenum ShaderType>
 TShaderObject<ShaderType>::~TShaderObject()
 {
     glDeleteShader(m_objectId);
+    if (m_pendingId != 0)
+    {
+        glDeleteShader(m_pendingId);
+    }
 }
 
 template <GLenum ShaderType>
 bool TShaderObject<ShaderType>::init(const std::string &source)
+{
+    if (!submit(source))
+    {
+        return false;
+    }
+    resolve();
+    // Failed compiles set the info log, a former compile stays valid then
+    return m_infoLog.empty() && m_valid;
+}
+
+template <GLenum ShaderType>
+bool TShaderObject<ShaderType>::submit(const std::string &source)
 {
     // Clean info log
     m_infoLog.clear();
@@ -77,9 +135,40 @@ bool TShaderObject<ShaderType>::init(const std::string &source)
     const GLchar *sourcePtr = source.data();
     glShaderSource(objectId, 1, &sourcePtr, NULL);
 
-    // Compile
+    // Compile, the status is queried when resolved
     glCompileShader(objectId);
 
+    // Replace a former submitted source
+    if (m_pendingId != 0)
+    {
+        glDeleteShader(m_pendingId);
+    }
+    m_pendingId = objectId;
+    return true;
+}
+
+template <GLenum ShaderType>
+bool TShaderObject<ShaderType>::isPending() const
+{
+    return m_pendingId != 0;
+}
+
+template <GLenum ShaderType>
+bool TShaderObject<ShaderType>::isCompiling() const
+{
+    return m_pendingId != 0 && !isShaderCompileComplete(m_pendingId);
+}
+
+template <GLenum ShaderType>
+bool TShaderObject<ShaderType>::resolve() const
+{
+    if (m_pendingId == 0)
+    {
+        return true;
+    }
+    GLuint objectId = m_pendingId;
+    m_pendingId = 0;
+
     // Check error
     GLint result;
     glGetShaderiv(objectId, GL_COMPILE_STATUS, &result);
@@ -96,6 +185,10 @@ bool TShaderObject<ShaderType>::init(const std::string &source)
             glGetShaderInfoLog(objectId, size, NULL, log.data());
             m_infoLog.assign(log.data(), size);
         }
+        else
+        {
+            m_infoLog = "Shader compilation failed.";
+        }
         // Clean up temp id
         glDeleteShader(objectId);
         return false;
@@ -111,24 +204,28 @@ bool TShaderObject<ShaderType>::init(const std::string &source)
     m_objectId = objectId;
     // Set validity flag
     m_valid = true;
-
     return true;
 }
 
 template <GLenum ShaderType>
 const std::string &TShaderObject<ShaderType>::getErrorString() const
 {
+    resolve();
     return m_infoLog;
 }
 
 template <GLenum ShaderType>
 GLuint TShaderObject<ShaderType>::getId() const
 {
-    return m_objectId;
+    return m_pendingId != 0 ? m_pendingId : m_objectId;
 }
 
 template <GLenum ShaderType>
 bool TShaderObject<ShaderType>::isValid() const
 {
+    if (!m_valid)
+    {
+        resolve();
+    }
     return m_valid;
 }
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include "kern/graphics/renderer/RendererCoreConfig.h"
 #include "kern/resource/ResourceId.h"
 #include "kern/resource/ColorFormat.h"
+#include "kern/resource/Image.h"
+
+class TextureArray;
 
 /**
  * \brief Texture class.
@@ -20,6 +24,11 @@ class Texture
     Texture(const std::vector<unsigned char> &imageData, unsigned int width, unsigned int height,
              ColorFormat format, bool createMipmaps = true);
 
+    /**
+     * \brief Create from image data, uses the mip levels of the image if present.
+     */
+    explicit Texture(const Image &image);
+
     /**
      * \brief Creates empty texture.
      */
@@ -42,6 +51,133 @@ class Texture
 
     bool init(unsigned int width, unsigned int height, GLint format);
 
+    /**
+     * \brief Initializes immutable texture storage and uploads the image synchronously.
+     *
+     * Block compressed images and images with more than one level are uploaded with their stored mip levels.
+     * Other images generate their mip levels on the GPU.
+     */
+    bool init(const Image &image);
+
+    /**
+     * \brief Initializes immutable texture storage for the image without uploading data.
+     *
+     * The base level is set to the smallest level, see setLevelData and setBaseLevel.
+     * Used for streamed uploads, see TextureUploader.
+     * \param topLevel Finest level in storage, finer levels are not resident.
+     */
+    bool initStorage(const Image &image, unsigned int topLevel = 0);
+
+    /**
+     * \brief Initializes the texture as view of a single layer of the array, shares the storage of the array.
+     *
+     * Has to be called again after the array reallocated its storage.
+     */
+    bool initView(const TextureArray &array, unsigned int layer);
+
+    /**
+     * \brief Returns the array this texture is a layer of, nullptr for textures with own storage.
+     */
+    const TextureArray *getArray() const;
+
+    /**
+     * \brief Returns the layer in the array.
+     */
+    unsigned int getLayer() const;
+
+    /**
+     * \brief Reallocates storage to start at the top level and keeps the uploaded levels still in storage.
+     *
+     * Level indices of the other functions always refer to the full image.
+     * Not supported for textures which generate their mip levels or are views of an array.
+     */
+    bool setTopLevel(unsigned int topLevel);
+
+    /**
+     * \brief Returns the finest level in storage.
+     */
+    unsigned int getTopLevel() const;
+
+    /**
+     * \brief Returns the allocated byte size of the levels in storage.
+     */
+    std::size_t getStorageSize() const;
+
+    /**
+     * \brief Returns the estimated video memory of the texture, 0 for views which share the storage of an array.
+     *
+     * Includes textures created from internal formats, which have no color format for getStorageSize.
+     */
+    std::size_t getGpuSize() const;
+
+    /**
+     * \brief Returns the estimated bytes per pixel of an uncompressed internal format.
+     */
+    static std::size_t getPixelSize(GLint internalFormat);
+
+    /**
+     * \brief Requests the resolution for the given projected size in pixels, see TextureStreamer.
+     *
+     * Keeps the largest request until fetched, called by renderers while drawing.
+     */
+    void requestScreenSize(float pixels) const;
+
+    /**
+     * \brief Returns the largest requested projected size since the last call and resets it.
+     */
+    float fetchRequestedScreenSize();
+
+    /**
+     * \brief Uploads a single mip level.
+     *
+     * Data is an offset into the buffer bound to GL_PIXEL_UNPACK_BUFFER if one is bound.
+     */
+    void setLevelData(unsigned int level, const void *data, std::size_t size);
+
+    /**
+     * \brief Uploads the rows [y, y + height) of a single mip level.
+     *
+     * Block compressed formats must start at a block row, y is a multiple of 4 then. Data is an offset into the
+     * buffer bound to GL_PIXEL_UNPACK_BUFFER if one is bound.
+     */
+    void setLevelData(unsigned int level, unsigned int y, unsigned int height, const void *data, std::size_t size);
+
+    /**
+     * \brief Generates all levels below the base level from level 0.
+     */
+    void generateMipmaps();
+
+    /**
+     * \brief Sets the finest level used for sampling.
+     */
+    void setBaseLevel(unsigned int level);
+
+    /**
+     * \brief Returns the finest level used for sampling.
+     */
+    unsigned int getBaseLevel() const;
+
+    /**
+     * \brief Returns the number of mip levels in storage.
+     */
+    unsigned int getLevelCount() const;
+
+    /**
+     * \brief Returns whether only level 0 is uploaded and the other levels are generated.
+     */
+    bool generatesMipmaps() const;
+
+    /**
+     * \brief Returns the dimensions of the mip level.
+     */
+    unsigned int getLevelWidth(unsigned int level) const;
+    unsigned int getLevelHeight(unsigned int level) const;
+
+    /**
+     * \brief Returns the color format of images initialized with storage.
+     */
+    ColorFormat getColorFormat() const;
+
     /**
      * \brief Sets filtering.
      */
@@ -72,10 +208,20 @@ class Texture
      */
     void saveAsPng(const std::string &file);
 
+    /**
+     * \brief Maps the color format to the sized internal format and the client pixel format.
+     */
+    static bool getFormat(ColorFormat format, GLint &internalFormat, GLenum &externalFormat);
+
    protected:
     bool init(const std::vector<unsigned char> &imageData, unsigned int width, unsigned int height,
               GLint format, bool createMipmaps);
 
+    /**
+     * \brief Creates a texture object with immutable storage for the levels starting at the top level.
+     */
+    GLuint createStorage(unsigned int topLevel) const;
+
    private:
     bool m_valid = false;
     bool m_hasMipmaps = false;
@@ -84,4 +230,12 @@ class Texture
     unsigned int m_height = 0;
     GLint m_format = 0;
     GLenum m_externalFormat = 0;
+    ColorFormat m_colorFormat = ColorFormat::Invalid; /**< Image format for immutable storage. */
+    unsigned int m_levels = 1;                         /**< Mip levels in storage. */
+    unsigned int m_baseLevel = 0;                      /**< Finest level used for sampling. */
+    unsigned int m_topLevel = 0;                       /**< Finest level in storage. */
+    mutable float m_requestedScreenSize = 0.f;         /**< Largest requested projected size in pixels. */
+    bool m_generateMipmaps = false;                    /**< Levels below 0 are generated. */
+    const TextureArray *m_array = nullptr;             /**< Array sharing its storage, nullptr for own storage. */
+    unsigned int m_layer = 0;                          /**< Layer in the array. */
 };
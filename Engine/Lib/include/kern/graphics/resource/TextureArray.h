@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+
+#include "kern/graphics/renderer/RendererCoreConfig.h"
+#include "kern/resource/ColorFormat.h"
+
+/**
+ * \brief Two dimensional texture array with immutable storage.
+ *
+ * All layers share the color format, size and number of mip levels. Storage for more layers is reallocated and
+ * keeps the content of the existing layers.
+ */
+class TextureArray
+{
+   public:
+    /**
+     * \brief Creates an array without layers.
+     */
+    TextureArray(ColorFormat format, unsigned int width, unsigned int height, unsigned int levels);
+
+    /**
+     * \brief Deletes the storage.
+     */
+    ~TextureArray();
+
+    TextureArray(const TextureArray &) = delete;
+    TextureArray &operator=(const TextureArray &) = delete;
+
+    /**
+     * \brief Reallocates storage for at least the given number of layers.
+     *
+     * Changes the texture id, texture views of the previous storage keep the old content, see Texture::initView.
+     * \return False if the number of layers exceeds the implementation limit.
+     */
+    bool reserve(unsigned int layers);
+
+    /**
+     * \brief Returns the number of layers in storage.
+     */
+    unsigned int getCapacity() const;
+
+    /**
+     * \brief Returns the video memory of all layers in storage.
+     */
+    std::size_t getGpuSize() const;
+
+    /**
+     * \brief Uploads a single mip level of a layer from client memory.
+     */
+    void setLayerData(unsigned int layer, unsigned int level, const void *data, std::size_t size);
+
+    ColorFormat getColorFormat() const;
+    unsigned int getWidth() const;
+    unsigned int getHeight() const;
+    unsigned int getLevelCount() const;
+
+    /**
+     * \brief Returns the sized internal format of the storage.
+     */
+    GLint getInternalFormat() const;
+
+    /**
+     * \brief Returns texture id, zero without storage.
+     */
+    GLuint getId() const;
+
+    /**
+     * \brief Sets texture array active as texture unit.
+     */
+    void setActive(GLint textureUnit) const;
+
+   private:
+    GLuint m_textureId = 0;
+    ColorFormat m_colorFormat = ColorFormat::Invalid;
+    GLint m_format = 0;           /**< Sized internal format. */
+    GLenum m_externalFormat = 0;  /**< Client pixel format of uncompressed formats. */
+    unsigned int m_width = 0;
+    unsigned int m_height = 0;
+    unsigned int m_levels = 1;    /**< Mip levels of every layer. */
+    unsigned int m_capacity = 0;  /**< Layers in storage. */
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "kern/graphics/resource/TextureArray.h"
+#include "kern/resource/Image.h"
+
+class Texture;
+
+/**
+ * \brief Packs small images with equal format and size into layers of shared texture arrays.
+ *
+ * Packed textures are views of their layer, they are sampled like any other texture and share the storage of the
+ * array. Materials with packed textures bind the arrays instead, draws with the same arrays share their bindings,
+ * see Texture::getArray and Material::isPacked.
+ * Packed images are uploaded synchronously when added, they are small enough to not need streaming.
+ */
+class TexturePacker
+{
+   public:
+    /**
+     * \param maxSize Largest width or height of packed images.
+     */
+    TexturePacker(unsigned int maxSize = 256);
+
+    /**
+     * \brief Packs the image into a layer and initializes the texture as view of that layer.
+     *
+     * \return False if the image is too large or invalid, the texture is unchanged then.
+     */
+    bool add(Texture *texture, const Image &image);
+
+    /**
+     * \brief Frees the layer of the texture for reuse, the texture keeps its view until reinitialized.
+     */
+    void remove(const Texture *texture);
+
+    /**
+     * \brief Returns the number of texture arrays.
+     */
+    std::size_t getArrayCount() const;
+
+    /**
+     * \brief Returns the video memory of all texture arrays.
+     */
+    std::size_t getGpuSize() const;
+
+   private:
+    /**
+     * \brief Texture array with the texture of every layer.
+     */
+    struct SArray
+    {
+        std::unique_ptr<TextureArray> array; /**< Shared storage. */
+        std::vector<Texture *> layers;       /**< Texture per layer, nullptr for free layers. */
+    };
+
+    /**
+     * \brief Returns a free layer in an array matching the format, creates or grows arrays if needed.
+     * \return False if no layer could be allocated.
+     */
+    bool allocateLayer(ColorFormat format, unsigned int width, unsigned int height, unsigned int levels,
+                       SArray *&result, unsigned int &layer);
+
+    unsigned int m_maxSize;        /**< Largest packed width or height. */
+    std::vector<SArray> m_arrays;  /**< Arrays, one or more per format and size. */
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "kern/resource/Image.h"
+
+class BoundingSphere;
+class ICamera;
+class Texture;
+class TextureUploader;
+
+/**
+ * \brief Returns the projected diameter in pixels of the transformed bounding sphere.
+ *
+ * Used by renderers as texture resolution feedback, see Texture::requestScreenSize.
+ */
+float getProjectedSize(const BoundingSphere &sphere, const glm::vec3 &position, const glm::quat &rotation,
+                       const glm::vec3 &scale, const ICamera &camera, unsigned int screenHeight);
+
+/**
+ * \brief Keeps texture mip levels resident based on their projected screen size within a memory budget.
+ *
+ * Textures start with their small tail levels resident. Every update, the resolution requested by the renderers
+ * selects the finest level per texture. Finer levels are streamed in through the uploader, unused levels are
+ * dropped after a delay. If the selection exceeds the budget, the textures with the smallest screen size are
+ * coarsened first. Only images with stored mip levels are streamed.
+ */
+class TextureStreamer
+{
+   public:
+    /**
+     * \brief Creates the streamer with the budget for texture storage in bytes.
+     */
+    TextureStreamer(TextureUploader &uploader, std::size_t budget = 256 * 1024 * 1024);
+
+    /**
+     * \brief Sets the budget for texture storage in bytes.
+     */
+    void setBudget(std::size_t budget);
+
+    /**
+     * \brief Returns the budget for texture storage in bytes.
+     */
+    std::size_t getBudget() const;
+
+    /**
+     * \brief Returns the storage size of all streamed textures in bytes.
+     */
+    std::size_t getResidentSize() const;
+
+    /**
+     * \brief Initializes texture storage with the tail levels and streams them in.
+     *
+     * Replaces a previously added image for the texture.
+     * \return False if the image has no stored mip levels or the storage could not be created.
+     */
+    bool add(Texture *texture, Image image);
+
+    /**
+     * \brief Stops streaming for the texture and cancels pending uploads.
+     */
+    void remove(Texture *texture);
+
+    /**
+     * \brief Selects the resident levels from the requests since the last update, called once per frame.
+     */
+    void update();
+
+   private:
+    /**
+     * \brief Streaming state of a texture.
+     */
+    struct SEntry
+    {
+        Texture *texture = nullptr;          /**< Streamed texture. */
+        std::shared_ptr<const Image> image;  /**< Source data for all levels. */
+        unsigned int tailLevel = 0;          /**< Coarsest top level, always resident. */
+        unsigned int targetLevel = 0;        /**< Selected top level. */
+        unsigned int unusedFrames = 0;       /**< Frames in which finer levels than selected were not requested. */
+        float screenSize = 0.f;              /**< Requested projected size in pixels of the last update. */
+    };
+
+    /**
+     * \brief Returns the storage size of the entry with the top level.
+     */
+    static std::size_t getStorageSize(const SEntry &entry, unsigned int topLevel);
+
+    /**
+     * \brief Coarsens selected levels until they fit into the budget.
+     */
+    void applyBudget();
+
+    TextureUploader &m_uploader;   /**< Uploads streamed in levels. */
+    std::size_t m_budget = 0;      /**< Storage budget in bytes. */
+    std::vector<SEntry> m_entries; /**< Streamed textures. */
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "kern/graphics/renderer/RendererCoreConfig.h"
+#include "kern/resource/Image.h"
+
+class Texture;
+
+/**
+ * \brief Streams texture levels to the GPU over several frames.
+ *
+ * Level data is copied into a persistently mapped pixel buffer ring and uploaded from there, the driver does not
+ * need to copy or synchronize client memory. Every frame uploads at most the frame budget, smallest levels of all
+ * pending textures first. A texture samples its finest uploaded level meanwhile, see Texture::setBaseLevel.
+ * The ring holds one budget sized slot per frame in flight, a slot is reused after its fence signaled. Levels larger
+ * than a slot are uploaded in bands of rows over several frames.
+ */
+class TextureUploader
+{
+   public:
+    /**
+     * \brief Creates and maps the pixel buffer ring.
+     * \param frameBudget Maximum bytes uploaded per frame.
+     * \param framesInFlight Number of frames the GPU may lag behind.
+     */
+    TextureUploader(std::size_t frameBudget = 8 * 1024 * 1024, unsigned int framesInFlight = 3);
+
+    /**
+     * \brief Unmaps and deletes the pixel buffer ring.
+     */
+    ~TextureUploader();
+
+    /**
+     * \brief Queues the image data for upload into the texture.
+     *
+     * The texture must have been initialized with Texture::initStorage for the image.
+     * Pending uploads for the same texture are replaced.
+     */
+    void enqueue(Texture *texture, Image image);
+
+    /**
+     * \brief Queues the levels in [beginLevel, endLevel) of the shared image for upload into the texture.
+     *
+     * The levels must be in storage of the texture, see Texture::setTopLevel.
+     * Pending uploads for the same texture are replaced.
+     */
+    void enqueue(Texture *texture, const std::shared_ptr<const Image> &image, unsigned int beginLevel,
+                 unsigned int endLevel);
+
+    /**
+     * \brief Removes all pending uploads for the texture.
+     */
+    void cancel(const Texture *texture);
+
+    /**
+     * \brief Uploads pending levels up to the frame budget, called once per frame.
+     *
+     * Levels larger than the budget are split into bands of rows, block rows for compressed formats.
+     */
+    void update();
+
+    /**
+     * \brief Returns the number of bytes waiting for upload.
+     */
+    std::size_t getPendingBytes() const;
+
+   private:
+    /**
+     * \brief Single level upload.
+     */
+    struct SUpload
+    {
+        Texture *texture = nullptr;          /**< Target texture. */
+        std::shared_ptr<const Image> image;  /**< Image data shared by all levels of the texture. */
+        unsigned int level = 0;              /**< Mip level. */
+        unsigned int row = 0;                /**< First row not uploaded yet. */
+        std::size_t offset = 0;              /**< Offset of the first row not uploaded yet in the image data. */
+        std::size_t size = 0;                /**< Byte size of the rows not uploaded yet. */
+    };
+
+    /**
+     * \brief Updates the texture after the level was uploaded.
+     */
+    void finishUpload(const SUpload &upload);
+
+    std::vector<SUpload> m_pending;         /**< Pending uploads, smallest first. */
+    std::size_t m_pendingBytes = 0;         /**< Sum of pending upload sizes. */
+    std::size_t m_frameBudget = 0;          /**< Slot size and per frame budget. */
+    unsigned int m_framesInFlight = 0;      /**< Number of slots. */
+    unsigned int m_slot = 0;                /**< Slot used by the next update. */
+    GLuint m_buffer = 0;                    /**< Persistently mapped pixel buffer. */
+    unsigned char *m_mapped = nullptr;      /**< Mapped pixel buffer memory. */
+    std::vector<GLsync> m_fences;           /**< Fence per slot, null if the slot is free. */
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "kern/graphics/IScene.h"
+
+/**
+ * \brief Scene decorator for simulating and rendering on separate threads.
+ *
+ * The simulation thread uses this scene like any other. Object transforms are only recorded and published as a
+ * snapshot at the end of every simulation tick, see publish. The render thread blends the last two snapshots into
+ * the wrapped scene before drawing it, see apply. Renders in between ticks show smooth motion at any frame rate.
+ *
+ * Object transforms never block and publishing only swaps buffers. Creating objects and changing lights are rare and
+ * forwarded to the wrapped scene under the scene mutex, the render thread holds it while applying and drawing. Light
+ * getters do not lock, only the simulation thread changes lights and the render thread reads them while drawing.
+ */
+class InterpolatedScene : public IScene
+{
+   public:
+    /**
+     * \brief Wraps the scene, the renderer draws the wrapped scene.
+     */
+    InterpolatedScene(IScene &scene);
+
+    SceneObjectId createObject(ResourceId model, const glm::vec3 &position, const glm::quat &rotation,
+                               const glm::vec3 &scale) override;
+
+    SceneObjectId createObject(ResourceId mesh, ResourceId material, const glm::vec3 &position,
+                               const glm::quat &rotation, const glm::vec3 &scale) override;
+
+    /**
+     * \brief Returns the latest object data of the simulation thread.
+     */
+    bool getObject(SceneObjectId id, ResourceId &mesh, ResourceId &material, glm::vec3 &position,
+                   glm::quat &rotation, glm::vec3 &scale, bool &visible) const override;
+
+    void setObject(SceneObjectId id, ResourceId mesh, ResourceId material, const glm::vec3 &position,
+                   const glm::quat &rotation, const glm::vec3 &scale, bool visible) override;
+
+    SceneObjectId createPointLight(const glm::vec3 &position, float radius, const glm::vec3 &color,
+                                   float intensity, bool castsShadow) override;
+
+    bool getPointLight(SceneObjectId id, glm::vec3 &position, float &radius, glm::vec3 &color,
+                       float &intensity, bool &castsShadow) const override;
+
+    void setPointLight(SceneObjectId id, const glm::vec3 &position, float radius, const glm::vec3 &color,
+                       float intensity, bool castsShadow) override;
+
+    SceneObjectId createDirectionalLight(const glm::vec3 &direction, const glm::vec3 &color, float intensity,
+                                         bool castsShadow) override;
+
+    bool getDirectionalLight(SceneObjectId id, glm::vec3 &direction, glm::vec3 &color, float &intensity,
+                             bool &castsShadow) const override;
+
+    void setDirectionalLight(SceneObjectId id, const glm::vec3 &direction, const glm::vec3 &color,
+                             float intensity, bool castsShadow) override;
+
+    void setAmbientLight(const glm::vec3 &color, float intensity) override;
+
+    bool getAmbientLight(glm::vec3 &color, float &intensity) const override;
+
+    void setOccluder(SceneObjectId id, const std::vector<float> &vertices,
+                     const std::vector<unsigned int> &indices) override;
+
+    /**
+     * \brief Queries the wrapped scene, call on the render thread with the mutex locked.
+     */
+    void getVisibleObjects(const ICamera &camera, ISceneQuery &query) const override;
+
+    /**
+     * \brief Queries the wrapped scene, call on the render thread with the mutex locked.
+     */
+    void getVisibleLights(const ICamera &camera, ISceneQuery &query) const override;
+
+    /**
+     * \brief Queries the wrapped scene, call on the render thread with the mutex locked.
+     */
+    unsigned int getVisibleObjects(const SCullingView *views, std::size_t viewCount,
+                                   ISceneQuery *const *queries) const override;
+
+    /**
+     * \brief Publishes the object data of the finished tick as newest snapshot, called by the simulation thread.
+     *
+     * The snapshot is published together with the one of the tick before.
+     */
+    void publish();
+
+    /**
+     * \brief Takes the newest published snapshot and writes the object data blended between it and the snapshot of the
+     * tick before into the wrapped scene.
+     *
+     * Call on the render thread with the mutex locked. Older snapshots published in between two calls are skipped.
+     * \param alpha Time since the newest snapshot in ticks, 0 shows the previous and 1 the newest snapshot.
+     */
+    void apply(float alpha);
+
+    /**
+     * \brief Returns the mutex guarding the wrapped scene.
+     */
+    std::mutex &getMutex();
+
+   private:
+    /**
+     * \brief Object data of one tick.
+     */
+    struct SObjectState
+    {
+        ResourceId mesh = InvalidResource;     /**< Mesh id. */
+        ResourceId material = InvalidResource; /**< Material id. */
+        glm::vec3 position = glm::vec3(0.f);   /**< Position. */
+        glm::quat rotation;                    /**< Rotation. */
+        glm::vec3 scale = glm::vec3(1.f);      /**< Scale. */
+        bool visible = true;                   /**< Visibility. */
+    };
+
+    /**
+     * \brief Records the object data of a newly created object.
+     */
+    void addObject(SceneObjectId id);
+
+    IScene &m_scene;                    /**< Wrapped scene, drawn by the renderer. */
+    mutable std::mutex m_mutex;         /**< Guards the wrapped scene. */
+    std::mutex m_snapshotMutex;         /**< Guards the pending snapshot. */
+
+    // Object ids index the vectors, the scene hands out consecutive ids and never removes objects
+    std::vector<SObjectState> m_objects;         /**< Object data written by the simulation thread. */
+    std::vector<SObjectState> m_published;       /**< Object data of the last published tick. */
+    std::vector<SObjectState> m_publishPrevious; /**< Simulation thread copy of the tick before for publishing. */
+    std::vector<SObjectState> m_publish;         /**< Simulation thread copy of the object data for publishing. */
+    std::vector<SObjectState> m_pendingPrevious; /**< Snapshot of the tick before the pending snapshot. */
+    std::vector<SObjectState> m_pending;         /**< Published snapshot not yet taken by the render thread. */
+    bool m_hasPending = false;                   /**< A snapshot was published since the last apply. */
+    std::vector<SObjectState> m_previous;        /**< Snapshot of the tick before the newest taken snapshot. */
+    std::vector<SObjectState> m_current;         /**< Newest snapshot taken by the render thread. */
+};
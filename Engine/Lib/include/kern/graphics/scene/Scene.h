@@ -6,12 +6,15 @@
 #include <glm/glm.hpp>
 
 #include "kern/graphics/IScene.h"
+#include "kern/graphics/collision/FrustumCulling.h"
+#include "kern/graphics/collision/OcclusionBuffer.h"
 
 struct SceneObject;
 struct ScenePointLight;
 struct SceneDirectionalLight;
 
 class IGraphicsResourceManager;
+class JobSystem;
 
 /**
  * \brief Simple scene implementation.
@@ -19,7 +22,12 @@ class IGraphicsResourceManager;
 class Scene : public IScene
 {
    public:
-    Scene(const IGraphicsResourceManager *resourceManager);
+    /**
+     * \brief Creates the scene, occluders are rasterized on the job system.
+     *
+     * The job system must outlive the scene.
+     */
+    Scene(const IGraphicsResourceManager *resourceManager, JobSystem &jobs);
     ~Scene();
 
     SceneObjectId createObject(ResourceId model, const glm::vec3 &position,
@@ -35,6 +43,9 @@ class Scene : public IScene
                    const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale,
                    bool visible) override;
 
+    void setOccluder(SceneObjectId id, const std::vector<float> &vertices,
+                     const std::vector<unsigned int> &indices) override;
+
     SceneObjectId createPointLight(const glm::vec3 &position, float radius, const glm::vec3 &color,
                                    float intensity, bool castsShadow) override;
 
@@ -59,19 +70,54 @@ class Scene : public IScene
 
     void getVisibleObjects(const ICamera &camera, ISceneQuery &query) const override;
 
+    void getVisibleLights(const ICamera &camera, ISceneQuery &query) const override;
+
+    unsigned int getVisibleObjects(const SCullingView *views, std::size_t viewCount,
+                                   ISceneQuery *const *queries) const override;
+
     static bool getViewFrustumCulling();
 
     // Hacky way to set global culling parameter
     static void setViewFrustumCulling(bool enable);
 
+    static bool getOcclusionCulling();
+
+    /**
+     * \brief Enables occlusion culling of camera views, only has an effect on scenes with occluders.
+     */
+    static void setOcclusionCulling(bool enable);
+
    private:
+    /**
+     * \brief Occluder mesh of a scene object in object space.
+     */
+    struct SOccluder
+    {
+        SceneObjectId object;              /**< Object the occluder is attached to. */
+        std::vector<float> vertices;       /**< Vertices as xyz triples. */
+        std::vector<unsigned int> indices; /**< Triangle indices, empty for triangle lists. */
+    };
+
+    /**
+     * \brief Rasterizes the occluders of visible objects for the view.
+     * \return False if the view is not occlusion culled.
+     */
+    bool rasterizeOccluders(const SCullingView &view) const;
+
     // Hacky
     static bool s_useViewFrustumCulling;
+    static bool s_useOcclusionCulling;
 
     glm::vec3 m_ambientColor = glm::vec3(1.f); /**< Global ambient light color. */
     float m_ambientIntensity = 0.f;            /**< Global ambient light intensity. */
 
     std::vector<SceneObject> m_objects;                     /**< Drawable scene objects. */
+    SSphereArray m_objectBounds;                            /**< Bounding spheres of the objects for batch culling. */
+    std::size_t m_hiddenObjectCount = 0;                    /**< Objects with cleared visibility flag. */
+    mutable std::vector<unsigned int> m_visibleObjects;     /**< Culling result, reused by render thread queries. */
+    mutable std::vector<std::uint32_t> m_viewMasks;         /**< View bits per object of multi-view queries. */
+    std::vector<SOccluder> m_occluders;                     /**< Occluder meshes of objects. */
+    mutable OcclusionBuffer m_occlusionBuffer;              /**< Occluder depth of the last camera query. */
     std::vector<ScenePointLight> m_pointLights;             /**< Point lights. */
     std::vector<SceneDirectionalLight> m_directionalLights; /**< Directional lights. */
 
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <vector>
-
+#include "kern/foundation/FrameArena.h"
 #include "kern/graphics/ISceneQuery.h"
 
 /**
@@ -15,6 +14,13 @@ class SceneQuery : public ISceneQuery
      */
     SceneQuery(unsigned int objectStorage = 200, unsigned int lightStorage = 100);
 
+    /**
+     * \brief Sets initial storage, allocated from the arena.
+     *
+     * The query must not be used after the next reset of the arena.
+     */
+    SceneQuery(FrameArena &arena, unsigned int objectStorage = 200, unsigned int lightStorage = 100);
+
     void addObject(SceneObjectId id);
 
     bool hasNextObject() const;
@@ -37,7 +43,7 @@ class SceneQuery : public ISceneQuery
     unsigned int m_nextObjectIndex = 0;
     unsigned int m_nextPointLightIndex = 0;
     unsigned int m_nextDirectionalLightIndex = 0;
-    std::vector<SceneObjectId> m_visibleObjects;           /**< Visible objects. */
-    std::vector<SceneObjectId> m_visiblePointLights;       /**< Visible lights. */
-    std::vector<SceneObjectId> m_visibleDirectionalLights; /**< Visible directional lights. */
+    ArenaVector<SceneObjectId> m_visibleObjects;           /**< Visible objects. */
+    ArenaVector<SceneObjectId> m_visiblePointLights;       /**< Visible lights. */
+    ArenaVector<SceneObjectId> m_visibleDirectionalLights; /**< Visible directional lights. */
 };
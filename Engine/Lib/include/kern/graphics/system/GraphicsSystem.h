@@ -8,10 +8,15 @@
 #include "kern/graphics/IRenderer.h"
 #include "kern/graphics/IScene.h"
 
+class JobSystem;
+
 class GraphicsSystem : public IGraphicsSystem
 {
    public:
-    GraphicsSystem();
+    /**
+     * \brief Creates the system, scenes use the job system which must outlive them.
+     */
+    GraphicsSystem(JobSystem &jobs);
     ~GraphicsSystem();
 
     bool init(IResourceManager &manager);
@@ -42,6 +47,8 @@ class GraphicsSystem : public IGraphicsSystem
     unsigned int m_currentFrameCount = 0;
     unsigned int m_lastFrameCount = 0;
 
+    JobSystem &m_jobs; /**< Shared threads of the scenes. */
+
     std::list<std::unique_ptr<IScene>> m_scenes;
     IScene *m_activeScene = nullptr;
 
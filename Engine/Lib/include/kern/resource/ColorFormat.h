@@ -1,12 +1,37 @@
 #pragma once
 
+#include <cstddef>
+
 /**
  * \brief Color format for texture data.
+ *
+ * Block compressed formats store 4x4 pixel blocks, see getImageSize.
  */
 enum class ColorFormat
 {
     GreyScale8 = 1,
     RGB24 = 3,
     RGBA32 = 4,
+    BC1,  /**< RGB, 8 byte per block, for opaque color maps. */
+    BC3,  /**< RGBA, 16 byte per block, for color maps with smooth alpha. */
+    BC5,  /**< Two channel RG, 16 byte per block, for tangent space normal maps. */
+    BC7,  /**< RGBA, 16 byte per block, high quality color maps. */
     Invalid
-};
\ No newline at end of file
+};
+
+/**
+ * \brief Returns whether the format is block compressed.
+ */
+bool isCompressed(ColorFormat format);
+
+/**
+ * \brief Returns the byte size of a single mip level with the given dimensions.
+ *
+ * Returns 0 for invalid formats.
+ */
+std::size_t getImageSize(ColorFormat format, unsigned int width, unsigned int height);
+
+/**
+ * \brief Returns the byte size of a mip chain with the given level count, starting with the given dimensions.
+ */
+std::size_t getImageSize(ColorFormat format, unsigned int width, unsigned int height, unsigned int levels);
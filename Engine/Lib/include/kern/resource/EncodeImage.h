@@ -0,0 +1,14 @@
+#pragma once
+
+#include "kern/resource/ColorFormat.h"
+#include "kern/resource/Image.h"
+
+/**
+ * \brief Encodes uncompressed image data into a block compressed format.
+ *
+ * The source must be a single level GreyScale8, RGB24 or RGBA32 image. Mip levels are computed with a box
+ * filter before compression if requested. BC5 stores the red and green channel of a tangent space normal map,
+ * mip levels of BC5 images are renormalized. BC7 blocks are encoded in mode 6 only.
+ * \return False if the source or target format is not supported.
+ */
+bool encode(const Image &source, ColorFormat format, bool createMipmaps, Image &result);
@@ -7,8 +7,10 @@
 #include "kern/resource/ResourceId.h"
 #include "kern/resource/PrimitiveType.h"
 #include "kern/resource/ColorFormat.h"
+#include "kern/resource/Image.h"
 
 class IResourceListener; /**< Listener class. */
+class MemoryReport;
 
 /**
  * \brief Resource manager interface class.
@@ -58,6 +60,11 @@ class IResourceManager
     virtual ResourceId createImage(const std::vector<unsigned char> &imageData, unsigned int width,
                                    unsigned int height, ColorFormat format) = 0;
 
+    /**
+     * \brief Creates texture object from image data with all mip levels and returns id.
+     */
+    virtual ResourceId createImage(const Image &image) = 0;
+
     /**
      * \brief Loads image from file.
      */
@@ -69,6 +76,11 @@ class IResourceManager
     virtual bool getImage(ResourceId id, std::vector<unsigned char> &data, unsigned int &width,
                           unsigned int &height, ColorFormat &format) const = 0;
 
+    /**
+     * \brief Retrieves image data with all mip levels.
+     */
+    virtual bool getImage(ResourceId id, Image &image) const = 0;
+
     /**
      * \brief Creates material.
      */
@@ -118,6 +130,23 @@ class IResourceManager
      */
     virtual bool getString(ResourceId id, std::string &text) const = 0;
 
+    /**
+     * \brief Enables reloading modified files loaded with loadString, see update.
+     */
+    virtual void setHotReload(bool enabled) = 0;
+
+    /**
+     * \brief Reloads modified files if hot reloading is enabled, listeners are notified with change events.
+     *
+     * Call once per frame.
+     */
+    virtual void update() = 0;
+
+    /**
+     * \brief Adds the memory used by loaded resources by type.
+     */
+    virtual void reportMemory(MemoryReport &report) const = 0;
+
     /**
      * \brief Creates shader resource.
      */
@@ -7,15 +7,19 @@
 
 /**
  * \brief Image data.
+ *
+ * The data holds m_levels mip levels back to back, starting with the full size level.
+ * Every level halves the dimensions of the previous one, rounded down to at least 1.
  */
 struct Image
 {
     Image() = default;
     Image(std::vector<unsigned char> data, unsigned int width, unsigned int height,
-           ColorFormat format);
+           ColorFormat format, unsigned int levels = 1);
 
     std::vector<unsigned char> m_data;
     unsigned int m_width = 0;
     unsigned int m_height = 0;
     ColorFormat m_format = ColorFormat::Invalid;
+    unsigned int m_levels = 1;
 };
@@ -6,5 +6,18 @@
 #include "kern/resource/ColorFormat.h"
 #include "kern/resource/Image.h"
 
+/**
+ * \brief Loads an image file.
+ *
+ * Files ending in .dds or .ktx2 are loaded as stored, including precomputed mip levels. Container
+ * files are expected with the bottom row first, as written by save().
+ * Other files are decoded with stb_image and flipped vertically.
+ */
 bool load(const std::string &file, Image &image);
+
+/**
+ * \brief Loads an image file and converts uncompressed image data to the requested format.
+ *
+ * DDS and KTX2 files keep their stored format, the requested format is ignored for them.
+ */
 bool load(const std::string &file, ColorFormat format, Image &image);
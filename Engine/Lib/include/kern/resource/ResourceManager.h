@@ -7,6 +7,7 @@
 #include <vector>
 #include <functional>
 
+#include "kern/foundation/FileWatcher.h"
 #include "kern/resource/IResourceLoader.h"
 #include "kern/resource/IResourceManager.h"
 #include "kern/resource/Image.h"
@@ -40,11 +41,15 @@ class ResourceManager : public IResourceManager
     ResourceId createImage(const std::vector<unsigned char> &imageData, unsigned int width, unsigned int height,
                            ColorFormat format) override;
 
+    ResourceId createImage(const Image &image) override;
+
     ResourceId loadImage(const std::string &file, ColorFormat format) override;
 
     bool getImage(ResourceId id, std::vector<unsigned char> &data, unsigned int &width, unsigned int &height,
                   ColorFormat &format) const override;
 
+    bool getImage(ResourceId id, Image &image) const override;
+
     ResourceId createMaterial(ResourceId base, ResourceId normal, ResourceId specular, ResourceId glow,
                               ResourceId alpha) override;
 
@@ -65,6 +70,12 @@ class ResourceManager : public IResourceManager
 
     bool getString(ResourceId id, std::string &text) const override;
 
+    void setHotReload(bool enabled) override;
+
+    void update() override;
+
+    void reportMemory(MemoryReport &report) const override;
+
     ResourceId createShader(ResourceId vertex, ResourceId tessCtrl, ResourceId tessEval, ResourceId geometry,
                             ResourceId fragment) override;
 
@@ -105,6 +116,8 @@ class ResourceManager : public IResourceManager
     std::unordered_map<std::string, ResourceId> m_textFiles;     /**< Maps text file to string resource id. */
     std::unordered_map<std::string, ResourceId> m_shaderFiles;   /**< Maps shader program file to shader resource id. */
 
+    std::unique_ptr<FileWatcher> m_fileWatcher;         /**< Watches text files, only set with hot reload. */
+
     std::list<IResourceListener *> m_resourceListeners; /**< Registered listeners. */
     // Resource loader creation functions
     std::unordered_map<std::string, std::function<std::unique_ptr<IResourceLoader>(void)>> m_resourceLoaderCreators;
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+#include "kern/resource/Image.h"
+
+/**
+ * \brief Saves block compressed image data with all mip levels as DDS file.
+ *
+ * Rows are stored as in the image data, see load().
+ */
+bool save(const std::string &file, const Image &image);
@@ -1,9 +1,20 @@
 #include "kern/app/GameApplication.h"
 
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "kern/foundation/AllocationCounter.h"
+#include "kern/graphics/scene/InterpolatedScene.h"
+
+// Ticks the simulation catches up at most before skipping time, e.g. after a debugger break
+const int maxCatchUpTicks = 5;
+
 GameApplication::GameApplication()
 {
-    //
+    m_jobSystem = std::make_unique<JobSystem>(0);
     m_gameSystem = std::make_unique<GameSystem>();
+    setTickRate(60);
 }
 
 GameApplication::~GameApplication()
@@ -13,4 +24,92 @@ GameApplication::~GameApplication()
 }
 
 bool GameApplication::init() { return true; }
-void GameApplication::run() {}
\ No newline at end of file
+
+void GameApplication::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    m_running = true;
+    m_lastTick = Clock::now().time_since_epoch().count();
+    std::thread simulation(&GameApplication::runSimulation, this);
+
+    while (m_running)
+    {
+        beginAllocationFrame();
+        Clock::duration sinceTick = Clock::now().time_since_epoch() - Clock::duration(m_lastTick.load());
+        float alpha = std::min((float)sinceTick.count() / (float)m_tick.count(), 1.f);
+
+        bool running = true;
+        if (m_scene != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(m_scene->getMutex());
+            m_scene->apply(alpha);
+            running = render(alpha);
+        }
+        else
+        {
+            running = render(alpha);
+        }
+        if (!running)
+        {
+            m_running = false;
+        }
+    }
+    simulation.join();
+}
+
+JobSystem &GameApplication::getJobSystem() { return *m_jobSystem; }
+
+void GameApplication::stop() { m_running = false; }
+
+void GameApplication::setTickRate(unsigned int ticksPerSecond)
+{
+    m_tick = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)) /
+             std::max(ticksPerSecond, 1u);
+}
+
+bool GameApplication::simulate(float dtime)
+{
+    bool running = m_gameSystem->update(dtime);
+    if (m_soundSystem != nullptr)
+    {
+        m_soundSystem->update(dtime);
+    }
+    return running;
+}
+
+bool GameApplication::render(float alpha) { return true; }
+
+void GameApplication::runSimulation()
+{
+    using Clock = std::chrono::steady_clock;
+
+    float dtime = std::chrono::duration<float>(m_tick).count();
+    Clock::time_point next = Clock::now() + m_tick;
+    while (m_running)
+    {
+        std::this_thread::sleep_until(next);
+
+        // Run the missed ticks after a slow tick, drop them if too far behind
+        int ticks = 0;
+        while (m_running && next <= Clock::now() && ticks < maxCatchUpTicks)
+        {
+            if (!simulate(dtime))
+            {
+                m_running = false;
+                break;
+            }
+            if (m_scene != nullptr)
+            {
+                m_scene->publish();
+            }
+            m_lastTick = next.time_since_epoch().count();
+            next += m_tick;
+            ++ticks;
+        }
+        if (ticks == maxCatchUpTicks)
+        {
+            next = Clock::now() + m_tick;
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#include "kern/audio/Mp3Decoder.h"
+
+#include <stdexcept>
+
+Mp3Decoder::Mp3Decoder(const std::string& fileName)
+{
+    // Byte seeking only needs to restart from the beginning for looping
+    if (mp3dec_ex_open(&decoder, fileName.c_str(), MP3D_SEEK_TO_BYTE) != 0)
+    {
+        throw std::runtime_error("Failed to open mp3");
+    }
+}
+
+Mp3Decoder::~Mp3Decoder() { mp3dec_ex_close(&decoder); }
+
+std::size_t Mp3Decoder::read(std::int16_t* samples, std::size_t count)
+{
+    static_assert(sizeof(mp3d_sample_t) == sizeof(std::int16_t), "Expected 16 bit mp3 output");
+    return mp3dec_ex_read(&decoder, reinterpret_cast<mp3d_sample_t*>(samples), count);
+}
+
+bool Mp3Decoder::rewind() { return mp3dec_ex_seek(&decoder, 0) == 0; }
+
+unsigned short Mp3Decoder::getChannels() const { return static_cast<unsigned short>(decoder.info.channels); }
+
+unsigned int Mp3Decoder::getFrequency() const { return static_cast<unsigned int>(decoder.info.hz); }
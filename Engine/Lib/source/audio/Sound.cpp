@@ -28,12 +28,31 @@ Sound::Sound(const void* pcmSampleData, std::size_t sizeInBytes, unsigned short
     alGenBuffers(1, &buffer);
     format = toALFormat(channels, bitsPerSample);
     alBufferData(buffer, format, pcmSampleData, sizeInBytes, frequency);
+    length = static_cast<float>(sizeInBytes) / (channels * (bitsPerSample / 8)) / frequency;
+    size = sizeInBytes;
 }
 
-Sound::~Sound() { alDeleteBuffers(1, &buffer); }
+Sound::Sound(const std::function<std::unique_ptr<SoundDecoder>()>& factory) : decoderFactory(factory)
+{
+    logd("Creating streamed sound");
+}
+
+Sound::~Sound()
+{
+    if (buffer != 0)
+    {
+        alDeleteBuffers(1, &buffer);
+    }
+}
 
 ALuint Sound::getBuffer() const { return buffer; }
 
 ALenum Sound::getOALFormat() const { return format; }
 
-float Sound::getLength() const { return 0.f; }
\ No newline at end of file
+bool Sound::isStreaming() const { return decoderFactory != nullptr; }
+
+std::unique_ptr<SoundDecoder> Sound::openDecoder() const { return decoderFactory(); }
+
+float Sound::getLength() const { return length; }
+
+std::size_t Sound::getSize() const { return size; }
\ No newline at end of file
@@ -1,16 +1,30 @@
 #include "kern/audio/SoundEmitter.h"
 
+#include <cmath>
+
 SoundEmitter::SoundEmitter() : SoundEmitter(nullptr) {}
 
-SoundEmitter::SoundEmitter(const std::shared_ptr<Sound>& sound) : sound(sound) { alGenSources(1, &source); }
+SoundEmitter::SoundEmitter(const std::shared_ptr<Sound>& sound) : sound(sound) {}
 
-SoundEmitter::~SoundEmitter() { alDeleteSources(1, &source); }
+SoundEmitter::~SoundEmitter() { stop(); }
 
 void SoundEmitter::play()
 {
     stop();
-    alSourcei(source, AL_BUFFER, sound->getBuffer());
-    alSourcePlay(source);
+    if (sound == nullptr)
+        return;
+
+    playing = true;
+    playTime = 0.f;
+    if (sound->isStreaming())
+    {
+        stream = std::make_unique<SoundStream>(sound->openDecoder(), looping);
+    }
+    // Without voice the sound system assigns one on its next update
+    if (source != 0)
+    {
+        startVoice();
+    }
 }
 
 void SoundEmitter::play(const std::shared_ptr<Sound>& sound)
@@ -19,7 +33,118 @@ void SoundEmitter::play(const std::shared_ptr<Sound>& sound)
     play();
 }
 
-void SoundEmitter::stop() { alSourceStop(source); }
+void SoundEmitter::stop()
+{
+    playing = false;
+    if (source != 0)
+    {
+        alSourceStop(source);
+        // Unqueues all buffers before the stream deletes them
+        alSourcei(source, AL_BUFFER, 0);
+    }
+    stream = nullptr;
+}
+
+bool SoundEmitter::isPlaying() const { return playing; }
+
+bool SoundEmitter::hasVoice() const { return source != 0; }
+
+void SoundEmitter::update(float dtime)
+{
+    if (!playing)
+    {
+        return;
+    }
+
+    if (source == 0)
+    {
+        // Streams pause without voice, detaching kept their unplayed data
+        if (stream != nullptr)
+        {
+            return;
+        }
+        // Virtual voice, advances without output
+        playTime += dtime;
+        float length = sound->getLength();
+        if (looping && length > 0.f)
+        {
+            playTime = std::fmod(playTime, length);
+        }
+        else if (playTime >= length)
+        {
+            playing = false;
+        }
+        return;
+    }
+
+    if (stream != nullptr)
+    {
+        if (!stream->update(source))
+        {
+            stop();
+        }
+        return;
+    }
+
+    ALint state = 0;
+    alGetSourcei(source, AL_SOURCE_STATE, &state);
+    if (state == AL_STOPPED)
+    {
+        playing = false;
+        return;
+    }
+    alGetSourcef(source, AL_SEC_OFFSET, &playTime);
+}
+
+void SoundEmitter::assignVoice(ALuint voice)
+{
+    source = voice;
+    if (playing)
+    {
+        startVoice();
+    }
+}
+
+ALuint SoundEmitter::releaseVoice()
+{
+    ALuint voice = source;
+    if (voice == 0)
+    {
+        return 0;
+    }
+    if (stream != nullptr)
+    {
+        stream->detach(voice);
+    }
+    else
+    {
+        alSourceStop(voice);
+    }
+    alSourcei(voice, AL_BUFFER, 0);
+    source = 0;
+    return voice;
+}
+
+void SoundEmitter::startVoice()
+{
+    // Voices are shared, every property of a former owner is replaced
+    alSource3f(source, AL_POSITION, position.x, position.y, position.z);
+    alSource3f(source, AL_VELOCITY, velocity.x, velocity.y, velocity.z);
+    alSourcef(source, AL_GAIN, volume);
+    if (stream != nullptr)
+    {
+        // Streams loop by rewinding the decoder, looping the source would repeat the queued buffers
+        // The stream queues its buffers and starts the voice on update
+        alSourcei(source, AL_LOOPING, AL_FALSE);
+        alSourcei(source, AL_BUFFER, 0);
+        stream->update(source);
+        return;
+    }
+    alSourcei(source, AL_LOOPING, looping ? AL_TRUE : AL_FALSE);
+    alSourcei(source, AL_BUFFER, sound->getBuffer());
+    alSourcef(source, AL_SEC_OFFSET, playTime);
+    alSourcePlay(source);
+}
 
 void SoundEmitter::setSound(const std::shared_ptr<Sound>& sound)
 {
@@ -30,7 +155,8 @@ void SoundEmitter::setSound(const std::shared_ptr<Sound>& sound)
 void SoundEmitter::setPosition(const glm::vec3& pos)
 {
     position = pos;
-    alSource3f(source, AL_POSITION, position.x, position.y, position.z);
+    if (source != 0)
+        alSource3f(source, AL_POSITION, position.x, position.y, position.z);
 }
 
 const glm::vec3& SoundEmitter::getPosition() const { return position; }
@@ -38,7 +164,8 @@ const glm::vec3& SoundEmitter::getPosition() const { return position; }
 void SoundEmitter::setVelocity(const glm::vec3& vel)
 {
     velocity = vel;
-    alSource3f(source, AL_VELOCITY, velocity.x, velocity.y, velocity.z);
+    if (source != 0)
+        alSource3f(source, AL_VELOCITY, velocity.x, velocity.y, velocity.z);
 }
 
 const glm::vec3& SoundEmitter::getVelocity() const { return velocity; }
@@ -51,8 +178,9 @@ float SoundEmitter::getVolume() const { return volume; }
 
 void SoundEmitter::setVolume(float vol)
 {
-    alSourcef(source, AL_GAIN, vol);
     volume = vol;
+    if (source != 0)
+        alSourcef(source, AL_GAIN, vol);
 }
 
 bool SoundEmitter::getLooping() const { return looping; }
@@ -60,9 +188,15 @@ bool SoundEmitter::getLooping() const { return looping; }
 void SoundEmitter::setLooping(bool loop)
 {
     looping = loop;
-    alSourcei(source, AL_LOOPING, loop ? AL_TRUE : AL_FALSE);
+    if (stream != nullptr)
+    {
+        stream->setLooping(loop);
+        return;
+    }
+    if (source != 0)
+        alSourcei(source, AL_LOOPING, loop ? AL_TRUE : AL_FALSE);
 }
 
 float SoundEmitter::getRadius() const { return radius; }
 
-void SoundEmitter::setRadius(float radi) { radius = radi; }
\ No newline at end of file
+void SoundEmitter::setRadius(float radi) { radius = radi; }
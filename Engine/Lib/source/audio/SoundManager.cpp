@@ -8,6 +8,10 @@
 #define MINIMP3_IMPLEMENTATION
 #include <minimp3_ex.h>
 
+#include "kern/audio/Mp3Decoder.h"
+#include "kern/audio/VorbisDecoder.h"
+#include "kern/foundation/MemoryReport.h"
+
 struct WavHeader
 {
     int16_t format = 0;
@@ -24,12 +28,14 @@ struct WavHeader
 
 SoundManager::SoundManager(const std::string& soundDirectory) : directory(soundDirectory) {}
 
-void SoundManager::registerSound(const std::string& name, const std::string& fileName)
+void SoundManager::registerSound(const std::string& name, const std::string& fileName, bool streaming)
 {
     if (namesToFiles.find(name) != namesToFiles.end())
         throw std::runtime_error("Name already exists in mappings");
 
     namesToFiles[name] = fileName;
+    if (streaming)
+        streamedFiles.insert(fileName);
 }
 
 std::shared_ptr<Sound> SoundManager::getSound(const std::string& name)
@@ -59,19 +65,47 @@ bool SoundManager::hasSound(const std::string& name) const
     return fileIter != namesToFiles.end();
 }
 
+void SoundManager::reportMemory(MemoryReport& report) const
+{
+    std::size_t bufferedCount = 0;
+    std::size_t bufferedSize = 0;
+    for (const auto& sound : filesToSounds)
+    {
+        if (!sound.second->isStreaming())
+        {
+            ++bufferedCount;
+            bufferedSize += sound.second->getSize();
+        }
+    }
+    report.add("audio/sound", bufferedCount, bufferedSize);
+    report.add("audio/stream", filesToSounds.size() - bufferedCount, 0);
+}
+
 std::shared_ptr<Sound> SoundManager::loadFromFile(const std::string& fileName)
 {
     auto extension = fileName.substr(fileName.length() - 4);
     auto fullPath = directory + "/" + fileName;
     logi("Loading sound file {} from path {}", fileName, directory);
+    if (streamedFiles.count(fileName) != 0)
+    {
+        if (extension == ".mp3")
+        {
+            return loadStreamFromMp3(fullPath);
+        }
+        if (extension == ".ogg")
+        {
+            return loadStreamFromOgg(fullPath);
+        }
+        logw("Streaming is not supported for {}, decoding at once", fileName);
+    }
+
     if (extension == ".wav")
     {
         return loadFromWav(fullPath);
     }
     else if (extension == ".ogg")
     {
-        // TODO
-        return nullptr;
+        return loadFromOgg(fullPath);
     }
     else if (extension == ".mp3")
     {
@@ -256,4 +290,44 @@ std::shared_ptr<Sound> SoundManager::loadFromMp3(const std::string& fileName)
                                          static_cast<unsigned int>(sizeof(mp3d_sample_t) * 8), info.hz);
     free(info.buffer);
     return sound;
+}
+
+std::shared_ptr<Sound> SoundManager::loadStreamFromMp3(const std::string& fileName)
+{
+    // Fail at load time like full decodes instead of on the first playback
+    Mp3Decoder decoder(fileName);
+    return std::make_shared<Sound>([fileName]() { return std::unique_ptr<SoundDecoder>(new Mp3Decoder(fileName)); });
+}
+
+std::shared_ptr<Sound> SoundManager::loadFromOgg(const std::string& fileName)
+{
+    VorbisDecoder decoder(fileName);
+
+    // Length is known up front for seekable files, decode into a single allocation
+    std::vector<std::int16_t> samples(decoder.getSampleCount());
+    std::size_t count = decoder.read(samples.data(), samples.size());
+    // Unknown or wrong length, decode the rest in blocks
+    const std::size_t blockSize = 65536;
+    while (count == samples.size())
+    {
+        samples.resize(samples.size() + blockSize);
+        std::size_t read = decoder.read(samples.data() + count, blockSize);
+        count += read;
+        if (read == 0)
+            break;
+    }
+    samples.resize(count);
+    if (samples.empty())
+    {
+        throw std::runtime_error("Failed to decode ogg vorbis");
+    }
+
+    return std::make_shared<Sound>(samples.data(), samples.size() * sizeof(std::int16_t), decoder.getChannels(), 16,
+                                   decoder.getFrequency());
+}
+
+std::shared_ptr<Sound> SoundManager::loadStreamFromOgg(const std::string& fileName)
+{
+    VorbisDecoder decoder(fileName);
+    return std::make_shared<Sound>([fileName]() { return std::unique_ptr<SoundDecoder>(new VorbisDecoder(fileName)); });
 }
\ No newline at end of file
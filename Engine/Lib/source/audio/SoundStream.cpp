@@ -0,0 +1,170 @@
+#include "kern/audio/SoundStream.h"
+
+#include <algorithm>
+#include <iterator>
+
+// Rotating buffers, chunks are decoded ahead up to the same count
+const std::size_t bufferCount = 4;
+// Frames per chunk, about 0.2 seconds at 44.1 kHz
+const std::size_t chunkFrames = 8192;
+
+SoundStream::SoundStream(std::unique_ptr<SoundDecoder> dec, bool loop) : decoder(std::move(dec)), looping(loop)
+{
+    channels = decoder->getChannels();
+    format = channels > 1 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+    frequency = decoder->getFrequency();
+
+    buffers.resize(bufferCount);
+    alGenBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
+    freeBuffers = buffers;
+
+    thread = std::thread(&SoundStream::decode, this);
+}
+
+SoundStream::~SoundStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    condition.notify_one();
+    thread.join();
+    alDeleteBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
+}
+
+bool SoundStream::update(ALuint source)
+{
+    // Reclaim played buffers
+    ALint processed = 0;
+    alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+    for (ALint i = 0; i < processed; ++i)
+    {
+        ALuint buffer = 0;
+        alSourceUnqueueBuffers(source, 1, &buffer);
+        freeBuffers.push_back(buffer);
+        queuedChunks.pop_front();
+    }
+
+    // Refill, uploads happen outside the lock to not stall the decoder
+    bool finished = false;
+    while (!freeBuffers.empty())
+    {
+        std::vector<std::int16_t> chunk;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = decoded && chunks.empty();
+            if (chunks.empty())
+            {
+                break;
+            }
+            chunk = std::move(chunks.front());
+            chunks.pop_front();
+        }
+        condition.notify_one();
+
+        ALuint buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+        alBufferData(buffer, format, chunk.data(), static_cast<ALsizei>(chunk.size() * sizeof(std::int16_t)),
+                     static_cast<ALsizei>(frequency));
+        alSourceQueueBuffers(source, 1, &buffer);
+        queuedChunks.push_back(std::move(chunk));
+    }
+
+    ALint queued = 0;
+    ALint state = 0;
+    alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+    alGetSourcei(source, AL_SOURCE_STATE, &state);
+    if (queued > 0 && state != AL_PLAYING)
+    {
+        // Initial start or the decoder fell behind
+        alSourcePlay(source);
+    }
+    return queued > 0 || !finished;
+}
+
+void SoundStream::detach(ALuint source)
+{
+    // Frames played since the start of the queue, a source that ran dry played all of it
+    ALint state = 0;
+    ALint offset = 0;
+    alGetSourcei(source, AL_SOURCE_STATE, &state);
+    alGetSourcei(source, AL_SAMPLE_OFFSET, &offset);
+
+    // Stopped sources mark all queued buffers as processed
+    alSourceStop(source);
+    ALint queued = 0;
+    alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+    for (ALint i = 0; i < queued; ++i)
+    {
+        ALuint buffer = 0;
+        alSourceUnqueueBuffers(source, 1, &buffer);
+        freeBuffers.push_back(buffer);
+    }
+
+    // Unplayed data is queued again before the chunks decoded ahead
+    std::deque<std::vector<std::int16_t>> unplayed;
+    if (state != AL_STOPPED)
+    {
+        std::size_t skipped = static_cast<std::size_t>(std::max(offset, 0)) * channels;
+        for (auto &chunk : queuedChunks)
+        {
+            if (skipped >= chunk.size())
+            {
+                skipped -= chunk.size();
+                continue;
+            }
+            chunk.erase(chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(skipped));
+            skipped = 0;
+            unplayed.push_back(std::move(chunk));
+        }
+    }
+    queuedChunks.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    chunks.insert(chunks.begin(), std::make_move_iterator(unplayed.begin()), std::make_move_iterator(unplayed.end()));
+}
+
+void SoundStream::setLooping(bool loop) { looping = loop; }
+
+void SoundStream::decode()
+{
+    const std::size_t chunkSamples = chunkFrames * decoder->getChannels();
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        condition.wait(lock, [this] { return quit || (!decoded && chunks.size() < bufferCount); });
+        if (quit)
+        {
+            return;
+        }
+        lock.unlock();
+
+        std::vector<std::int16_t> chunk(chunkSamples);
+        std::size_t count = 0;
+        bool rewound = false;
+        while (count < chunk.size())
+        {
+            std::size_t read = decoder->read(chunk.data() + count, chunk.size() - count);
+            count += read;
+            if (read > 0)
+            {
+                rewound = false;
+                continue;
+            }
+            // End of data, an empty read directly after rewinding means there is nothing to loop
+            if (!looping || rewound || !decoder->rewind())
+            {
+                break;
+            }
+            rewound = true;
+        }
+        chunk.resize(count);
+
+        lock.lock();
+        decoded = count < chunkSamples;
+        if (!chunk.empty())
+        {
+            chunks.push_back(std::move(chunk));
+        }
+    }
+}
@@ -1,8 +1,12 @@
 #include "kern/audio/SoundSystem.h"
 
+#include <algorithm>
 #include <stdexcept>
 
-SoundSystem::SoundSystem(const std::string& directory) : manager(std::make_shared<SoundManager>(directory))
+#include <fmtlog/fmtlog.h>
+
+SoundSystem::SoundSystem(const std::string& directory, unsigned int voiceCount)
+    : manager(std::make_shared<SoundManager>(directory))
 {
     // Default device
     device = alcOpenDevice(nullptr);
@@ -19,15 +23,39 @@ SoundSystem::SoundSystem(const std::string& directory) : manager(std::make_share
 
     alcMakeContextCurrent(context);
 
-    // bgm emitter
+    // Devices limit the number of sources, take as many as available up to the requested count
+    alGetError();
+    for (unsigned int i = 0; i < voiceCount; ++i)
+    {
+        ALuint voice = 0;
+        alGenSources(1, &voice);
+        if (alGetError() != AL_NO_ERROR)
+        {
+            logw("Created {} of {} sound voices", i, voiceCount);
+            break;
+        }
+        voices.push_back(voice);
+    }
+    freeVoices = voices;
+
+    // bgm emitter, music is never culled
     bgmEmitter = createEmitter();
+    bgmEmitter->setPriority(SoundPriority::Always);
 }
 
 SoundSystem::~SoundSystem()
 {
     // Cleanup in order
     bgmEmitter = nullptr;
+    // Emitters may outlive the system, they must not keep voices
+    for (const auto& emitter : emitters)
+    {
+        emitter->releaseVoice();
+    }
     emitters.clear();
+    alDeleteSources(static_cast<ALsizei>(voices.size()), voices.data());
+    voices.clear();
+    freeVoices.clear();
     manager = nullptr;
     alcMakeContextCurrent(nullptr);
 
@@ -42,7 +70,76 @@ SoundListener& SoundSystem::getListener() { return listener; }
 
 std::shared_ptr<SoundManager>& SoundSystem::getManager() { return manager; }
 
-void SoundSystem::update(float dtime) { return; }
+void SoundSystem::update(float dtime)
+{
+    struct SCandidate
+    {
+        SoundEmitter* emitter;
+        SoundPriority priority;
+        float distance;
+    };
+    std::vector<SCandidate> candidates;
+    candidates.reserve(emitters.size());
+
+    auto iter = emitters.begin();
+    while (iter != emitters.end())
+    {
+        SoundEmitter* emitter = iter->get();
+        emitter->update(dtime);
+
+        // Fire and forget emitters finish playing before they are released
+        if (!emitter->isPlaying() && iter->use_count() == 1)
+        {
+            if (emitter->hasVoice())
+            {
+                freeVoices.push_back(emitter->releaseVoice());
+            }
+            iter = emitters.erase(iter);
+            continue;
+        }
+        ++iter;
+
+        float distance = glm::distance(emitter->getPosition(), listener.getPosition());
+        bool audible = emitter->getPriority() == SoundPriority::Always ||
+                       (emitter->getVolume() > 0.f && (emitter->getRadius() <= 0.f || distance <= emitter->getRadius()));
+        if (emitter->isPlaying() && audible)
+        {
+            candidates.push_back({emitter, emitter->getPriority(), distance});
+        }
+        else if (emitter->hasVoice())
+        {
+            // Culled emitters stay virtual
+            freeVoices.push_back(emitter->releaseVoice());
+        }
+    }
+
+    // Most important emitters first
+    std::size_t voiced = std::min(candidates.size(), voices.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + voiced, candidates.end(),
+                      [](const SCandidate& a, const SCandidate& b)
+                      {
+                          if (a.priority != b.priority)
+                              return a.priority > b.priority;
+                          return a.distance < b.distance;
+                      });
+
+    // Steal voices of less important emitters before handing them out
+    for (std::size_t i = voiced; i < candidates.size(); ++i)
+    {
+        if (candidates[i].emitter->hasVoice())
+        {
+            freeVoices.push_back(candidates[i].emitter->releaseVoice());
+        }
+    }
+    for (std::size_t i = 0; i < voiced; ++i)
+    {
+        if (!candidates[i].emitter->hasVoice())
+        {
+            candidates[i].emitter->assignVoice(freeVoices.back());
+            freeVoices.pop_back();
+        }
+    }
+}
 
 std::shared_ptr<SoundEmitter> SoundSystem::createEmitter() { return createEmitter(nullptr); }
 
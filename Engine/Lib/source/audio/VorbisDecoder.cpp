@@ -0,0 +1,58 @@
+#include "kern/audio/VorbisDecoder.h"
+
+#include <stdexcept>
+
+VorbisDecoder::VorbisDecoder(const std::string& fileName)
+{
+    if (ov_fopen(fileName.c_str(), &file) != 0)
+    {
+        throw std::runtime_error("Failed to open ogg vorbis");
+    }
+    // Chained streams with changing formats are not supported, the first stream defines the format
+    vorbis_info* info = ov_info(&file, -1);
+    if (info == nullptr || info->channels < 1 || info->channels > 2)
+    {
+        ov_clear(&file);
+        throw std::runtime_error("Unsupported ogg vorbis format");
+    }
+    channels = static_cast<unsigned short>(info->channels);
+    frequency = static_cast<unsigned int>(info->rate);
+}
+
+VorbisDecoder::~VorbisDecoder() { ov_clear(&file); }
+
+std::size_t VorbisDecoder::read(std::int16_t* samples, std::size_t count)
+{
+    // ov_read returns at most one packet per call
+    char* data = reinterpret_cast<char*>(samples);
+    std::size_t size = count * sizeof(std::int16_t);
+    std::size_t offset = 0;
+    while (offset < size)
+    {
+        int bitstream = 0;
+        long bytes = ov_read(&file, data + offset, static_cast<int>(size - offset), 0, 2, 1, &bitstream);
+        if (bytes == OV_HOLE)
+        {
+            // Interruption in the data, decoding continues after it
+            continue;
+        }
+        if (bytes <= 0)
+        {
+            break;
+        }
+        offset += static_cast<std::size_t>(bytes);
+    }
+    return offset / sizeof(std::int16_t);
+}
+
+bool VorbisDecoder::rewind() { return ov_pcm_seek(&file, 0) == 0; }
+
+unsigned short VorbisDecoder::getChannels() const { return channels; }
+
+unsigned int VorbisDecoder::getFrequency() const { return frequency; }
+
+std::size_t VorbisDecoder::getSampleCount()
+{
+    ogg_int64_t frames = ov_pcm_total(&file, -1);
+    return frames > 0 ? static_cast<std::size_t>(frames) * channels : 0;
+}
@@ -0,0 +1,45 @@
+#include "kern/foundation/AllocationCounter.h"
+
+#include <atomic>
+
+// Per thread, counting needs no synchronization and other threads do not disturb measurements
+thread_local std::uint64_t allocationCount = 0;
+// All threads, only the totals need to be exact
+std::atomic<std::uint64_t> totalAllocationCount{0};
+std::atomic<std::uint64_t> totalAllocatedBytes{0};
+std::atomic<bool> allocationHookInstalled{false};
+
+void installAllocationHook() { allocationHookInstalled = true; }
+
+void countAllocation(std::size_t size)
+{
+    ++allocationCount;
+    totalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    totalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+bool isAllocationCounterEnabled() { return allocationHookInstalled; }
+
+std::uint64_t getAllocationCount() { return allocationCount; }
+
+std::uint64_t getTotalAllocationCount() { return totalAllocationCount.load(std::memory_order_relaxed); }
+
+std::uint64_t getTotalAllocatedBytes() { return totalAllocatedBytes.load(std::memory_order_relaxed); }
+
+// Totals at the start of the current frame and counts of the last frame
+std::atomic<std::uint64_t> frameStartCount{0};
+std::atomic<std::uint64_t> frameStartBytes{0};
+std::atomic<std::uint64_t> frameCount{0};
+std::atomic<std::uint64_t> frameBytes{0};
+
+void beginAllocationFrame()
+{
+    std::uint64_t count = getTotalAllocationCount();
+    std::uint64_t bytes = getTotalAllocatedBytes();
+    frameCount = count - frameStartCount.exchange(count);
+    frameBytes = bytes - frameStartBytes.exchange(bytes);
+}
+
+std::uint64_t getFrameAllocationCount() { return frameCount; }
+
+std::uint64_t getFrameAllocatedBytes() { return frameBytes; }
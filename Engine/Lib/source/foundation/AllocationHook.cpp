@@ -0,0 +1,37 @@
+#include "kern/foundation/AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces global operator new of the program, built into the engine with the KERN_ALLOCATION_HOOK option
+// The tests build it into their executable if the engine is built without
+#ifdef KERN_ALLOCATION_HOOK
+
+// Allocations of earlier static initializers are counted nevertheless
+static const bool hookInstalled = (installAllocationHook(), true);
+
+static void *allocate(std::size_t size)
+{
+    countAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(std::size_t size)
+{
+    void *pointer = allocate(size);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { std::free(pointer); }
+
+#endif
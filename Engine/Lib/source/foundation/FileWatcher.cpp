@@ -0,0 +1,122 @@
+#include "kern/foundation/FileWatcher.h"
+
+#include <fmtlog/fmtlog.h>
+
+#include <algorithm>
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Normalized absolute path, used to match event file names against watched files
+static std::string getPath(const std::filesystem::path &file)
+{
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::absolute(file, error);
+    return (error ? file : path).lexically_normal().string();
+}
+
+// Modification time of the file, 0 if the file does not exist
+static long long getModified(const std::string &file)
+{
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(file, error);
+    return error ? 0 : (long long)time.time_since_epoch().count();
+}
+
+FileWatcher::FileWatcher()
+{
+#ifdef __linux__
+    m_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_descriptor == -1)
+    {
+        logw("Failed to initialize inotify, falling back to polling watched files.");
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (m_descriptor != -1)
+    {
+        close(m_descriptor);
+    }
+#endif
+}
+
+bool FileWatcher::watch(const std::string &file)
+{
+    std::string path = getPath(file);
+    if (m_files.count(path) != 0)
+    {
+        return true;
+    }
+
+#ifdef __linux__
+    if (m_descriptor != -1)
+    {
+        // Watch descriptors are unique per directory, adding a directory twice returns the same descriptor
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        int watch = inotify_add_watch(m_descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watch == -1)
+        {
+            logw("Failed to watch directory {} of file {}.", directory, file);
+            return false;
+        }
+        m_directories[watch] = directory;
+    }
+#endif
+
+    SFile entry;
+    entry.file = file;
+    entry.modified = getModified(path);
+    m_files[path] = entry;
+    return true;
+}
+
+void FileWatcher::poll(std::vector<std::string> &changed)
+{
+    std::size_t first = changed.size();
+
+#ifdef __linux__
+    if (m_descriptor != -1)
+    {
+        alignas(inotify_event) char buffer[4096];
+        ssize_t size = 0;
+        while ((size = read(m_descriptor, buffer, sizeof(buffer))) > 0)
+        {
+            for (char *data = buffer; data < buffer + size;)
+            {
+                const inotify_event *event = (const inotify_event *)data;
+                data += sizeof(inotify_event) + event->len;
+
+                auto directory = m_directories.find(event->wd);
+                if (event->len == 0 || directory == m_directories.end())
+                {
+                    continue;
+                }
+                auto iter = m_files.find(getPath(std::filesystem::path(directory->second) / event->name));
+                if (iter != m_files.end() &&
+                    std::find(changed.begin() + first, changed.end(), iter->second.file) == changed.end())
+                {
+                    changed.push_back(iter->second.file);
+                }
+            }
+        }
+        return;
+    }
+#endif
+
+    for (auto &entry : m_files)
+    {
+        long long modified = getModified(entry.first);
+        if (modified != entry.second.modified)
+        {
+            entry.second.modified = modified;
+            changed.push_back(entry.second.file);
+        }
+    }
+}
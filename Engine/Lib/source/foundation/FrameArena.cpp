@@ -0,0 +1,60 @@
+#include "kern/foundation/FrameArena.h"
+
+#include <cstdint>
+
+// Aligns the offset up to the power of two alignment
+static std::size_t align(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+FrameArena::FrameArena(std::size_t capacity)
+    : m_buffer(new unsigned char[capacity]), m_capacity(capacity)
+{
+}
+
+void *FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    // Buffer start is aligned for any fundamental type, larger alignments are aligned by address
+    std::uintptr_t base = (std::uintptr_t)m_buffer.get();
+    std::size_t begin = align(base + m_offset, alignment) - base;
+    if (begin + size <= m_capacity)
+    {
+        m_offset = begin + size;
+        return m_buffer.get() + begin;
+    }
+
+    // Does not fit, served from the heap until the next reset grows the buffer
+    m_overflow.emplace_back(new unsigned char[size + alignment]);
+    m_overflowSize += size + alignment;
+    std::uintptr_t address = (std::uintptr_t)m_overflow.back().get();
+    return (void *)align(address, alignment);
+}
+
+void FrameArena::deallocate(void *pointer, std::size_t size)
+{
+    unsigned char *bytes = (unsigned char *)pointer;
+    if (bytes >= m_buffer.get() && bytes + size == m_buffer.get() + m_offset)
+    {
+        m_offset -= size;
+    }
+}
+
+void FrameArena::reset()
+{
+    if (!m_overflow.empty())
+    {
+        // Room for the whole last frame
+        m_capacity += m_overflowSize;
+        m_buffer.reset(new unsigned char[m_capacity]);
+        m_overflow.clear();
+        m_overflowSize = 0;
+    }
+    m_offset = 0;
+}
+
+std::size_t FrameArena::getUsed() const { return m_offset; }
+
+std::size_t FrameArena::getCapacity() const { return m_capacity; }
+
+std::size_t FrameArena::getOverflowCount() const { return m_overflow.size(); }
@@ -0,0 +1,227 @@
+#include "kern/foundation/JobSystem.h"
+
+#include <algorithm>
+
+// Queue of the calling thread if it is a worker
+thread_local const JobSystem *currentSystem = nullptr;
+thread_local unsigned int currentQueue = 0;
+
+bool JobCounter::isDone() const
+{
+    // Waiters may destroy the counter once done, finishing threads must have left it
+    return m_pending == 0 && m_finishing == 0;
+}
+
+JobSystem::JobSystem(unsigned int threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Calling thread counts as the first thread and uses the shared queue
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        m_queues.push_back(std::make_unique<SQueue>());
+    }
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        m_threads.emplace_back(&JobSystem::workerMain, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_shutdown = true;
+    }
+    m_wakeup.notify_all();
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+unsigned int JobSystem::getThreadCount() const { return (unsigned int)m_threads.size() + 1; }
+
+void JobSystem::submit(std::function<void()> function, JobCounter *counter, JobCounter *dependency)
+{
+    SJob job;
+    job.function = std::move(function);
+    job.counter = counter;
+    if (counter != nullptr)
+    {
+        ++counter->m_pending;
+    }
+
+    if (dependency != nullptr)
+    {
+        // The last finishing job of the dependency takes the continuations under the same lock
+        std::lock_guard<std::mutex> lock(dependency->m_mutex);
+        if (dependency->m_pending != 0)
+        {
+            dependency->m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+    push(std::move(job));
+}
+
+void JobSystem::wait(const JobCounter &counter)
+{
+    while (!counter.isDone())
+    {
+        if (runJob())
+        {
+            continue;
+        }
+
+        // Jobs of the counter are running on other threads, sleep until a job is queued or a counted job finished
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        ++m_sleepingWorkers;
+        ++m_sleepingWaiters;
+        m_wakeup.wait(lock, [this, &counter] { return counter.isDone() || m_queuedJobs != 0; });
+        --m_sleepingWaiters;
+        --m_sleepingWorkers;
+    }
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grainSize,
+                            const std::function<void(std::size_t, std::size_t)> &function)
+{
+    grainSize = std::max(grainSize, (std::size_t)1);
+    std::size_t rangeCount = (count + grainSize - 1) / grainSize;
+    if (m_threads.empty() || rangeCount <= 1)
+    {
+        // Not worth queueing
+        for (std::size_t begin = 0; begin < count; begin += grainSize)
+        {
+            function(begin, std::min(begin + grainSize, count));
+        }
+        return;
+    }
+
+    JobCounter counter;
+    for (std::size_t range = 1; range < rangeCount; ++range)
+    {
+        std::size_t begin = range * grainSize;
+        std::size_t end = std::min(begin + grainSize, count);
+        submit([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+    function(0, grainSize);
+    wait(counter);
+}
+
+void JobSystem::workerMain(unsigned int queue)
+{
+    currentSystem = this;
+    currentQueue = queue;
+    while (true)
+    {
+        if (runJob())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        ++m_sleepingWorkers;
+        m_wakeup.wait(lock, [this] { return m_shutdown || m_queuedJobs != 0; });
+        --m_sleepingWorkers;
+        if (m_shutdown)
+        {
+            return;
+        }
+    }
+}
+
+void JobSystem::push(SJob job)
+{
+    SQueue &queue = *m_queues[getQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    ++m_queuedJobs;
+
+    // Workers count themselves as sleeping before checking for jobs, the wakeup is never lost
+    if (m_sleepingWorkers != 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wakeup.notify_one();
+    }
+}
+
+bool JobSystem::runJob()
+{
+    if (m_queuedJobs == 0)
+    {
+        return false;
+    }
+
+    SJob job;
+    bool found = false;
+    unsigned int own = getQueue();
+    {
+        // Newest own job first, its data is most likely still cached
+        SQueue &queue = *m_queues[own];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            found = true;
+        }
+    }
+    for (std::size_t i = 1; !found && i < m_queues.size(); ++i)
+    {
+        // Steal the oldest job, usually the largest remaining piece of work
+        SQueue &queue = *m_queues[(own + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        return false;
+    }
+    --m_queuedJobs;
+
+    job.function();
+
+    JobCounter *counter = job.counter;
+    if (counter != nullptr)
+    {
+        std::vector<SJob> continuations;
+        ++counter->m_finishing;
+        if (counter->m_pending.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(counter->m_mutex);
+            continuations.swap(counter->m_continuations);
+        }
+        --counter->m_finishing;
+
+        // The counter may be gone already, every finished job wakes the waiters to check their counters
+        // Waiters count themselves as sleeping before checking, the wakeup is never lost
+        if (m_sleepingWaiters != 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_wakeup.notify_all();
+        }
+        for (auto &continuation : continuations)
+        {
+            push(std::move(continuation));
+        }
+    }
+    return true;
+}
+
+unsigned int JobSystem::getQueue() const { return currentSystem == this ? currentQueue : 0; }
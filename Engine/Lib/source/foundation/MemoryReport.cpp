@@ -0,0 +1,69 @@
+#include "kern/foundation/MemoryReport.h"
+
+#include <fstream>
+
+#include <fmtlog/fmtlog.h>
+
+#include "kern/foundation/AllocationCounter.h"
+
+static nlohmann::json toJson(const SMemoryUsage &usage)
+{
+    return {{"count", usage.count}, {"cpuBytes", usage.cpuBytes}, {"gpuBytes", usage.gpuBytes}};
+}
+
+void MemoryReport::add(const std::string &category, std::size_t count, std::size_t cpuBytes, std::size_t gpuBytes)
+{
+    SMemoryUsage &usage = m_categories[category];
+    usage.count += count;
+    usage.cpuBytes += cpuBytes;
+    usage.gpuBytes += gpuBytes;
+}
+
+SMemoryUsage MemoryReport::getUsage(const std::string &category) const
+{
+    auto iter = m_categories.find(category);
+    return iter == m_categories.end() ? SMemoryUsage() : iter->second;
+}
+
+const std::map<std::string, SMemoryUsage> &MemoryReport::getCategories() const { return m_categories; }
+
+SMemoryUsage MemoryReport::getTotal() const
+{
+    SMemoryUsage total;
+    for (const auto &category : m_categories)
+    {
+        total.count += category.second.count;
+        total.cpuBytes += category.second.cpuBytes;
+        total.gpuBytes += category.second.gpuBytes;
+    }
+    return total;
+}
+
+nlohmann::json MemoryReport::toJson() const
+{
+    nlohmann::json root;
+    root["categories"] = nlohmann::json::object();
+    for (const auto &category : m_categories)
+    {
+        root["categories"][category.first] = ::toJson(category.second);
+    }
+    root["total"] = ::toJson(getTotal());
+    root["allocations"] = {{"enabled", isAllocationCounterEnabled()},
+                           {"frameCount", getFrameAllocationCount()},
+                           {"frameBytes", getFrameAllocatedBytes()},
+                           {"totalCount", getTotalAllocationCount()},
+                           {"totalBytes", getTotalAllocatedBytes()}};
+    return root;
+}
+
+bool MemoryReport::save(const std::string &file) const
+{
+    std::ofstream stream(file);
+    stream << toJson().dump(4);
+    if (!stream)
+    {
+        logw("Failed to write memory report {}.", file);
+        return false;
+    }
+    return true;
+}
@@ -2,6 +2,8 @@
 
 const std::string errStr("Error");
 
+AGameState::AGameState(JobSystem &jobs) : m_gameWorld(jobs) {}
+
 AGameState::~AGameState()
 {
     // Empty
@@ -42,12 +42,15 @@ void GameObject::addController(const std::shared_ptr<IGameObjectController> &con
     assert(controller != nullptr);
     controller->attach(this);
     m_controllers.push_back(controller);
+    m_controllersChanged = true;
 }
 
 void GameObject::setSceneObject(SceneObjectProxy *proxy)
 {
     assert(proxy != nullptr);
     m_sceneObject.reset(proxy);
+    // Sync on next update
+    m_transformationChanged = true;
 }
 
 const glm::vec3 &GameObject::getPosition() const { return m_position; }
@@ -56,6 +59,18 @@ const glm::vec3 &GameObject::getScale() const { return m_scale; }
 
 const glm::vec3 &GameObject::getForward() const { return m_forward; }
 
+const std::vector<std::shared_ptr<IGameObjectController>> &GameObject::getControllers() const
+{
+    return m_controllers;
+}
+
+bool GameObject::fetchControllersChanged()
+{
+    bool changed = m_controllersChanged;
+    m_controllersChanged = false;
+    return changed;
+}
+
 void GameObject::update(float dtime)
 {
     // Update object controllers
@@ -63,10 +78,15 @@ void GameObject::update(float dtime)
     {
         controller->update(dtime);
     }
+    updateTransformation();
+}
 
+void GameObject::updateTransformation()
+{
     // Update attached objects if tranformation of the game object has changed
     if (m_transformationChanged)
     {
+        m_transformationChanged = false;
         // Update scene object
         if (m_sceneObject != nullptr)
         {
@@ -107,6 +127,14 @@ void GameObject::sendMessage(Message message)
     }
 }
 
+void GameObject::receiveMessage(const SMessage &message)
+{
+    for (auto &controller : m_controllers)
+    {
+        controller->handleMessage(message);
+    }
+}
+
 void GameObject::setCollidable(Collidable *entity)
 {
     assert(entity != nullptr);
@@ -1,27 +1,172 @@
 #include "kern/game/GameWorld.h"
 
+#include <algorithm>
 #include <cassert>
 
+#include "kern/foundation/JobSystem.h"
+#include "kern/game/IGameObjectController.h"
+#include "kern/graphics/collision/Collidable.h"
+
+// Number of parallel controllers updated per task
+const std::size_t controllerChunkSize = 64;
+
+GameWorld::GameWorld(JobSystem &jobs) : m_jobs(jobs) {}
+
+GameWorld::~GameWorld()
+{
+    // Controllers are owned by the objects
+    m_buckets.clear();
+}
+
 void GameWorld::update(float dtime)
 {
-    for (auto iter = m_objects.begin(); iter != m_objects.end();)
+    // Objects added since the last update
+    applyChanges();
+
+    // Update controllers type by type
+    for (auto &bucket : m_buckets)
     {
-        // Update single game object
-        (*iter)->update(dtime);
-        if ((*iter)->isDeleteRequested())
-        {
-            // Delete object
-            iter = m_objects.erase(iter);
-        }
-        else
+        updateBucket(bucket, dtime);
+    }
+
+    // Pass transformations on to scene objects and collidables
+    for (auto &object : m_objects)
+    {
+        object->updateTransformation();
+        if (object->hasCollidable())
         {
-            ++iter;
+            // Damage from the last collision update
+            SDamageMessage damage;
+            damage.damage = object->getCollidable()->getDamageReceived();
+            if (damage.damage != 0.f)
+            {
+                m_messages.post(object.get(), Message::DAMAGE, damage);
+            }
         }
     }
+
+    // Deliver messages in batches by type
+    m_messages.dispatch();
+
+    // Structural changes requested during the update
+    applyChanges();
 }
 
 void GameWorld::addObject(GameObject *object)
 {
     assert(object != nullptr);
-    m_objects.push_back(std::unique_ptr<GameObject>(object));
+    m_addedObjects.push_back(std::unique_ptr<GameObject>(object));
+}
+
+JobSystem &GameWorld::getJobSystem() { return m_jobs; }
+
+MessageQueue &GameWorld::getMessageQueue() { return m_messages; }
+
+void GameWorld::applyChanges()
+{
+    // Remove controllers of deleted objects first
+    bool deleted = false;
+    for (auto &object : m_objects)
+    {
+        if (object->isDeleteRequested())
+        {
+            deleted = true;
+            break;
+        }
+    }
+    if (deleted)
+    {
+        m_messages.removeDeleted();
+        for (auto &bucket : m_buckets)
+        {
+            auto &controllers = bucket.controllers;
+            controllers.erase(std::remove_if(controllers.begin(), controllers.end(),
+                                             [](const SControllerEntry &entry) {
+                                                 return entry.object->isDeleteRequested();
+                                             }),
+                              controllers.end());
+        }
+
+        // Delete objects, keeps the order of the remaining objects
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+        {
+            if (!m_objects[i]->isDeleteRequested())
+            {
+                m_objects[kept] = std::move(m_objects[i]);
+                m_registeredControllers[kept] = m_registeredControllers[i];
+                ++kept;
+            }
+        }
+        m_objects.resize(kept);
+        m_registeredControllers.resize(kept);
+    }
+
+    // Controllers added to existing objects
+    for (std::size_t i = 0; i < m_objects.size(); ++i)
+    {
+        if (m_objects[i]->fetchControllersChanged())
+        {
+            registerControllers(m_objects[i].get(), m_registeredControllers[i]);
+            m_registeredControllers[i] = m_objects[i]->getControllers().size();
+        }
+    }
+
+    // Added objects, may add more objects while being moved
+    for (std::size_t i = 0; i < m_addedObjects.size(); ++i)
+    {
+        GameObject *object = m_addedObjects[i].get();
+        object->fetchControllersChanged();
+        registerControllers(object, 0);
+        m_objects.push_back(std::move(m_addedObjects[i]));
+        m_registeredControllers.push_back(object->getControllers().size());
+    }
+    m_addedObjects.clear();
+}
+
+void GameWorld::registerControllers(GameObject *object, std::size_t first)
+{
+    const auto &controllers = object->getControllers();
+    for (std::size_t i = first; i < controllers.size(); ++i)
+    {
+        IGameObjectController *controller = controllers[i].get();
+        std::type_index type = typeid(*controller);
+
+        // Few controller types, linear search is fine
+        auto bucket = std::find_if(m_buckets.begin(), m_buckets.end(),
+                                   [&type](const SControllerBucket &entry) { return entry.type == type; });
+        if (bucket == m_buckets.end())
+        {
+            m_buckets.emplace_back();
+            bucket = m_buckets.end() - 1;
+            bucket->type = type;
+        }
+        bucket->parallel = bucket->parallel && controller->isParallel();
+
+        SControllerEntry entry;
+        entry.controller = controller;
+        entry.object = object;
+        bucket->controllers.push_back(entry);
+    }
+}
+
+void GameWorld::updateBucket(SControllerBucket &bucket, float dtime)
+{
+    auto &controllers = bucket.controllers;
+    if (!bucket.parallel || controllers.size() <= controllerChunkSize)
+    {
+        for (auto &entry : controllers)
+        {
+            entry.controller->update(dtime);
+        }
+        return;
+    }
+
+    m_jobs.parallelFor(controllers.size(), controllerChunkSize,
+                        [&controllers, dtime](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            controllers[i].controller->update(dtime);
+        }
+    });
 }
@@ -1,3 +1,7 @@
 #include "kern/game/IGameObjectController.h"
 
-IGameObjectController::~IGameObjectController() { return; }
\ No newline at end of file
+IGameObjectController::~IGameObjectController() { return; }
+
+void IGameObjectController::handleMessage(const SMessage &message) { receiveMessage(message.type); }
+
+bool IGameObjectController::isParallel() const { return false; }
@@ -0,0 +1,90 @@
+#include "kern/game/MessageQueue.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "kern/game/GameObject.h"
+
+void MessageQueue::post(GameObject *target, Message type) { push(target, type, 0, 0, nullptr); }
+
+void MessageQueue::dispatch()
+{
+    // Messages posted by receivers go into the other frame
+    SFrame &frame = m_frames[m_current];
+    m_current = 1 - m_current;
+
+    for (std::size_t type = 0; type < static_cast<std::size_t>(Message::NumMessages); ++type)
+    {
+        for (const auto &record : frame.records[type])
+        {
+            if (record.target->isDeleteRequested())
+            {
+                continue;
+            }
+            SMessage message;
+            message.type = static_cast<Message>(type);
+            message.payload = record.size > 0 ? frame.data.data() + record.offset : nullptr;
+            message.payloadType = record.payloadType;
+            message.size = record.size;
+            record.target->receiveMessage(message);
+        }
+        frame.records[type].clear();
+    }
+    frame.used = 0;
+}
+
+void MessageQueue::removeDeleted()
+{
+    for (auto &frame : m_frames)
+    {
+        for (auto &records : frame.records)
+        {
+            records.erase(std::remove_if(records.begin(), records.end(),
+                                         [](const SRecord &record) { return record.target->isDeleteRequested(); }),
+                          records.end());
+        }
+    }
+}
+
+void MessageQueue::clear()
+{
+    for (auto &frame : m_frames)
+    {
+        for (auto &records : frame.records)
+        {
+            records.clear();
+        }
+        frame.used = 0;
+    }
+}
+
+std::size_t MessageQueue::size() const
+{
+    std::size_t count = 0;
+    for (const auto &records : m_frames[m_current].records)
+    {
+        count += records.size();
+    }
+    return count;
+}
+
+std::size_t MessageQueue::allocate(std::size_t size, std::size_t alignment)
+{
+    SFrame &frame = m_frames[m_current];
+    std::size_t offset = (frame.used + alignment - 1) / alignment * alignment;
+    if (offset + size > frame.data.size())
+    {
+        // Grows only until the high water mark is reached
+        frame.data.resize(std::max(frame.data.size() * 2, offset + size));
+    }
+    frame.used = offset + size;
+    return offset;
+}
+
+void MessageQueue::push(GameObject *target, Message type, std::size_t offset, std::size_t size,
+                        const void *payloadType)
+{
+    assert(target != nullptr);
+    assert(type != Message::NumMessages);
+    m_frames[m_current].records[static_cast<std::size_t>(type)].push_back({target, offset, size, payloadType});
+}
@@ -1,3 +1,5 @@
 #include "kern/graphics/IRenderer.h"
 
-IRenderer::~IRenderer() {}
\ No newline at end of file
+IRenderer::~IRenderer() {}
+
+void IRenderer::reportMemory(MemoryReport &report) const {}
\ No newline at end of file
@@ -107,7 +107,7 @@ Window::~Window()
     s_windows.erase(m_window);
 }
 
-bool Window::init(unsigned int width, unsigned int height, const std::string &name)
+bool Window::init(unsigned int width, unsigned int height, const std::string &name, bool visible)
 {
     if (glfwInit() != GLFW_TRUE)
     {
@@ -125,6 +125,7 @@ bool Window::init(unsigned int width, unsigned int height, const std::string &na
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_FALSE);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 
 #ifndef NDEBUG
     // Enable debugging
@@ -152,8 +153,8 @@ bool Window::init(unsigned int width, unsigned int height, const std::string &na
 
     glfwMakeContextCurrent(m_window);
     glfwSetInputMode(m_window, GLFW_STICKY_KEYS, GL_FALSE);
-    // Vsync ON
-    glfwSwapInterval(1);
+    // Vsync ON, hidden windows are not presented and must not wait
+    glfwSwapInterval(visible ? 1 : 0);
 
 // Load OpenGL extensions
 #ifndef __APPLE__
@@ -1,5 +1,6 @@
 #include "kern/graphics/collision/AABBox.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <sstream>
@@ -88,4 +89,43 @@ bool collides(const AABBox &box1, const AABBox &box2)
         return false;
     }
     return true;
-}
\ No newline at end of file
+}
+
+bool collides(const AABBox &box1, const glm::vec3 &move1, const AABBox &box2, const glm::vec3 &move2,
+              float &timeOfImpact)
+{
+    // Move the mid point of box1 relative to box2 and test against the combined box
+    glm::vec3 velocity = move1 - move2;
+    glm::vec3 diff = box2.getMid() - box1.getMid();
+    glm::vec3 widths = box1.getHalfWidths() + box2.getHalfWidths();
+
+    float enter = 0.f;
+    float exit = 1.f;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (velocity[i] == 0.f)
+        {
+            // No movement on this axis, must overlap for the whole step
+            if (std::abs(diff[i]) > widths[i])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float t0 = (diff[i] - widths[i]) / velocity[i];
+        float t1 = (diff[i] + widths[i]) / velocity[i];
+        if (t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        if (enter > exit)
+        {
+            return false;
+        }
+    }
+    timeOfImpact = enter;
+    return true;
+}
@@ -0,0 +1,397 @@
+#include "kern/graphics/collision/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "kern/graphics/collision/Collidable.h"
+
+// Maximum entry count per leaf
+const unsigned int maxLeafSize = 4;
+// Traversal stack size, median splits keep the tree depth logarithmic
+const unsigned int maxStackSize = 64;
+
+// Distance along the ray to the box entry, returns false if the box is missed
+static bool intersectRay(const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance,
+                         const glm::vec3 &min, const glm::vec3 &max, float &distance)
+{
+    float enter = 0.f;
+    float exit = maxDistance;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::isinf(inverseDirection[axis]))
+        {
+            // Parallel to the slab, an origin on a slab plane would give 0 * inf
+            if (origin[axis] < min[axis] || origin[axis] > max[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (min[axis] - origin[axis]) * inverseDirection[axis];
+        float t1 = (max[axis] - origin[axis]) * inverseDirection[axis];
+        enter = std::max(enter, std::min(t0, t1));
+        exit = std::min(exit, std::max(t0, t1));
+    }
+    distance = enter;
+    return enter <= exit;
+}
+
+// Squared distance from the point to the box, zero if inside
+static float squaredDistance(const glm::vec3 &point, const glm::vec3 &min, const glm::vec3 &max)
+{
+    glm::vec3 diff = point - glm::clamp(point, min, max);
+    return glm::dot(diff, diff);
+}
+
+static bool overlaps(const glm::vec3 &min1, const glm::vec3 &max1, const glm::vec3 &min2, const glm::vec3 &max2)
+{
+    return min1.x <= max2.x && min2.x <= max1.x && min1.y <= max2.y && min2.y <= max1.y && min1.z <= max2.z &&
+           min2.z <= max1.z;
+}
+
+// Box overlap test
+struct SBoxTest
+{
+    glm::vec3 min;
+    glm::vec3 max;
+
+    bool testNode(const glm::vec3 &nodeMin, const glm::vec3 &nodeMax) const
+    {
+        return overlaps(min, max, nodeMin, nodeMax);
+    }
+};
+
+// Sphere overlap test
+struct SSphereTest
+{
+    glm::vec3 center;
+    float squaredRadius;
+
+    bool testNode(const glm::vec3 &nodeMin, const glm::vec3 &nodeMax) const
+    {
+        return squaredDistance(center, nodeMin, nodeMax) <= squaredRadius;
+    }
+};
+
+void BoundingVolumeHierarchy::clear()
+{
+    m_entries.clear();
+    m_nodes.clear();
+    m_entryIndices.clear();
+}
+
+void BoundingVolumeHierarchy::add(Collidable *entity)
+{
+    assert(entity != nullptr);
+    const AABBox &box = entity->getAABBox();
+    SEntry entry;
+    entry.min = box.getMid() - box.getHalfWidths();
+    entry.max = box.getMid() + box.getHalfWidths();
+    entry.mid = box.getMid();
+    entry.groupId = entity->getGroupId();
+    entry.entity = entity;
+    m_entries.push_back(entry);
+}
+
+void BoundingVolumeHierarchy::build()
+{
+    m_nodes.clear();
+    if (!m_entries.empty())
+    {
+        buildNode(0, (unsigned int)m_entries.size());
+    }
+
+    // Entries keep their position until the next build
+    m_entryIndices.resize(m_entries.size());
+    for (unsigned int i = 0; i < m_entries.size(); ++i)
+    {
+        m_entryIndices[i].entity = m_entries[i].entity;
+        m_entryIndices[i].index = i;
+    }
+    std::sort(m_entryIndices.begin(), m_entryIndices.end(),
+              [](const SEntryIndex &a, const SEntryIndex &b) { return a.entity < b.entity; });
+}
+
+void BoundingVolumeHierarchy::remove(const Collidable *entity)
+{
+    auto iter = std::lower_bound(
+        m_entryIndices.begin(), m_entryIndices.end(), entity,
+        [](const SEntryIndex &index, const Collidable *entity) { return index.entity < entity; });
+    for (; iter != m_entryIndices.end() && iter->entity == entity; ++iter)
+    {
+        m_entries[iter->index].entity = nullptr;
+    }
+
+    // Entries added since the last build are not indexed yet
+    for (std::size_t i = m_entryIndices.size(); i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].entity == entity)
+        {
+            m_entries[i].entity = nullptr;
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::buildNode(unsigned int begin, unsigned int end)
+{
+    unsigned int nodeIndex = (unsigned int)m_nodes.size();
+    m_nodes.emplace_back();
+
+    // Node bounds and mid point bounds for the split axis
+    glm::vec3 min = m_entries[begin].min;
+    glm::vec3 max = m_entries[begin].max;
+    glm::vec3 midMin = m_entries[begin].mid;
+    glm::vec3 midMax = m_entries[begin].mid;
+    for (unsigned int i = begin + 1; i < end; ++i)
+    {
+        min = glm::min(min, m_entries[i].min);
+        max = glm::max(max, m_entries[i].max);
+        midMin = glm::min(midMin, m_entries[i].mid);
+        midMax = glm::max(midMax, m_entries[i].mid);
+    }
+    m_nodes[nodeIndex].min = min;
+    m_nodes[nodeIndex].max = max;
+
+    if (end - begin <= maxLeafSize)
+    {
+        m_nodes[nodeIndex].index = begin;
+        m_nodes[nodeIndex].count = end - begin;
+        return;
+    }
+
+    // Median split along the longest axis of the mid points
+    glm::vec3 extent = midMax - midMin;
+    int axis = 0;
+    if (extent.y > extent.x)
+    {
+        axis = 1;
+    }
+    if (extent.z > extent[axis])
+    {
+        axis = 2;
+    }
+    unsigned int middle = begin + (end - begin) / 2;
+    std::nth_element(m_entries.begin() + begin, m_entries.begin() + middle, m_entries.begin() + end,
+                     [axis](const SEntry &a, const SEntry &b) { return a.mid[axis] < b.mid[axis]; });
+
+    // Left child follows directly
+    buildNode(begin, middle);
+    m_nodes[nodeIndex].index = (unsigned int)m_nodes.size();
+    buildNode(middle, end);
+}
+
+bool BoundingVolumeHierarchy::isQueryable(const SEntry &entry, unsigned int ignoredGroup) const
+{
+    return entry.entity != nullptr && entry.groupId != ignoredGroup && !entry.entity->deleteRequested();
+}
+
+bool BoundingVolumeHierarchy::rayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance,
+                                      SRayHit &hit, unsigned int ignoredGroup) const
+{
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+
+    // Zero components give infinite inverses, see intersectRay
+    glm::vec3 inverseDirection = 1.f / direction;
+    float closest = maxDistance;
+    Collidable *closestEntity = nullptr;
+
+    unsigned int stack[maxStackSize];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        unsigned int nodeIndex = stack[--stackSize];
+        const SNode &node = m_nodes[nodeIndex];
+        float distance = 0.f;
+        if (!intersectRay(origin, inverseDirection, closest, node.min, node.max, distance))
+        {
+            continue;
+        }
+
+        if (node.count > 0)
+        {
+            for (unsigned int i = node.index; i < node.index + node.count; ++i)
+            {
+                const SEntry &entry = m_entries[i];
+                if (isQueryable(entry, ignoredGroup) &&
+                    intersectRay(origin, inverseDirection, closest, entry.min, entry.max, distance))
+                {
+                    closest = distance;
+                    closestEntity = entry.entity;
+                }
+            }
+        }
+        else
+        {
+            unsigned int left = nodeIndex + 1;
+            unsigned int right = node.index;
+            // Visit the child in ray direction first
+            int axis = 0;
+            glm::vec3 absDirection = glm::abs(direction);
+            if (absDirection.y > absDirection.x)
+            {
+                axis = 1;
+            }
+            if (absDirection.z > absDirection[axis])
+            {
+                axis = 2;
+            }
+            if (direction[axis] < 0.f)
+            {
+                std::swap(left, right);
+            }
+            stack[stackSize++] = right;
+            stack[stackSize++] = left;
+        }
+    }
+
+    if (closestEntity == nullptr)
+    {
+        return false;
+    }
+    hit.entity = closestEntity;
+    hit.distance = closest;
+    return true;
+}
+
+template <typename T>
+std::size_t BoundingVolumeHierarchy::overlap(const T &test, Collidable **results, std::size_t maxResults,
+                                             unsigned int ignoredGroup) const
+{
+    if (m_nodes.empty() || maxResults == 0)
+    {
+        return 0;
+    }
+
+    std::size_t count = 0;
+    unsigned int stack[maxStackSize];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        unsigned int nodeIndex = stack[--stackSize];
+        const SNode &node = m_nodes[nodeIndex];
+        if (!test.testNode(node.min, node.max))
+        {
+            continue;
+        }
+
+        if (node.count > 0)
+        {
+            for (unsigned int i = node.index; i < node.index + node.count; ++i)
+            {
+                const SEntry &entry = m_entries[i];
+                if (isQueryable(entry, ignoredGroup) && test.testNode(entry.min, entry.max))
+                {
+                    results[count++] = entry.entity;
+                    if (count == maxResults)
+                    {
+                        return count;
+                    }
+                }
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.index;
+            stack[stackSize++] = nodeIndex + 1;
+        }
+    }
+    return count;
+}
+
+std::size_t BoundingVolumeHierarchy::overlap(const AABBox &box, Collidable **results, std::size_t maxResults,
+                                             unsigned int ignoredGroup) const
+{
+    SBoxTest test;
+    test.min = box.getMid() - box.getHalfWidths();
+    test.max = box.getMid() + box.getHalfWidths();
+    return overlap(test, results, maxResults, ignoredGroup);
+}
+
+std::size_t BoundingVolumeHierarchy::overlap(const BoundingSphere &sphere, Collidable **results,
+                                             std::size_t maxResults, unsigned int ignoredGroup) const
+{
+    SSphereTest test;
+    test.center = sphere.getPosition();
+    test.squaredRadius = sphere.getRadius() * sphere.getRadius();
+    return overlap(test, results, maxResults, ignoredGroup);
+}
+
+std::size_t BoundingVolumeHierarchy::findNearest(const glm::vec3 &point, std::size_t k, Collidable **results,
+                                                 float *distances, unsigned int ignoredGroup) const
+{
+    if (m_nodes.empty() || k == 0)
+    {
+        return 0;
+    }
+
+    // Results are kept sorted by squared distance until the traversal is done
+    float *sorted = distances;
+    std::size_t count = 0;
+    unsigned int stack[maxStackSize];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        unsigned int nodeIndex = stack[--stackSize];
+        const SNode &node = m_nodes[nodeIndex];
+        // Mid points are inside the node bounds, skip nodes further away than the worst result
+        if (count == k && squaredDistance(point, node.min, node.max) >= sorted[count - 1])
+        {
+            continue;
+        }
+
+        if (node.count > 0)
+        {
+            for (unsigned int i = node.index; i < node.index + node.count; ++i)
+            {
+                const SEntry &entry = m_entries[i];
+                if (!isQueryable(entry, ignoredGroup))
+                {
+                    continue;
+                }
+                glm::vec3 diff = entry.mid - point;
+                float distance = glm::dot(diff, diff);
+                if (count == k && distance >= sorted[count - 1])
+                {
+                    continue;
+                }
+
+                // Insertion into the sorted results
+                std::size_t position = count < k ? count++ : count - 1;
+                while (position > 0 && sorted[position - 1] > distance)
+                {
+                    sorted[position] = sorted[position - 1];
+                    results[position] = results[position - 1];
+                    --position;
+                }
+                sorted[position] = distance;
+                results[position] = entry.entity;
+            }
+        }
+        else
+        {
+            // Visit the closer child first
+            unsigned int left = nodeIndex + 1;
+            unsigned int right = node.index;
+            if (squaredDistance(point, m_nodes[left].min, m_nodes[left].max) >
+                squaredDistance(point, m_nodes[right].min, m_nodes[right].max))
+            {
+                std::swap(left, right);
+            }
+            stack[stackSize++] = right;
+            stack[stackSize++] = left;
+        }
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        distances[i] = std::sqrt(distances[i]);
+    }
+    return count;
+}
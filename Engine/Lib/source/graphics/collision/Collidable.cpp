@@ -1,7 +1,7 @@
 #include "kern/graphics/collision/Collidable.h"
 
 Collidable::Collidable(unsigned int group, const AABBox &box)
-    : m_boxTransformed(box), m_box(box), m_groupId(group)
+    : m_boxTransformed(box), m_box(box), m_groupId(group), m_previousTranslation(box.getMid())
 {
 }
 
@@ -24,6 +24,26 @@ void Collidable::receiveDamage(float damage) { m_damageReceived += damage; }
 // Sets the damage dealt by this entity
 void Collidable::setDamage(float damage) { m_damageDealt = damage; }
 
+float Collidable::getTimeOfImpact() const { return m_timeOfImpact; }
+
+const glm::vec3 &Collidable::getContactTranslation() const { return m_contactTranslation; }
+
+void Collidable::receiveImpact(float timeOfImpact, const glm::vec3 &move)
+{
+    if (timeOfImpact < m_timeOfImpact)
+    {
+        // Back along the movement from the current translation
+        m_timeOfImpact = timeOfImpact;
+        m_contactTranslation = m_boxTransformed.getMid() - move * (1.f - timeOfImpact);
+    }
+}
+
+void Collidable::resetImpact()
+{
+    m_timeOfImpact = 1.f;
+    m_contactTranslation = m_boxTransformed.getMid();
+}
+
 const AABBox &Collidable::getAABBox() const { return m_boxTransformed; }
 
 void Collidable::setScale(const glm::vec3 &scale)
@@ -35,9 +55,26 @@ void Collidable::setScale(const glm::vec3 &scale)
 void Collidable::setTranslation(const glm::vec3 &translate)
 {
     m_boxTransformed.setMid(translate);
+    if (!m_previousTranslationValid)
+    {
+        // Not tested yet, initial placement must not be swept
+        m_previousTranslation = translate;
+    }
     return;
 }
 
+const glm::vec3 &Collidable::getPreviousTranslation() const { return m_previousTranslation; }
+
+void Collidable::storePreviousTranslation()
+{
+    m_previousTranslation = m_boxTransformed.getMid();
+    m_previousTranslationValid = true;
+}
+
+void Collidable::setContinuous(bool state) { m_continuous = state; }
+
+bool Collidable::isContinuous() const { return m_continuous; }
+
 // Sets collidable state
 void Collidable::setCollidable(bool state) { m_collidable = state; }
 
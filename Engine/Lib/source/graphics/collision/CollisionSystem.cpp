@@ -1,11 +1,18 @@
 #include "kern/graphics/collision/CollisionSystem.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <fmtlog/fmtlog.h>
 
+#include "kern/foundation/JobSystem.h"
 #include "kern/graphics/collision/Collidable.h"
 
+// Number of sorted entries swept per task
+const std::size_t sweepChunkSize = 256;
+
+CollisionSystem::CollisionSystem(JobSystem &jobs) : m_jobs(jobs) {}
+
 unsigned int CollisionSystem::getNewGroupId()
 {
     // Add new collision group
@@ -42,6 +49,7 @@ Collidable *CollisionSystem::add(const AABBox &box, unsigned int groupId)
 // Removes collidable entity
 void CollisionSystem::remove(Collidable *entity)
 {
+    m_tree.remove(entity);
     m_entities[entity->getGroupId()].remove(entity);
     delete entity;
 }
@@ -49,62 +57,166 @@ void CollisionSystem::remove(Collidable *entity)
 // Test all entities for collision
 void CollisionSystem::update()
 {
-    for (unsigned int i = 0; i < m_entities.size(); ++i)
+    removeDeleted();
+    gatherEntities();
+
+    // Sweep chunks in parallel, every chunk writes only to its own pair buffer
+    std::size_t chunkCount = (m_sorted.size() + sweepChunkSize - 1) / sweepChunkSize;
+    if (m_pairBuffers.size() < chunkCount)
+    {
+        m_pairBuffers.resize(chunkCount);
+    }
+    m_jobs.parallelFor(m_sorted.size(), sweepChunkSize, [this](std::size_t begin, std::size_t end) {
+        testRange(begin, end, m_pairBuffers[begin / sweepChunkSize]);
+    });
+
+    // Merge in chunk order, the resulting pair order does not depend on the thread count
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        for (const auto &pair : m_pairBuffers[chunk])
+        {
+            Collidable *first = m_sorted[pair.first].entity;
+            Collidable *second = m_sorted[pair.second].entity;
+            first->receiveDamage(second->getDamage());
+            second->receiveDamage(first->getDamage());
+            first->receiveImpact(pair.timeOfImpact, m_sorted[pair.first].move);
+            second->receiveImpact(pair.timeOfImpact, m_sorted[pair.second].move);
+        }
+    }
+
+    // Spatial queries until the next update
+    m_tree.clear();
+    for (const auto &entry : m_sorted)
+    {
+        m_tree.add(entry.entity);
+    }
+    m_tree.build();
+}
+
+bool CollisionSystem::rayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, SRayHit &hit,
+                              unsigned int ignoredGroup) const
+{
+    return m_tree.rayCast(origin, direction, maxDistance, hit, ignoredGroup);
+}
+
+std::size_t CollisionSystem::overlap(const AABBox &box, Collidable **results, std::size_t maxResults,
+                                     unsigned int ignoredGroup) const
+{
+    return m_tree.overlap(box, results, maxResults, ignoredGroup);
+}
+
+std::size_t CollisionSystem::overlap(const BoundingSphere &sphere, Collidable **results, std::size_t maxResults,
+                                     unsigned int ignoredGroup) const
+{
+    return m_tree.overlap(sphere, results, maxResults, ignoredGroup);
+}
+
+std::size_t CollisionSystem::findNearest(const glm::vec3 &point, std::size_t k, Collidable **results,
+                                         float *distances, unsigned int ignoredGroup) const
+{
+    return m_tree.findNearest(point, k, results, distances, ignoredGroup);
+}
+
+void CollisionSystem::removeDeleted()
+{
+    for (auto &group : m_entities)
     {
-        auto iter = m_entities[i].begin();
-        while (iter != m_entities[i].end())
+        auto iter = group.begin();
+        while (iter != group.end())
         {
-            // Delete if requested
             if ((*iter)->deleteRequested())
             {
                 Collidable *temp = (*iter);
-                iter = m_entities[i].erase(iter);
+                iter = group.erase(iter);
                 delete temp;
             }
             else
             {
-                if ((*iter)->isCollidable())
-                {
-                    testCollision((*iter), i);
-                }
                 ++iter;
             }
         }
     }
 }
 
-// Tests collidable entity against all entities not in the group
-void CollisionSystem::testCollision(Collidable *entity, unsigned int group)
+void CollisionSystem::gatherEntities()
 {
-    // Everything gets tested twice, make this faster
+    m_sorted.clear();
     for (unsigned int i = 0; i < m_entities.size(); ++i)
     {
-        if (i != group)
+        for (Collidable *entity : m_entities[i])
         {
-            auto iter = m_entities[i].begin();
-            while (iter != m_entities[i].end())
+            if (entity->isCollidable())
             {
-                // Delete if requested
-                if ((*iter)->deleteRequested())
-                {
-                    Collidable *temp = (*iter);
-                    iter = m_entities[i].erase(iter);
-                    delete temp;
-                }
-                else
+                const AABBox &box = entity->getAABBox();
+                SEntry entry;
+                entry.min = box.getMid() - box.getHalfWidths();
+                entry.max = box.getMid() + box.getHalfWidths();
+                entry.move = glm::vec3(0.f);
+                entry.continuous = entity->isContinuous();
+                if (entry.continuous)
                 {
-                    if ((*iter)->isCollidable())
-                    {
-                        if (collides(entity->getAABBox(), (*iter)->getAABBox()))
-                        {
-                            // Since every collision is tested both ways, damage only happens
-                            // from first entity to second entity
-                            (*iter)->receiveDamage(entity->getDamage());
-                        }
-                    }
-                    ++iter;
+                    // Bounds cover the whole sweep
+                    entry.move = box.getMid() - entity->getPreviousTranslation();
+                    entry.min = glm::min(entry.min, entry.min - entry.move);
+                    entry.max = glm::max(entry.max, entry.max - entry.move);
                 }
+                entry.groupId = i;
+                entry.order = (unsigned int)m_sorted.size();
+                entry.entity = entity;
+                m_sorted.push_back(entry);
+            }
+            // Next sweep starts here
+            entity->storePreviousTranslation();
+            entity->resetImpact();
+        }
+    }
+
+    // Gather order breaks ties, keeps the sorted order deterministic
+    std::sort(m_sorted.begin(), m_sorted.end(), [](const SEntry &a, const SEntry &b) {
+        return a.min.x < b.min.x || (a.min.x == b.min.x && a.order < b.order);
+    });
+}
+
+void CollisionSystem::testRange(std::size_t begin, std::size_t end, std::vector<SPair> &pairs) const
+{
+    pairs.clear();
+    for (std::size_t p = begin; p < end; ++p)
+    {
+        const SEntry &a = m_sorted[p];
+        // Only entries starting before the end of a can overlap on the x axis
+        for (std::size_t q = p + 1; q < m_sorted.size() && m_sorted[q].min.x <= a.max.x; ++q)
+        {
+            const SEntry &b = m_sorted[q];
+            // Collidables in the same group are not tested
+            if (a.groupId == b.groupId)
+            {
+                continue;
+            }
+            SPair pair;
+            if (a.min.y <= b.max.y && b.min.y <= a.max.y && a.min.z <= b.max.z && b.min.z <= a.max.z &&
+                testPair(a, b, pair.timeOfImpact))
+            {
+                pair.first = (unsigned int)p;
+                pair.second = (unsigned int)q;
+                pairs.push_back(pair);
             }
         }
     }
-}
\ No newline at end of file
+}
+
+bool CollisionSystem::testPair(const SEntry &a, const SEntry &b, float &timeOfImpact) const
+{
+    timeOfImpact = 1.f;
+    if (!a.continuous && !b.continuous)
+    {
+        // Bounds are the boxes
+        return true;
+    }
+
+    // Sweep both boxes from their previous translation
+    AABBox startA = a.entity->getAABBox();
+    startA.setMid(startA.getMid() - a.move);
+    AABBox startB = b.entity->getAABBox();
+    startB.setMid(startB.getMid() - b.move);
+    return collides(startA, a.move, startB, b.move, timeOfImpact);
+}
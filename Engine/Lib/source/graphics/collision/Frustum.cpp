@@ -164,12 +164,9 @@ bool Frustum::isInsideOrIntersects(const BoundingSphere &sphere) const
             // Outside
             return false;
         }
-        else if (distance < radius)
-        {
-            // Intersects
-            return true;
-        }
     }
-    // Inside
+    // Inside or intersects
     return true;
 }
+
+const Plane *Frustum::getPlanes() const { return m_planes; }
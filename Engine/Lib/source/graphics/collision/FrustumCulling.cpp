@@ -0,0 +1,428 @@
+#include "kern/graphics/collision/FrustumCulling.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cmath>
+
+#include "kern/graphics/collision/Frustum.h"
+#include "kern/graphics/collision/Plane.h"
+
+// Widest instruction set enabled for the build, see the KERN_AVX2 option
+#if defined(__AVX2__)
+#define KERN_CULLING_AVX2
+#include <immintrin.h>
+const std::size_t blockSize = 8;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KERN_CULLING_SSE2
+#include <emmintrin.h>
+const std::size_t blockSize = 4;
+#else
+const std::size_t blockSize = 1;
+#endif
+
+/**
+ * \brief Plane coefficients in structure of arrays layout, absolute normals for box tests.
+ */
+struct SPlanes
+{
+    float a[6];
+    float b[6];
+    float c[6];
+    float d[6];
+    float absA[6];
+    float absB[6];
+    float absC[6];
+};
+
+/**
+ * \brief Sphere of a sphere view.
+ */
+struct SSphere
+{
+    float x;
+    float y;
+    float z;
+    float radius;
+};
+
+/**
+ * \brief View of a multi-view test with its planes in structure of arrays layout.
+ */
+struct SView
+{
+    bool isSphere;
+    SPlanes planes;
+    SSphere sphere;
+};
+
+static SPlanes getPlanes(const Frustum &frustum)
+{
+    SPlanes planes;
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        glm::vec4 coefficients = frustum.getPlanes()[i].getCoefficients();
+        planes.a[i] = coefficients.x;
+        planes.b[i] = coefficients.y;
+        planes.c[i] = coefficients.z;
+        planes.d[i] = coefficients.w;
+        planes.absA[i] = std::abs(coefficients.x);
+        planes.absB[i] = std::abs(coefficients.y);
+        planes.absC[i] = std::abs(coefficients.z);
+    }
+    return planes;
+}
+
+static bool isSphereVisible(const SPlanes &planes, const SSphereArray &spheres, std::size_t i)
+{
+    for (unsigned int p = 0; p < 6; ++p)
+    {
+        float distance = planes.a[p] * spheres.x[i] + planes.b[p] * spheres.y[i] + planes.c[p] * spheres.z[i] +
+                         planes.d[p];
+        if (distance < -spheres.radius[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isSphereOverlapping(const SSphere &sphere, const SSphereArray &spheres, std::size_t i)
+{
+    float dx = spheres.x[i] - sphere.x;
+    float dy = spheres.y[i] - sphere.y;
+    float dz = spheres.z[i] - sphere.z;
+    float radius = spheres.radius[i] + sphere.radius;
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+static bool isBoxVisible(const SPlanes &planes, const SBoxArray &boxes, std::size_t i)
+{
+    for (unsigned int p = 0; p < 6; ++p)
+    {
+        // Projected half width of the box onto the plane normal
+        float radius = planes.absA[p] * boxes.halfWidthX[i] + planes.absB[p] * boxes.halfWidthY[i] +
+                       planes.absC[p] * boxes.halfWidthZ[i];
+        float distance =
+            planes.a[p] * boxes.x[i] + planes.b[p] * boxes.y[i] + planes.c[p] * boxes.z[i] + planes.d[p];
+        if (distance < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Blocks return one visibility bit per lane, lane 0 in the lowest bit
+#if defined(KERN_CULLING_AVX2)
+static unsigned int testSphereBlock(const SPlanes &planes, const SSphereArray &spheres, std::size_t i)
+{
+    __m256 x = _mm256_loadu_ps(spheres.x.data() + i);
+    __m256 y = _mm256_loadu_ps(spheres.y.data() + i);
+    __m256 z = _mm256_loadu_ps(spheres.z.data() + i);
+    __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(spheres.radius.data() + i));
+    __m256 outside = _mm256_setzero_ps();
+    for (unsigned int p = 0; p < 6; ++p)
+    {
+        __m256 distance = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.a[p]), x), _mm256_mul_ps(_mm256_set1_ps(planes.b[p]), y)),
+            _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.c[p]), z), _mm256_set1_ps(planes.d[p])));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negativeRadius, _CMP_LT_OQ));
+    }
+    return ~(unsigned int)_mm256_movemask_ps(outside) & 0xFFu;
+}
+
+static unsigned int testSphereOverlapBlock(const SSphere &sphere, const SSphereArray &spheres, std::size_t i)
+{
+    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(spheres.x.data() + i), _mm256_set1_ps(sphere.x));
+    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(spheres.y.data() + i), _mm256_set1_ps(sphere.y));
+    __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(spheres.z.data() + i), _mm256_set1_ps(sphere.z));
+    __m256 radius = _mm256_add_ps(_mm256_loadu_ps(spheres.radius.data() + i), _mm256_set1_ps(sphere.radius));
+    __m256 distance =
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+    return (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_mul_ps(radius, radius), _CMP_LE_OQ));
+}
+
+static unsigned int testBoxBlock(const SPlanes &planes, const SBoxArray &boxes, std::size_t i)
+{
+    __m256 x = _mm256_loadu_ps(boxes.x.data() + i);
+    __m256 y = _mm256_loadu_ps(boxes.y.data() + i);
+    __m256 z = _mm256_loadu_ps(boxes.z.data() + i);
+    __m256 halfWidthX = _mm256_loadu_ps(boxes.halfWidthX.data() + i);
+    __m256 halfWidthY = _mm256_loadu_ps(boxes.halfWidthY.data() + i);
+    __m256 halfWidthZ = _mm256_loadu_ps(boxes.halfWidthZ.data() + i);
+    __m256 outside = _mm256_setzero_ps();
+    for (unsigned int p = 0; p < 6; ++p)
+    {
+        __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.absA[p]), halfWidthX),
+                                                    _mm256_mul_ps(_mm256_set1_ps(planes.absB[p]), halfWidthY)),
+                                      _mm256_mul_ps(_mm256_set1_ps(planes.absC[p]), halfWidthZ));
+        __m256 distance = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.a[p]), x), _mm256_mul_ps(_mm256_set1_ps(planes.b[p]), y)),
+            _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.c[p]), z), _mm256_set1_ps(planes.d[p])));
+        outside = _mm256_or_ps(outside,
+                               _mm256_cmp_ps(distance, _mm256_sub_ps(_mm256_setzero_ps(), radius), _CMP_LT_OQ));
+    }
+    return ~(unsigned int)_mm256_movemask_ps(outside) & 0xFFu;
+}
+#elif defined(KERN_CULLING_SSE2)
+static unsigned int testSphereBlock(const SPlanes &planes, const SSphereArray &spheres, std::size_t i)
+{
+    __m128 x = _mm_loadu_ps(spheres.x.data() + i);
+    __m128 y = _mm_loadu_ps(spheres.y.data() + i);
+    __m128 z = _mm_loadu_ps(spheres.z.data() + i);
+    __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius.data() + i));
+    __m128 outside = _mm_setzero_ps();
+    for (unsigned int p = 0; p < 6; ++p)
+    {
+        __m128 distance =
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.a[p]), x), _mm_mul_ps(_mm_set1_ps(planes.b[p]), y)),
+                       _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.c[p]), z), _mm_set1_ps(planes.d[p])));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+    }
+    return ~(unsigned int)_mm_movemask_ps(outside) & 0xFu;
+}
+
+static unsigned int testSphereOverlapBlock(const SSphere &sphere, const SSphereArray &spheres, std::size_t i)
+{
+    __m128 dx = _mm_sub_ps(_mm_loadu_ps(spheres.x.data() + i), _mm_set1_ps(sphere.x));
+    __m128 dy = _mm_sub_ps(_mm_loadu_ps(spheres.y.data() + i), _mm_set1_ps(sphere.y));
+    __m128 dz = _mm_sub_ps(_mm_loadu_ps(spheres.z.data() + i), _mm_set1_ps(sphere.z));
+    __m128 radius = _mm_add_ps(_mm_loadu_ps(spheres.radius.data() + i), _mm_set1_ps(sphere.radius));
+    __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+    return (unsigned int)_mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(radius, radius)));
+}
+
+static unsigned int testBoxBlock(const SPlanes &planes, const SBoxArray &boxes, std::size_t i)
+{
+    __m128 x = _mm_loadu_ps(boxes.x.data() + i);
+    __m128 y = _mm_loadu_ps(boxes.y.data() + i);
+    __m128 z = _mm_loadu_ps(boxes.z.data() + i);
+    __m128 halfWidthX = _mm_loadu_ps(boxes.halfWidthX.data() + i);
+    __m128 halfWidthY = _mm_loadu_ps(boxes.halfWidthY.data() + i);
+    __m128 halfWidthZ = _mm_loadu_ps(boxes.halfWidthZ.data() + i);
+    __m128 outside = _mm_setzero_ps();
+    for (unsigned int p = 0; p < 6; ++p)
+    {
+        __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.absA[p]), halfWidthX),
+                                              _mm_mul_ps(_mm_set1_ps(planes.absB[p]), halfWidthY)),
+                                   _mm_mul_ps(_mm_set1_ps(planes.absC[p]), halfWidthZ));
+        __m128 distance =
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.a[p]), x), _mm_mul_ps(_mm_set1_ps(planes.b[p]), y)),
+                       _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.c[p]), z), _mm_set1_ps(planes.d[p])));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_sub_ps(_mm_setzero_ps(), radius)));
+    }
+    return ~(unsigned int)_mm_movemask_ps(outside) & 0xFu;
+}
+#else
+static unsigned int testSphereBlock(const SPlanes &planes, const SSphereArray &spheres, std::size_t i)
+{
+    return isSphereVisible(planes, spheres, i) ? 1u : 0u;
+}
+
+static unsigned int testSphereOverlapBlock(const SSphere &sphere, const SSphereArray &spheres, std::size_t i)
+{
+    return isSphereOverlapping(sphere, spheres, i) ? 1u : 0u;
+}
+
+static unsigned int testBoxBlock(const SPlanes &planes, const SBoxArray &boxes, std::size_t i)
+{
+    return isBoxVisible(planes, boxes, i) ? 1u : 0u;
+}
+#endif
+
+// Full blocks with the block test, the remainder one by one
+template <typename TBlock, typename TSingle>
+static std::size_t cullToMask(std::size_t count, TBlock testBlock, TSingle testSingle, std::uint32_t *mask)
+{
+    std::fill(mask, mask + getCullingMaskSize(count), 0u);
+    std::size_t visibleCount = 0;
+    std::size_t i = 0;
+    for (; i + blockSize <= count; i += blockSize)
+    {
+        // Blocks never straddle mask words, the block size divides 32
+        unsigned int bits = testBlock(i);
+        mask[i / 32] |= bits << (i % 32);
+        visibleCount += std::bitset<32>(bits).count();
+    }
+    for (; i < count; ++i)
+    {
+        if (testSingle(i))
+        {
+            mask[i / 32] |= 1u << (i % 32);
+            ++visibleCount;
+        }
+    }
+    return visibleCount;
+}
+
+template <typename TBlock, typename TSingle>
+static std::size_t cullToIndices(std::size_t count, TBlock testBlock, TSingle testSingle, unsigned int *visible)
+{
+    std::size_t visibleCount = 0;
+    std::size_t i = 0;
+    for (; i + blockSize <= count; i += blockSize)
+    {
+        unsigned int bits = testBlock(i);
+        for (unsigned int lane = 0; bits != 0; ++lane, bits >>= 1)
+        {
+            if ((bits & 1u) != 0)
+            {
+                visible[visibleCount++] = (unsigned int)(i + lane);
+            }
+        }
+    }
+    for (; i < count; ++i)
+    {
+        if (testSingle(i))
+        {
+            visible[visibleCount++] = (unsigned int)i;
+        }
+    }
+    return visibleCount;
+}
+SCullingView::SCullingView(const Frustum &frustum) : isSphere(false), frustum(frustum) {}
+
+SCullingView::SCullingView(const glm::mat4 &view, const glm::mat4 &projection)
+    : isCamera(true), viewProjection(projection * view)
+{
+    frustum.setFromViewProjectionClipSpaceApproach(view, projection);
+}
+
+SCullingView::SCullingView(const BoundingSphere &sphere) : isSphere(true), sphere(sphere) {}
+
+void SSphereArray::resize(std::size_t count)
+{
+    x.resize(count, 0.f);
+    y.resize(count, 0.f);
+    z.resize(count, 0.f);
+    radius.resize(count, 0.f);
+}
+
+void SSphereArray::set(std::size_t index, const BoundingSphere &sphere)
+{
+    x[index] = sphere.getPosition().x;
+    y[index] = sphere.getPosition().y;
+    z[index] = sphere.getPosition().z;
+    radius[index] = sphere.getRadius();
+}
+
+std::size_t SSphereArray::size() const { return x.size(); }
+
+void SBoxArray::resize(std::size_t count)
+{
+    x.resize(count, 0.f);
+    y.resize(count, 0.f);
+    z.resize(count, 0.f);
+    halfWidthX.resize(count, 0.f);
+    halfWidthY.resize(count, 0.f);
+    halfWidthZ.resize(count, 0.f);
+}
+
+void SBoxArray::set(std::size_t index, const AABBox &box)
+{
+    x[index] = box.getMid().x;
+    y[index] = box.getMid().y;
+    z[index] = box.getMid().z;
+    halfWidthX[index] = box.getHalfWidths().x;
+    halfWidthY[index] = box.getHalfWidths().y;
+    halfWidthZ[index] = box.getHalfWidths().z;
+}
+
+std::size_t SBoxArray::size() const { return x.size(); }
+
+std::size_t getCullingMaskSize(std::size_t count) { return (count + 31) / 32; }
+
+std::size_t cullSpheres(const Frustum &frustum, const SSphereArray &spheres, std::uint32_t *mask)
+{
+    SPlanes planes = getPlanes(frustum);
+    return cullToMask(
+        spheres.size(), [&](std::size_t i) { return testSphereBlock(planes, spheres, i); },
+        [&](std::size_t i) { return isSphereVisible(planes, spheres, i); }, mask);
+}
+
+std::size_t getVisibleSpheres(const Frustum &frustum, const SSphereArray &spheres, unsigned int *visible)
+{
+    SPlanes planes = getPlanes(frustum);
+    return cullToIndices(
+        spheres.size(), [&](std::size_t i) { return testSphereBlock(planes, spheres, i); },
+        [&](std::size_t i) { return isSphereVisible(planes, spheres, i); }, visible);
+}
+
+std::size_t cullBoxes(const Frustum &frustum, const SBoxArray &boxes, std::uint32_t *mask)
+{
+    SPlanes planes = getPlanes(frustum);
+    return cullToMask(
+        boxes.size(), [&](std::size_t i) { return testBoxBlock(planes, boxes, i); },
+        [&](std::size_t i) { return isBoxVisible(planes, boxes, i); }, mask);
+}
+
+std::size_t getVisibleBoxes(const Frustum &frustum, const SBoxArray &boxes, unsigned int *visible)
+{
+    SPlanes planes = getPlanes(frustum);
+    return cullToIndices(
+        boxes.size(), [&](std::size_t i) { return testBoxBlock(planes, boxes, i); },
+        [&](std::size_t i) { return isBoxVisible(planes, boxes, i); }, visible);
+}
+
+void getViewMasks(const SCullingView *views, std::size_t viewCount, const SSphereArray &spheres,
+                  std::uint32_t *masks)
+{
+    assert(viewCount <= maxCullingViewCount && "Too many culling views");
+    viewCount = std::min(viewCount, maxCullingViewCount);
+
+    SView prepared[maxCullingViewCount];
+    for (std::size_t v = 0; v < viewCount; ++v)
+    {
+        prepared[v].isSphere = views[v].isSphere;
+        if (views[v].isSphere)
+        {
+            const glm::vec3 &position = views[v].sphere.getPosition();
+            prepared[v].sphere = {position.x, position.y, position.z, views[v].sphere.getRadius()};
+        }
+        else
+        {
+            prepared[v].planes = getPlanes(views[v].frustum);
+        }
+    }
+
+    // All views per block while the block is in registers and cache
+    std::size_t count = spheres.size();
+    std::size_t i = 0;
+    for (; i + blockSize <= count; i += blockSize)
+    {
+        std::uint32_t blockMasks[blockSize] = {};
+        for (std::size_t v = 0; v < viewCount; ++v)
+        {
+            unsigned int bits = prepared[v].isSphere ? testSphereOverlapBlock(prepared[v].sphere, spheres, i)
+                                                     : testSphereBlock(prepared[v].planes, spheres, i);
+            for (unsigned int lane = 0; bits != 0; ++lane, bits >>= 1)
+            {
+                blockMasks[lane] |= (bits & 1u) << v;
+            }
+        }
+        std::copy(blockMasks, blockMasks + blockSize, masks + i);
+    }
+    for (; i < count; ++i)
+    {
+        std::uint32_t mask = 0;
+        for (std::size_t v = 0; v < viewCount; ++v)
+        {
+            bool visible = prepared[v].isSphere ? isSphereOverlapping(prepared[v].sphere, spheres, i)
+                                                : isSphereVisible(prepared[v].planes, spheres, i);
+            mask |= (visible ? 1u : 0u) << v;
+        }
+        masks[i] = mask;
+    }
+}
+
+const char *getCullingInstructionSet()
+{
+#if defined(KERN_CULLING_AVX2)
+    return "avx2";
+#elif defined(KERN_CULLING_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,321 @@
+#include "kern/graphics/collision/OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "kern/foundation/JobSystem.h"
+
+// Four pixels per step on SSE2 targets
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KERN_OCCLUSION_SSE2
+#include <emmintrin.h>
+#endif
+
+// Tiles are rasterized by one job each, blocks store the hierarchical depth
+const unsigned int tileSize = 32;
+const unsigned int blockSize = 8;
+
+// Vertices closer to the camera plane are treated as crossing the near plane
+const float minClipW = 1e-5f;
+
+static glm::vec3 toScreen(const glm::vec4 &clip, unsigned int width, unsigned int height)
+{
+    return glm::vec3((clip.x / clip.w * 0.5f + 0.5f) * (float)width, (clip.y / clip.w * 0.5f + 0.5f) * (float)height,
+                     clip.z / clip.w * 0.5f + 0.5f);
+}
+
+static bool isOutside(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c)
+{
+    // All vertices outside of the same clip plane
+    return (a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+           (a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w) ||
+           (a.z > a.w && b.z > b.w && c.z > c.w);
+}
+
+OcclusionBuffer::OcclusionBuffer(JobSystem &jobs, unsigned int width, unsigned int height)
+    : m_width(std::max(1u, (width + tileSize - 1) / tileSize) * tileSize),
+      m_height(std::max(1u, (height + tileSize - 1) / tileSize) * tileSize),
+      m_tilesX(m_width / tileSize),
+      m_tilesY(m_height / tileSize),
+      m_viewProjection(1.f),
+      m_depth(m_width * m_height, 1.f),
+      m_hierarchicalDepth((m_width / blockSize) * (m_height / blockSize), 1.f),
+      m_bins(m_tilesX * m_tilesY),
+      m_jobs(jobs)
+{
+}
+
+void OcclusionBuffer::begin(const glm::mat4 &viewProjection)
+{
+    m_viewProjection = viewProjection;
+    std::fill(m_depth.begin(), m_depth.end(), 1.f);
+    std::fill(m_hierarchicalDepth.begin(), m_hierarchicalDepth.end(), 1.f);
+    m_triangles.clear();
+    for (auto &bin : m_bins)
+    {
+        bin.clear();
+    }
+}
+
+void OcclusionBuffer::addOccluder(const glm::mat4 &model, const std::vector<float> &vertices,
+                                  const std::vector<unsigned int> &indices)
+{
+    glm::mat4 modelViewProjection = m_viewProjection * model;
+    std::vector<glm::vec4> clip(vertices.size() / 3);
+    for (std::size_t i = 0; i < clip.size(); ++i)
+    {
+        clip[i] = modelViewProjection * glm::vec4(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2], 1.f);
+    }
+
+    std::size_t count = indices.empty() ? clip.size() : indices.size();
+    for (std::size_t i = 0; i + 2 < count; i += 3)
+    {
+        std::size_t index[3] = {i, i + 1, i + 2};
+        if (!indices.empty())
+        {
+            index[0] = indices[i];
+            index[1] = indices[i + 1];
+            index[2] = indices[i + 2];
+        }
+        if (index[0] >= clip.size() || index[1] >= clip.size() || index[2] >= clip.size())
+        {
+            continue;
+        }
+        const glm::vec4 &a = clip[index[0]];
+        const glm::vec4 &b = clip[index[1]];
+        const glm::vec4 &c = clip[index[2]];
+        if (isOutside(a, b, c))
+        {
+            continue;
+        }
+        // Not clipped, dropping triangles only removes occlusion
+        if (a.w < minClipW || b.w < minClipW || c.w < minClipW || a.z < -a.w || b.z < -b.w || c.z < -c.w)
+        {
+            continue;
+        }
+
+        glm::vec3 v0 = toScreen(a, m_width, m_height);
+        glm::vec3 v1 = toScreen(b, m_width, m_height);
+        glm::vec3 v2 = toScreen(c, m_width, m_height);
+        float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+        if (std::abs(area) < 1e-6f)
+        {
+            continue;
+        }
+        // Counter-clockwise order, both faces are rasterized
+        if (area < 0.f)
+        {
+            std::swap(v1, v2);
+            area = -area;
+        }
+
+        STriangle triangle;
+        triangle.x[0] = v0.x;
+        triangle.x[1] = v1.x;
+        triangle.x[2] = v2.x;
+        triangle.y[0] = v0.y;
+        triangle.y[1] = v1.y;
+        triangle.y[2] = v2.y;
+        triangle.dzdx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+        triangle.dzdy = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+        triangle.z = v0.z - triangle.dzdx * v0.x - triangle.dzdy * v0.y;
+        triangle.maxZ = std::max(v0.z, std::max(v1.z, v2.z));
+
+        // Bin into all tiles overlapped by the bounds
+        float minX = std::max(0.f, std::floor(std::min(v0.x, std::min(v1.x, v2.x))));
+        float minY = std::max(0.f, std::floor(std::min(v0.y, std::min(v1.y, v2.y))));
+        float maxX = std::min((float)m_width, std::ceil(std::max(v0.x, std::max(v1.x, v2.x))));
+        float maxY = std::min((float)m_height, std::ceil(std::max(v0.y, std::max(v1.y, v2.y))));
+        if (minX >= maxX || minY >= maxY)
+        {
+            continue;
+        }
+        unsigned int triangleIndex = (unsigned int)m_triangles.size();
+        m_triangles.push_back(triangle);
+        for (unsigned int ty = (unsigned int)minY / tileSize; ty <= ((unsigned int)maxY - 1) / tileSize; ++ty)
+        {
+            for (unsigned int tx = (unsigned int)minX / tileSize; tx <= ((unsigned int)maxX - 1) / tileSize; ++tx)
+            {
+                m_bins[ty * m_tilesX + tx].push_back(triangleIndex);
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::rasterize()
+{
+    m_jobs.parallelFor(m_bins.size(), 1, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t tile = begin; tile < end; ++tile)
+        {
+            rasterizeTile(tile);
+        }
+    });
+}
+
+bool OcclusionBuffer::isVisible(const BoundingSphere &sphere) const
+{
+    // Screen bounds and nearest depth of the corners of the bounding box of the sphere
+    const glm::vec3 &center = sphere.getPosition();
+    float radius = sphere.getRadius();
+    glm::vec3 minimum(std::numeric_limits<float>::max());
+    glm::vec3 maximum(-std::numeric_limits<float>::max());
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+        glm::vec3 direction((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : -1.f);
+        glm::vec4 clip = m_viewProjection * glm::vec4(center + radius * direction, 1.f);
+        if (clip.w < minClipW || clip.z < -clip.w)
+        {
+            return true;
+        }
+        glm::vec3 screen = toScreen(clip, m_width, m_height);
+        minimum = glm::min(minimum, screen);
+        maximum = glm::max(maximum, screen);
+    }
+
+    // Pixels touched by the bounds, on screen only
+    int x0 = std::max(0, (int)std::floor(minimum.x));
+    int y0 = std::max(0, (int)std::floor(minimum.y));
+    int x1 = std::min((int)m_width - 1, (int)std::floor(maximum.x));
+    int y1 = std::min((int)m_height - 1, (int)std::floor(maximum.y));
+    if (x0 > x1 || y0 > y1)
+    {
+        return true;
+    }
+
+    unsigned int blocksX = m_width / blockSize;
+    for (int by = y0 / (int)blockSize; by <= y1 / (int)blockSize; ++by)
+    {
+        for (int bx = x0 / (int)blockSize; bx <= x1 / (int)blockSize; ++bx)
+        {
+            // Whole block in front of the sphere
+            if (m_hierarchicalDepth[by * blocksX + bx] < minimum.z)
+            {
+                continue;
+            }
+            for (int y = std::max(y0, by * (int)blockSize); y <= std::min(y1, by * (int)blockSize + 7); ++y)
+            {
+                for (int x = std::max(x0, bx * (int)blockSize); x <= std::min(x1, bx * (int)blockSize + 7); ++x)
+                {
+                    if (m_depth[y * m_width + x] >= minimum.z)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+float OcclusionBuffer::getDepth(unsigned int x, unsigned int y) const { return m_depth[y * m_width + x]; }
+
+std::size_t OcclusionBuffer::getTriangleCount() const { return m_triangles.size(); }
+
+unsigned int OcclusionBuffer::getWidth() const { return m_width; }
+
+unsigned int OcclusionBuffer::getHeight() const { return m_height; }
+
+void OcclusionBuffer::rasterizeTile(std::size_t tile)
+{
+    const auto &bin = m_bins[tile];
+    if (bin.empty())
+    {
+        return;
+    }
+    unsigned int x0 = (unsigned int)(tile % m_tilesX) * tileSize;
+    unsigned int y0 = (unsigned int)(tile / m_tilesX) * tileSize;
+    for (unsigned int index : bin)
+    {
+        rasterizeTriangle(m_triangles[index], x0, y0, x0 + tileSize, y0 + tileSize);
+    }
+
+    // Farthest depth per block of the tile
+    unsigned int blocksX = m_width / blockSize;
+    for (unsigned int by = y0; by < y0 + tileSize; by += blockSize)
+    {
+        for (unsigned int bx = x0; bx < x0 + tileSize; bx += blockSize)
+        {
+            float depth = 0.f;
+            for (unsigned int y = by; y < by + blockSize; ++y)
+            {
+                const float *row = m_depth.data() + y * m_width + bx;
+                depth = std::max(depth, *std::max_element(row, row + blockSize));
+            }
+            m_hierarchicalDepth[(by / blockSize) * blocksX + bx / blockSize] = depth;
+        }
+    }
+}
+
+void OcclusionBuffer::rasterizeTriangle(const STriangle &triangle, unsigned int x0, unsigned int y0,
+                                        unsigned int x1, unsigned int y1)
+{
+    // Edge functions a * x + b * y + c evaluated at pixel centers, pixels on shared edges are covered by both
+    // triangles to not leave holes inside meshes
+    float a[3];
+    float b[3];
+    float c[3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        unsigned int j = (i + 1) % 3;
+        a[i] = triangle.y[i] - triangle.y[j];
+        b[i] = triangle.x[j] - triangle.x[i];
+        c[i] = -(a[i] * triangle.x[i] + b[i] * triangle.y[i]);
+    }
+    // Farthest depth within a pixel
+    float depthOffset = 0.5f * (std::abs(triangle.dzdx) + std::abs(triangle.dzdy));
+
+    // Pixel range of the triangle inside the rectangle, x aligned to four pixel groups
+    float minX = std::min(triangle.x[0], std::min(triangle.x[1], triangle.x[2]));
+    float minY = std::min(triangle.y[0], std::min(triangle.y[1], triangle.y[2]));
+    float maxX = std::max(triangle.x[0], std::max(triangle.x[1], triangle.x[2]));
+    float maxY = std::max(triangle.y[0], std::max(triangle.y[1], triangle.y[2]));
+    unsigned int startX = std::max(x0, (unsigned int)std::max(0.f, std::floor(minX))) & ~3u;
+    unsigned int startY = std::max(y0, (unsigned int)std::max(0.f, std::floor(minY)));
+    unsigned int endX = std::min(x1, (unsigned int)std::max(0.f, std::ceil(maxX)));
+    unsigned int endY = std::min(y1, (unsigned int)std::max(0.f, std::ceil(maxY)));
+
+    for (unsigned int y = startY; y < endY; ++y)
+    {
+        float centerY = (float)y + 0.5f;
+        float *row = m_depth.data() + y * m_width;
+#if defined(KERN_OCCLUSION_SSE2)
+        __m128 rowEdge0 = _mm_set1_ps(b[0] * centerY + c[0]);
+        __m128 rowEdge1 = _mm_set1_ps(b[1] * centerY + c[1]);
+        __m128 rowEdge2 = _mm_set1_ps(b[2] * centerY + c[2]);
+        __m128 rowDepth = _mm_set1_ps(triangle.dzdy * centerY + triangle.z + depthOffset);
+        __m128 maxDepth = _mm_set1_ps(triangle.maxZ);
+        __m128 zero = _mm_setzero_ps();
+        for (unsigned int x = startX; x < endX; x += 4)
+        {
+            __m128 centerX = _mm_add_ps(_mm_set1_ps((float)x), _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f));
+            __m128 edge0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), centerX), rowEdge0);
+            __m128 edge1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[1]), centerX), rowEdge1);
+            __m128 edge2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[2]), centerX), rowEdge2);
+            __m128 covered = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)),
+                                        _mm_cmpge_ps(edge2, zero));
+            if (_mm_movemask_ps(covered) == 0)
+            {
+                continue;
+            }
+            __m128 depth =
+                _mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.dzdx), centerX), rowDepth), maxDepth);
+            __m128 old = _mm_loadu_ps(row + x);
+            __m128 closer = _mm_min_ps(old, depth);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(covered, closer), _mm_andnot_ps(covered, old)));
+        }
+#else
+        for (unsigned int x = startX; x < endX; ++x)
+        {
+            float centerX = (float)x + 0.5f;
+            if (a[0] * centerX + b[0] * centerY + c[0] >= 0.f && a[1] * centerX + b[1] * centerY + c[1] >= 0.f &&
+                a[2] * centerX + b[2] * centerY + c[2] >= 0.f)
+            {
+                float depth = std::min(triangle.z + triangle.dzdx * centerX + triangle.dzdy * centerY + depthOffset,
+                                       triangle.maxZ);
+                row[x] = std::min(row[x], depth);
+            }
+        }
+#endif
+    }
+}
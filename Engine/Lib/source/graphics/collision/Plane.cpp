@@ -38,4 +38,6 @@ void Plane::setCoefficients(float a, float b, float c, float d)
     m_d = d / length;
 }
 
-float Plane::distance(const glm::vec3 &p) const { return m_d + glm::dot(m_normal, p); }
\ No newline at end of file
+float Plane::distance(const glm::vec3 &p) const { return m_d + glm::dot(m_normal, p); }
+
+glm::vec4 Plane::getCoefficients() const { return glm::vec4(m_normal, m_d); }
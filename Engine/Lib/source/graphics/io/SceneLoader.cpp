@@ -3,6 +3,7 @@
 #include <fmtlog/fmtlog.h>
 
 #include <fstream>
+#include <vector>
 #include <glm/glm.hpp>
 #include <nlohmann/json.hpp>
 
@@ -137,6 +138,30 @@ bool SceneLoader::loadSceneObject(const nlohmann::json &node, IScene &scene, Ani
     // Create object in scene
     SceneObjectId objectId = scene.createObject(meshId, materialId, position, glm::quat(rotation), scale);
 
+    // Load optional occluder, a simplified mesh inside the object for occlusion culling
+    if (node.find("occluder") != node.end())
+    {
+        std::string occluder;
+        if (!::load(node, "occluder", occluder))
+        {
+            return false;
+        }
+
+        ResourceId occluderId = m_resourceManager.loadMesh(occluder);
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<float> normals;
+        std::vector<float> uvs;
+        PrimitiveType type = PrimitiveType::Invalid;
+        if (occluderId == -1 || !m_resourceManager.getMesh(occluderId, vertices, indices, normals, uvs, type) ||
+            type != PrimitiveType::Triangle)
+        {
+            loge("Failed to load occluder mesh file {}.", occluder.c_str());
+            return false;
+        }
+        scene.setOccluder(objectId, vertices, indices);
+    }
+
     // Load optional animation controllers
     if (node.find("animations") != node.end())
     {
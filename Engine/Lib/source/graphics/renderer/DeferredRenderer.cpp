@@ -2,25 +2,59 @@
 
 #include <fmtlog/fmtlog.h>
 
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
+#include <functional>
 #include <glm/ext.hpp>
 #include <string>
 
+#include "kern/foundation/MemoryReport.h"
 #include "kern/graphics/ICamera.h"
 #include "kern/graphics/IGraphicsResourceManager.h"
 #include "kern/graphics/IScene.h"
 #include "kern/graphics/Window.h"
 #include "kern/graphics/camera/StaticCamera.h"
+#include "kern/graphics/collision/FrustumCulling.h"
 #include "kern/graphics/renderer/Draw.h"
 #include "kern/graphics/renderer/RenderBuffer.h"
 #include "kern/graphics/renderer/RendererCoreConfig.h"
+#include "kern/graphics/renderer/RenderStats.h"
 #include "kern/graphics/resource/Material.h"
 #include "kern/graphics/resource/Mesh.h"
 #include "kern/graphics/resource/ShaderProgram.h"
 #include "kern/graphics/resource/Texture.h"
+#include "kern/graphics/resource/TextureArray.h"
+#include "kern/graphics/resource/TextureStreamer.h"
 #include "kern/graphics/scene/SceneQuery.h"
 #include "kern/resource/IResourceManager.h"
 
+// Material textures in texture unit order, missing textures are replaced by the defaults
+static void getMaterialTextures(const Material &material, const IGraphicsResourceManager &manager,
+                                const Texture *textures[5])
+{
+    textures[0] = material.hasDiffuse() ? material.getDiffuse() : manager.getDefaultDiffuseTexture();
+    textures[1] = material.hasNormal() ? material.getNormal() : manager.getDefaultNormalTexture();
+    textures[2] = material.hasSpecular() ? material.getSpecular() : manager.getDefaultSpecularTexture();
+    textures[3] = material.hasGlow() ? material.getGlow() : manager.getDefaultGlowTexture();
+    textures[4] = material.hasAlpha() ? material.getAlpha() : manager.getDefaultAlphaTexture();
+}
+
+// Far plane of the point light shadow projection relative to the light radius
+const float shadowCubeFarScale = 1.5f;
+
+static glm::mat4 getShadowMapView(const glm::vec3 &direction)
+{
+    return glm::lookAt(glm::vec3(0), glm::normalize(direction), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+static glm::mat4 getShadowMapProjection() { return glm::ortho(-150.0f, 150.0f, -150.0f, 150.0f, -250.0f, 150.0f); }
+
+static bool isPacked(const Texture *const textures[5])
+{
+    return std::all_of(textures, textures + 5, [](const Texture *texture) { return texture->getArray() != nullptr; });
+}
+
 DeferredRenderer::DeferredRenderer() { return; }
 
 DeferredRenderer::~DeferredRenderer() { return; }
@@ -107,15 +141,78 @@ void DeferredRenderer::draw(const IScene &scene, const ICamera &camera, const Wi
     // Draw init
     window.setActive();
 
-    // Query visible scene objects and lights
-    SceneQuery query;
-    scene.getVisibleObjects(camera, query);
+    // Temporaries of the last frame are no longer used
+    m_frameArena.reset();
+
+    // Query visible lights first, the objects of the camera and of all shadow views are culled in one traversal
+    SceneQuery lights(m_frameArena);
+    scene.getVisibleLights(camera, lights);
+
+    // The camera view is also occlusion culled
+    ArenaVector<SCullingView> views(&m_frameArena);
+    views.push_back(SCullingView(camera.getView(), camera.getProjection()));
+
+    // Lights with valid data are added to the frame query, followed by their shadow views in the same order
+    SceneQuery query(m_frameArena);
+    std::size_t pointLightCount = 0;
+    while (lights.hasNextPointLight())
+    {
+        SceneObjectId id = lights.getNextPointLight();
+        glm::vec3 position;
+        glm::vec3 color;
+        float intensity;
+        float radius;
+        bool castsShadow;
+        if (!scene.getPointLight(id, position, radius, color, intensity, castsShadow))
+        {
+            loge("Failed to retrieve point light data from point light id {}.", id);
+            continue;
+        }
+        query.addPointLight(id);
+        // All cube faces together see a sphere up to the far plane of the shadow projection
+        views.push_back(SCullingView(BoundingSphere(position, radius * shadowCubeFarScale)));
+        ++pointLightCount;
+    }
+    while (lights.hasNextDirectionalLight())
+    {
+        SceneObjectId id = lights.getNextDirectionalLight();
+        glm::vec3 direction;
+        glm::vec3 color;
+        float intensity;
+        bool castsShadow;
+        if (!scene.getDirectionalLight(id, direction, color, intensity, castsShadow))
+        {
+            loge("Failed to retrieve directional light data from directional light id {}.", id);
+            continue;
+        }
+        query.addDirectionalLight(id);
+        Frustum shadowFrustum;
+        shadowFrustum.setFromViewProjectionClipSpaceApproach(getShadowMapView(direction), getShadowMapProjection());
+        views.push_back(SCullingView(shadowFrustum));
+    }
+
+    // Query storage must not move after the pointers are taken
+    ArenaVector<SceneQuery> shadowQueries(&m_frameArena);
+    shadowQueries.reserve(views.size() - 1);
+    ArenaVector<ISceneQuery *> queries(&m_frameArena);
+    queries.push_back(&query);
+    for (std::size_t i = 1; i < views.size(); ++i)
+    {
+        shadowQueries.emplace_back(m_frameArena, 200, 0);
+        queries.push_back(&shadowQueries.back());
+    }
+    // Hackyyy
+    camera.getFeatureInfo().culledObjectCount = scene.getVisibleObjects(views.data(), views.size(), queries.data());
+
+    SShadowQueries shadows;
+    shadows.pointLights = shadowQueries.data();
+    shadows.directionalLights = shadowQueries.data() + pointLightCount;
 
     // Geometry pass fills gbuffer
     geometryPass(scene, camera, window, manager, query);
 
     // Light pass fills lbuffer
-    lightPass(scene, camera, window, manager, query);
+    lightPass(scene, camera, window, manager, query, shadows);
 
     // Illumination pass renders lit scene from lbuffer and gbuffer
     illuminationPass(scene, camera, window, manager, query);
@@ -149,6 +246,35 @@ void DeferredRenderer::draw(const IScene &scene, const ICamera &camera, const Wi
     }
 }
 
+void DeferredRenderer::reportMemory(MemoryReport &report) const
+{
+    const FrameBuffer *frameBuffers[] = {&m_geometryBuffer,
+                                         &m_shadowMapBuffer,
+                                         &m_shadowCubeBuffer,
+                                         &m_lightPassFrameBuffer,
+                                         &m_illumationPassFrameBuffer,
+                                         &m_postProcessPassFrameBuffer0,
+                                         &m_postProcessPassFrameBuffer1,
+                                         &m_postProcessPassFrameBuffer2};
+    std::size_t size = 0;
+    for (const FrameBuffer *frameBuffer : frameBuffers)
+    {
+        size += frameBuffer->getGpuSize();
+    }
+
+    // Shadow cube faces are attached with plain GL calls, the cube map has six R32F faces
+    if (m_shadowCubeDepthTexture != nullptr)
+    {
+        size += m_shadowCubeDepthTexture->getGpuSize();
+    }
+    if (m_shadowCubeTexture != nullptr)
+    {
+        size += 6 * (std::size_t)m_shadowCubeTexture->getLevelWidth(0) * m_shadowCubeTexture->getLevelHeight(0) *
+                Texture::getPixelSize(GL_R32F);
+    }
+    report.add("renderer/frameBuffer", sizeof(frameBuffers) / sizeof(frameBuffers[0]), 0, size);
+}
+
 DeferredRenderer *DeferredRenderer::create(IResourceManager &manager)
 {
     DeferredRenderer *renderer = new DeferredRenderer;
@@ -186,6 +312,13 @@ void DeferredRenderer::geometryPass(const IScene &scene, const ICamera &camera,
         return;
     }
 
+    // Optional, packed materials use the regular shader through their texture views without it
+    ShaderProgram *geometryPassArrayShader = nullptr;
+    if (m_geometryPassArrayShaderId != InvalidResource)
+    {
+        geometryPassArrayShader = manager.getShaderProgram(m_geometryPassArrayShaderId);
+    }
+
     // Depth
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
@@ -235,23 +368,52 @@ void DeferredRenderer::geometryPass(const IScene &scene, const ICamera &camera,
             Mesh *mesh = manager.getMesh(meshId);
             Material *material = manager.getMaterial(materialId);
 
+            // Texture streaming feedback
+            material->requestScreenSize(
+                getProjectedSize(mesh->getBoundingSphere(), position, rotation, scale, camera, window.getHeight()));
+
             // Set transformations
             m_transformer.setPosition(position);
             m_transformer.setRotation(rotation);
             m_transformer.setScale(scale);
 
+            // Packed materials are drawn after all other objects, grouped by texture arrays
+            if (geometryPassArrayShader != nullptr && material->isPacked())
+            {
+                SPackedDraw packedDraw;
+                packedDraw.mesh = mesh;
+                getMaterialTextures(*material, manager, packedDraw.textures);
+                if (isPacked(packedDraw.textures))
+                {
+                    packedDraw.rotation = m_transformer.getRotationMatrix();
+                    packedDraw.model = m_transformer.getTranslationMatrix() * m_transformer.getRotationMatrix() *
+                                       m_transformer.getScaleMatrix();
+                    m_packedDraws.push_back(packedDraw);
+                    continue;
+                }
+            }
+
             // Forward draw call
             draw(mesh, m_transformer.getTranslationMatrix(), m_transformer.getRotationMatrix(),
                  m_transformer.getScaleMatrix(), material, manager, geometryPassShader);
         }
     }
 
+    if (!m_packedDraws.empty())
+    {
+        geometryPassArrayShader->setActive();
+        geometryPassArrayShader->setUniform(viewMatrixUniformName, m_transformer.getViewMatrix());
+        geometryPassArrayShader->setUniform(projectionMatrixUniformName, m_transformer.getProjectionMatrix());
+        drawPacked(geometryPassArrayShader);
+        m_packedDraws.clear();
+    }
+
     // Disable geometry buffer
     m_geometryBuffer.setInactive(GL_FRAMEBUFFER);
 }
 
 void DeferredRenderer::shadowMapPass(const IScene &scene, const ICamera &camera, const Window &window,
-                                     const IGraphicsResourceManager &manager)
+                                     const IGraphicsResourceManager &manager, ISceneQuery &query)
 {
     ShaderProgram *shadowMapPassShader = manager.getShaderProgram(m_shadowMapPassShaderId);
 
@@ -284,10 +446,6 @@ void DeferredRenderer::shadowMapPass(const IScene &scene, const ICamera &camera,
     transformer.setViewMatrix(camera.getView());
     transformer.setProjectionMatrix(camera.getProjection());
 
-    // Query visible scene objects
-    SceneQuery query;
-    scene.getVisibleObjects(camera, query);
-
     // Send view/projection to default shader
     shadowMapPassShader->setUniform(viewMatrixUniformName, transformer.getViewMatrix());
     shadowMapPassShader->setUniform(projectionMatrixUniformName, transformer.getProjectionMatrix());
@@ -351,7 +509,7 @@ CameraDirection g_cameraDirections[6] = {
     {GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, -1.0f, 0.0f)}};
 
 void DeferredRenderer::shadowCubePass(const IScene &scene, const ICamera &camera, const Window &window,
-                                      const IGraphicsResourceManager &manager)
+                                      const IGraphicsResourceManager &manager, ISceneQuery &query)
 {
     ShaderProgram *shadowCubePassShader = manager.getShaderProgram(m_shadowCubePassShaderId);
     shadowCubePassShader->setActive();
@@ -377,9 +535,17 @@ void DeferredRenderer::shadowCubePass(const IScene &scene, const ICamera &camera
 
     glClearColor(FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX);
 
+    // All faces draw the objects of the light sphere, the query is only traversed once
+    ArenaVector<SceneObjectId> objects(&m_frameArena);
+    while (query.hasNextObject())
+    {
+        objects.push_back(query.getNextObject());
+    }
+
     for (unsigned int i = 0; i < 6; ++i)
     {
         glBindFramebuffer(GL_FRAMEBUFFER, m_shadowCubeBuffer.getId());
+        ++getRenderStats().frameBufferBinds;
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, g_cameraDirections[i].cubemapFace,
                                m_shadowCubeTexture->getId(), 0);
         glDrawBuffer(GL_COLOR_ATTACHMENT0);
@@ -395,16 +561,9 @@ void DeferredRenderer::shadowCubePass(const IScene &scene, const ICamera &camera
         shadowCubePassShader->setUniform(projectionMatrixUniformName, camera.getProjection());
         shadowCubePassShader->setUniform(viewMatrixUniformName, view);
 
-        // Query visible scene objects
-        SceneQuery query;
-        scene.getVisibleObjects(camera, query);
-
         // Traverse visible objects
-        while (query.hasNextObject())
+        for (SceneObjectId id : objects)
         {
-            // Get next visible object
-            SceneObjectId id = query.getNextObject();
-
             // Object attributes
             ResourceId meshId = -1;
             ResourceId materialId = -1;
@@ -447,7 +606,8 @@ void DeferredRenderer::shadowCubePass(const IScene &scene, const ICamera &camera
 }
 
 void DeferredRenderer::lightPass(const IScene &scene, const ICamera &camera, const Window &window,
-                                 const IGraphicsResourceManager &manager, ISceneQuery &query)
+                                 const IGraphicsResourceManager &manager, ISceneQuery &query,
+                                 const SShadowQueries &shadowQueries)
 {
     // Prepare light pass frame buffer
     glViewport(0, 0, window.getWidth(), window.getHeight());
@@ -472,10 +632,10 @@ void DeferredRenderer::lightPass(const IScene &scene, const ICamera &camera, con
     glBlendFunc(GL_ONE, GL_ONE);
 
     // Draw point light volumes
-    pointLightPass(scene, camera, window, manager, query);
+    pointLightPass(scene, camera, window, manager, query, shadowQueries.pointLights);
 
     // Draw directional lights
-    directionalLightPass(scene, camera, window, manager, query);
+    directionalLightPass(scene, camera, window, manager, query, shadowQueries.directionalLights);
 
     // Reset state and cleanup
     glDisable(GL_BLEND);
@@ -483,7 +643,8 @@ void DeferredRenderer::lightPass(const IScene &scene, const ICamera &camera, con
 }
 
 void DeferredRenderer::pointLightPass(const IScene &scene, const ICamera &camera, const Window &window,
-                                      const IGraphicsResourceManager &manager, ISceneQuery &query)
+                                      const IGraphicsResourceManager &manager, ISceneQuery &query,
+                                      SceneQuery *shadowQueries)
 {
     // Point light pass
     ShaderProgram *pointLightPassShader = manager.getShaderProgram(m_pointLightPassShaderId);
@@ -501,7 +662,7 @@ void DeferredRenderer::pointLightPass(const IScene &scene, const ICamera &camera
     }
 
     // Render point light volumes into light buffer
-    while (query.hasNextPointLight())
+    for (unsigned int lightIndex = 0; query.hasNextPointLight(); ++lightIndex)
     {
         // Retrieve light id
         SceneObjectId pointLightId = query.getNextPointLight();
@@ -523,9 +684,9 @@ void DeferredRenderer::pointLightPass(const IScene &scene, const ICamera &camera
             // wide in this case. 89.54f is determined by testing. 89.53 is already
             // too small and
             // 89.55 too big.
-            glm::mat4 shadowProj = glm::perspective(89.54f, 1.0f, 0.01f, radius * 1.5f);
+            glm::mat4 shadowProj = glm::perspective(89.54f, 1.0f, 0.01f, radius * shadowCubeFarScale);
             StaticCamera shadowCamera(glm::mat4(), shadowProj, position);
-            shadowCubePass(scene, shadowCamera, window, manager);
+            shadowCubePass(scene, shadowCamera, window, manager, shadowQueries[lightIndex]);
 
             // Prepare light pass frame buffer
             glViewport(0, 0, window.getWidth(), window.getHeight());
@@ -552,6 +713,7 @@ void DeferredRenderer::pointLightPass(const IScene &scene, const ICamera &camera
             // Set shadow texture for shadow mapping
             glActiveTexture(GL_TEXTURE0 + lightPassShadowMapTextureUnit);
             glBindTexture(GL_TEXTURE_CUBE_MAP, m_shadowCubeTexture->getId());
+            ++getRenderStats().textureBinds;
             pointLightPassShader->setUniform(shadowCubeTextureUniformName, lightPassShadowMapTextureUnit);
 
             // Set screen size
@@ -589,7 +751,8 @@ void DeferredRenderer::pointLightPass(const IScene &scene, const ICamera &camera
 }
 
 void DeferredRenderer::directionalLightPass(const IScene &scene, const ICamera &camera, const Window &window,
-                                            const IGraphicsResourceManager &manager, ISceneQuery &query)
+                                            const IGraphicsResourceManager &manager, ISceneQuery &query,
+                                            SceneQuery *shadowQueries)
 {
     // Restrieve shader
     ShaderProgram *directionalLightPassShader = manager.getShaderProgram(m_directionalLightPassShaderId);
@@ -608,7 +771,7 @@ void DeferredRenderer::directionalLightPass(const IScene &scene, const ICamera &
     }
 
     // Render point light volumes into light buffer
-    while (query.hasNextDirectionalLight())
+    for (unsigned int lightIndex = 0; query.hasNextDirectionalLight(); ++lightIndex)
     {
         // Retrieve light id
         SceneObjectId directionalLightId = query.getNextDirectionalLight();
@@ -625,12 +788,12 @@ void DeferredRenderer::directionalLightPass(const IScene &scene, const ICamera &
         else
         {
             // Create shadow camera
-            glm::mat4 shadowView = glm::lookAt(glm::vec3(0), glm::normalize(direction), glm::vec3(0.0f, 1.0f, 0.0f));
-            glm::mat4 shadowProj = glm::ortho(-150.0f, 150.0f, -150.0f, 150.0f, -250.0f, 150.0f);
+            glm::mat4 shadowView = getShadowMapView(direction);
+            glm::mat4 shadowProj = getShadowMapProjection();
             StaticCamera shadowCamera(shadowView, shadowProj, camera.getPosition());
 
             // Render shadow map
-            shadowMapPass(scene, shadowCamera, window, manager);
+            shadowMapPass(scene, shadowCamera, window, manager, shadowQueries[lightIndex]);
 
             // Prepare light pass frame buffer
             m_lightPassFrameBuffer.setActive(GL_FRAMEBUFFER);
@@ -1526,6 +1689,9 @@ void DeferredRenderer::draw(Mesh *mesh, const glm::mat4 &translation, const glm:
         manager.getDefaultNormalTexture()->setActive(normalTextureUnit);
     }
     shader->setUniform(normalTextureUniformName, normalTextureUnit);
+    // Only two channel normal maps reconstruct z
+    shader->setUniform(normalTwoChannelUniformName,
+                       (int)(material->hasNormal() && material->getNormal()->getColorFormat() == ColorFormat::BC5));
 
     if (material->hasSpecular())
     {
@@ -1568,6 +1734,64 @@ void DeferredRenderer::draw(Mesh *mesh, const glm::mat4 &translation, const glm:
     // TODO Cleanup?
 }
 
+void DeferredRenderer::drawPacked(ShaderProgram *shader)
+{
+    // Sort by texture arrays to share the bindings
+    auto getArrays = [](const SPackedDraw &draw, const TextureArray *arrays[5])
+    {
+        for (unsigned int i = 0; i < 5; ++i)
+        {
+            arrays[i] = draw.textures[i]->getArray();
+        }
+    };
+    std::sort(m_packedDraws.begin(), m_packedDraws.end(),
+              [&getArrays](const SPackedDraw &a, const SPackedDraw &b)
+              {
+                  const TextureArray *arraysA[5];
+                  const TextureArray *arraysB[5];
+                  getArrays(a, arraysA);
+                  getArrays(b, arraysB);
+                  return std::lexicographical_compare(arraysA, arraysA + 5, arraysB, arraysB + 5,
+                                                      std::less<const TextureArray *>());
+              });
+
+    const GLint textureUnits[5] = {diffuseTextureUnit, normalTextureUnit, specularTextureUnit, glowTextureUnit,
+                                   alphaTextureUnit};
+    const std::string *textureUniformNames[5] = {&diffuseTextureUniformName, &normalTextureUniformName,
+                                                 &specularTextureUniformName, &glowTextureUniformName,
+                                                 &alphaTextureUniformName};
+    const std::string *layerUniformNames[5] = {&diffuseLayerUniformName, &normalLayerUniformName,
+                                               &specularLayerUniformName, &glowLayerUniformName,
+                                               &alphaLayerUniformName};
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        shader->setUniform(*textureUniformNames[i], textureUnits[i]);
+    }
+
+    const TextureArray *boundArrays[5] = {nullptr, nullptr, nullptr, nullptr, nullptr};
+    for (const auto &packedDraw : m_packedDraws)
+    {
+        for (unsigned int i = 0; i < 5; ++i)
+        {
+            const TextureArray *array = packedDraw.textures[i]->getArray();
+            if (array != boundArrays[i])
+            {
+                array->setActive(textureUnits[i]);
+                boundArrays[i] = array;
+                if (textureUnits[i] == normalTextureUnit)
+                {
+                    // All layers of an array share its format
+                    shader->setUniform(normalTwoChannelUniformName, (int)(array->getColorFormat() == ColorFormat::BC5));
+                }
+            }
+            shader->setUniform(*layerUniformNames[i], (int)packedDraw.textures[i]->getLayer());
+        }
+        shader->setUniform(rotationMatrixUniformName, packedDraw.rotation);
+        shader->setUniform(modelMatrixUniformName, packedDraw.model);
+        ::draw(*packedDraw.mesh);
+    }
+}
+
 bool DeferredRenderer::initGeometryPass(IResourceManager &manager)
 {
     // Init geometry pass shader
@@ -1583,6 +1807,18 @@ bool DeferredRenderer::initGeometryPass(IResourceManager &manager)
         return false;
     }
 
+    // Geometry pass shader for materials packed into texture arrays, loading throws for missing files
+    std::string geometryPassArrayShaderFile("data/shader/deferred/geometry_pass_array.ini");
+    if (std::filesystem::exists(geometryPassArrayShaderFile))
+    {
+        m_geometryPassArrayShaderId = manager.loadShader(geometryPassArrayShaderFile);
+    }
+    if (m_geometryPassArrayShaderId == InvalidResource)
+    {
+        logi("No texture array shader {}, packed materials are drawn with the geometry pass shader.",
+             geometryPassArrayShaderFile.c_str());
+    }
+
     // Init gbuffer
     // Diffuse texture, stores base color and glow mask.
     m_diffuseGlowTexture = std::make_shared<Texture>();
@@ -4,6 +4,7 @@
 
 #include <fmtlog/fmtlog.h>
 
+#include "kern/graphics/renderer/RenderStats.h"
 #include "kern/graphics/resource/Mesh.h"
 
 void draw(Mesh &mesh)
@@ -24,12 +25,14 @@ void draw(Mesh &mesh)
         // Indexed draw, faster
         mesh.getIndexBuffer()->setActive();
         glDrawElements(mode, mesh.getIndexBuffer()->getSize(), GL_UNSIGNED_INT, nullptr);
+        ++getRenderStats().drawCalls;
         mesh.getIndexBuffer()->setInactive();
     }
     else
     {
         // Slowest draw method
         glDrawArrays(mode, 0, mesh.getVertexBuffer()->getSize() / primitiveSize);
+        ++getRenderStats().drawCalls;
     }
     mesh.getVertexArray()->setInactive();
 }
\ No newline at end of file
@@ -12,11 +12,13 @@
 #include "kern/graphics/IScene.h"
 #include "kern/graphics/Window.h"
 #include "kern/graphics/renderer/Draw.h"
+#include "kern/graphics/renderer/RenderStats.h"
 #include "kern/graphics/renderer/RendererCoreConfig.h"
 #include "kern/graphics/resource/Material.h"
 #include "kern/graphics/resource/Mesh.h"
 #include "kern/graphics/resource/ShaderProgram.h"
 #include "kern/graphics/resource/Texture.h"
+#include "kern/graphics/resource/TextureStreamer.h"
 #include "kern/graphics/scene/SceneQuery.h"
 #include "kern/resource/IResourceManager.h"
 
@@ -62,6 +64,7 @@ void ForwardRenderer::draw(const IScene &scene, const ICamera &camera, const Win
 
     // Initializiation
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ++getRenderStats().frameBufferBinds;
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glEnable(GL_DEPTH_TEST);
 
@@ -106,6 +109,10 @@ void ForwardRenderer::draw(const IScene &scene, const ICamera &camera, const Win
             Mesh *mesh = manager.getMesh(meshId);
             Material *material = manager.getMaterial(materialId);
 
+            // Texture streaming feedback
+            material->requestScreenSize(
+                getProjectedSize(mesh->getBoundingSphere(), position, rotation, scale, camera, window.getHeight()));
+
             // Create matrices
             Transformer transformer;
             transformer.setPosition(position);
@@ -3,6 +3,7 @@
 #include <cassert>
 
 #include "kern/graphics/renderer/RenderBuffer.h"
+#include "kern/graphics/renderer/RenderStats.h"
 #include "kern/graphics/resource/Texture.h"
 
 FrameBuffer::FrameBuffer() : m_fboId(0), m_valid(false) { init(); }
@@ -76,6 +77,7 @@ void FrameBuffer::setActive(GLenum target)
 {
     assert(m_valid);
     glBindFramebuffer(target, m_fboId);
+    ++getRenderStats().frameBufferBinds;
     // Set draw buffers
     if (!m_drawBuffers.empty())
     {
@@ -83,7 +85,11 @@ void FrameBuffer::setActive(GLenum target)
     }
 }
 
-void FrameBuffer::setInactive(GLenum target) { glBindFramebuffer(target, 0); }
+void FrameBuffer::setInactive(GLenum target)
+{
+    glBindFramebuffer(target, 0);
+    ++getRenderStats().frameBufferBinds;
+}
 
 void FrameBuffer::resize(unsigned int width, unsigned int height)
 {
@@ -136,7 +142,11 @@ void FrameBuffer::attach(const std::shared_ptr<Texture> &texture, GLenum attachm
     attach(texture, attachment, semantic);
 }
 
-void FrameBuffer::setDefaultActive() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+void FrameBuffer::setDefaultActive()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ++getRenderStats().frameBufferBinds;
+}
 
 void FrameBuffer::attach(const std::shared_ptr<RenderBuffer> &renderBuffer, GLenum attachment)
 {
@@ -163,4 +173,18 @@ std::shared_ptr<Texture> FrameBuffer::getTexture(TextureSemantic semantic)
         return nullptr;
     }
     return m_texturesBySemantic.at(semantic);
+}
+
+std::size_t FrameBuffer::getGpuSize() const
+{
+    std::size_t size = 0;
+    for (const auto &texture : m_textures)
+    {
+        size += texture.second->getGpuSize();
+    }
+    for (const auto &renderBuffer : m_renderBuffers)
+    {
+        size += renderBuffer.second->getGpuSize();
+    }
+    return size;
 }
\ No newline at end of file
@@ -38,4 +38,6 @@ bool IndexBuffer::isValid() const { return m_valid; }
 
 GLuint IndexBuffer::getId() const { return m_bufferId; }
 
-unsigned int IndexBuffer::getSize() const { return m_size; }
\ No newline at end of file
+unsigned int IndexBuffer::getSize() const { return m_size; }
+
+std::size_t IndexBuffer::getGpuSize() const { return m_size * sizeof(unsigned int); }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "kern/graphics/renderer/RenderBuffer.h"
 
+#include "kern/graphics/resource/Texture.h"
+
 RenderBuffer::RenderBuffer() {}
 
 RenderBuffer::~RenderBuffer()
@@ -39,4 +41,9 @@ GLuint RenderBuffer::getId() const { return m_bufferId; }
 
 GLenum RenderBuffer::getFormat() const { return m_format; }
 
+std::size_t RenderBuffer::getGpuSize() const
+{
+    return (std::size_t)m_width * m_height * Texture::getPixelSize(m_format);
+}
+
 void RenderBuffer::setActive() const { glBindRenderbuffer(GL_RENDERBUFFER, m_bufferId); }
@@ -0,0 +1,8 @@
+#include "kern/graphics/renderer/RenderStats.h"
+
+// GL calls are only issued by the thread owning the context, no synchronization needed
+static SRenderStats renderStats;
+
+SRenderStats &getRenderStats() { return renderStats; }
+
+void resetRenderStats() { renderStats = SRenderStats(); }
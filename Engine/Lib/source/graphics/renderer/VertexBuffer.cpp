@@ -38,6 +38,8 @@ GLuint VertexBuffer::getId() const { return m_bufferId; }
 
 unsigned int VertexBuffer::getSize() const { return m_size; }
 
+std::size_t VertexBuffer::getGpuSize() const { return m_size * sizeof(float); }
+
 VertexBuffer::VertexBuffer(GLenum usage) : m_bufferId(0), m_valid(false), m_size(0), m_usage(usage)
 {
     glGenBuffers(1, &m_bufferId);
@@ -1,6 +1,7 @@
 #include "kern/graphics/renderer/pass/ScreenQuadPass.h"
 
 #include "kern/graphics/renderer/RendererCoreConfig.h"
+#include "kern/graphics/renderer/RenderStats.h"
 
 ScreenQuadPass::ScreenQuadPass()
 {
@@ -30,6 +31,7 @@ void ScreenQuadPass::draw(Texture *diffuseGlow, Texture *lightTexture, Texture *
     if (fbo == nullptr)
     {
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        ++getRenderStats().frameBufferBinds;
     }
     else
     {
@@ -52,6 +54,7 @@ void ScreenQuadPass::draw(Texture *diffuseGlow, Texture *lightTexture, Texture *
 
     m_quad->getVertexArray()->setActive();
     glDrawArrays(GL_POINTS, 0, 1);
+    ++getRenderStats().drawCalls;
     m_quad->getVertexArray()->setInactive();
     m_shader->setInactive();
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "kern/graphics/IGraphicsResourceManager.h"
 #include "kern/graphics/renderer/FrameBuffer.h"
 #include "kern/graphics/renderer/RendererCoreConfig.h"
+#include "kern/graphics/renderer/RenderStats.h"
 #include "kern/graphics/resource/ShaderProgram.h"
 #include "kern/graphics/resource/Texture.h"
 
@@ -57,6 +58,7 @@ void ScreenSpacePass::draw(const IGraphicsResourceManager *manager, FrameBuffer
     {
         // Default FBO
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        ++getRenderStats().frameBufferBinds;
     }
     else
     {
@@ -93,6 +95,7 @@ void ScreenSpacePass::draw(const IGraphicsResourceManager *manager, FrameBuffer
 
     m_quad->getVertexArray()->setActive();
     glDrawArrays(GL_POINTS, 0, 1);
+    ++getRenderStats().drawCalls;
     m_quad->getVertexArray()->setInactive();
     shader->setInactive();
 
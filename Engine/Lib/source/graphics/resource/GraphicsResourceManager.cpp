@@ -2,13 +2,22 @@
 
 #include <fmtlog/fmtlog.h>
 
+#include <algorithm>
 #include <cassert>
+#include <initializer_list>
 #include <string>
+#include <vector>
 
+#include "kern/foundation/MemoryReport.h"
 #include "kern/resource/IResourceManager.h"
 
-GraphicsResourceManager::GraphicsResourceManager()
+GraphicsResourceManager::GraphicsResourceManager() : m_shaderCache("cache/shader")
 {
+    m_textureUploader.reset(new TextureUploader);
+    m_textureStreamer.reset(new TextureStreamer(*m_textureUploader));
+    m_texturePacker.reset(new TexturePacker);
+    enableParallelShaderCompile();
+
     // Create default textures
     initDefaultTextures();
     return;
@@ -68,24 +77,98 @@ void GraphicsResourceManager::notify(ResourceType type, ResourceId id, ResourceE
     }
 }
 
+void GraphicsResourceManager::update()
+{
+    // Requests from the last frame select the levels to upload
+    m_textureStreamer->update();
+    m_textureUploader->update();
+    resolveShaderPrograms(false);
+}
+
+void GraphicsResourceManager::resolveShaderPrograms(bool wait)
+{
+    auto iter = m_pendingShaderPrograms.begin();
+    while (iter != m_pendingShaderPrograms.end())
+    {
+        ShaderProgram *program = m_shaderPrograms.at(iter->id).get();
+        if (!wait && program->isLinking())
+        {
+            ++iter;
+            continue;
+        }
+
+        // Compile errors are only logged, a failed stage fails the link as well
+        logShaderErrors(iter->stages);
+        if (program->resolve())
+        {
+            // Store binary for the next run
+            GLenum binaryFormat = 0;
+            std::vector<char> binary;
+            if (!iter->cacheKey.empty() && program->getBinary(binaryFormat, binary))
+            {
+                m_shaderCache.store(iter->cacheKey, binaryFormat, binary);
+            }
+        }
+        else
+        {
+            loge("Failed to link shader program {}: {}", iter->id, program->getErrorString().c_str());
+            if (program->isValid())
+            {
+                logw("Keeping the previous version of shader program {}.", iter->id);
+            }
+        }
+        iter = m_pendingShaderPrograms.erase(iter);
+    }
+}
+
+void GraphicsResourceManager::logShaderErrors(const ResourceId stages[5]) const
+{
+    // Stage order of SPendingShaderProgram
+    auto logError = [](const auto *shader)
+    {
+        if (shader != nullptr && !shader->resolve())
+        {
+            loge("{}", shader->getErrorString().c_str());
+        }
+    };
+    logError(getVertexShaderObject(stages[0]));
+    logError(getTessControlShaderObject(stages[1]));
+    logError(getTessEvalShaderObject(stages[2]));
+    logError(getGeometryShaderObject(stages[3]));
+    logError(getFragmentShaderObject(stages[4]));
+}
+
+void GraphicsResourceManager::setTextureBudget(std::size_t budget) { m_textureStreamer->setBudget(budget); }
+
 void GraphicsResourceManager::initDefaultTextures()
 {
     // Default diffuse texture is deep pink to signal errors/missing textures
-    m_defaultDiffuseTexture.reset(new Texture({238, 18, 137}, 1, 1, ColorFormat::RGB24, 0));
+    m_defaultDiffuseTexture = createDefaultTexture(Image({238, 18, 137}, 1, 1, ColorFormat::RGB24));
 
     // Default normal texture with straight/non-perturbed normals
     // Discussion here:
     // http://www.gameartisans.org/forums/threads/1985-Normal-Map-RGB-127-127-255-or-128-128-255
-    m_defaultNormalTexture.reset(new Texture({128, 128, 255}, 1, 1, ColorFormat::RGB24, 0));
+    m_defaultNormalTexture = createDefaultTexture(Image({128, 128, 255}, 1, 1, ColorFormat::RGB24));
 
     // Default specular texture is black (no specular highlights)
-    m_defaultSpecularTexture.reset(new Texture({0}, 1, 1, ColorFormat::GreyScale8));
+    m_defaultSpecularTexture = createDefaultTexture(Image({0}, 1, 1, ColorFormat::GreyScale8));
 
     // Default glow texture is black (no glow)
-    m_defaultGlowTexture.reset(new Texture({0}, 1, 1, ColorFormat::GreyScale8));
+    m_defaultGlowTexture = createDefaultTexture(Image({0}, 1, 1, ColorFormat::GreyScale8));
 
     // Default alpha texture is white (completely opaque)
-    m_defaultAlphaTexture.reset(new Texture({255}, 1, 1, ColorFormat::GreyScale8));
+    m_defaultAlphaTexture = createDefaultTexture(Image({255}, 1, 1, ColorFormat::GreyScale8));
+}
+
+std::unique_ptr<Texture> GraphicsResourceManager::createDefaultTexture(const Image &image)
+{
+    // Packed default textures let materials with missing textures use the array bindings
+    std::unique_ptr<Texture> texture(new Texture);
+    if (!m_texturePacker->add(texture.get(), image) && !texture->init(image))
+    {
+        loge("Failed to initialize default texture.");
+    }
+    return texture;
 }
 
 Mesh *GraphicsResourceManager::getMesh(ResourceId id) const
@@ -182,6 +265,37 @@ Texture *GraphicsResourceManager::getDefaultGlowTexture() const { return m_defau
 
 Texture *GraphicsResourceManager::getDefaultAlphaTexture() const { return m_defaultAlphaTexture.get(); }
 
+void GraphicsResourceManager::reportMemory(MemoryReport &report) const
+{
+    std::size_t meshBytes = 0;
+    for (const auto &mesh : m_meshes)
+    {
+        meshBytes += mesh.second->getGpuSize();
+    }
+    report.add("graphics/mesh", m_meshes.size(), 0, meshBytes);
+
+    std::size_t textureBytes = 0;
+    for (const auto &texture : m_textures)
+    {
+        textureBytes += texture.second->getGpuSize();
+    }
+    for (const Texture *texture : {m_defaultDiffuseTexture.get(), m_defaultNormalTexture.get(),
+                                   m_defaultSpecularTexture.get(), m_defaultGlowTexture.get(),
+                                   m_defaultAlphaTexture.get()})
+    {
+        if (texture != nullptr)
+        {
+            textureBytes += texture->getGpuSize();
+        }
+    }
+    report.add("graphics/texture", m_textures.size(), 0, textureBytes);
+    report.add("graphics/textureArray", m_texturePacker->getArrayCount(), 0, m_texturePacker->getGpuSize());
+
+    report.add("graphics/material", m_materials.size(), m_materials.size() * sizeof(Material));
+    report.add("graphics/model", m_models.size(), m_models.size() * sizeof(Model));
+    report.add("graphics/shaderProgram", m_shaderPrograms.size(), 0);
+}
+
 TShaderObject<GL_VERTEX_SHADER> *GraphicsResourceManager::getVertexShaderObject(ResourceId id) const
 {
     // Invalid id
@@ -281,13 +395,8 @@ bool GraphicsResourceManager::loadVertexShader(ResourceId id, IResourceManager *
     {
         return false;
     }
-    std::unique_ptr<TShaderObject<GL_VERTEX_SHADER>> shader(new TShaderObject<GL_VERTEX_SHADER>(text));
-    // Check compile error
-    if (!shader->isValid())
-    {
-        loge("{}", shader->getErrorString().c_str());
-        return false;
-    }
+    // Compile status is resolved with the program, see resolveShaderPrograms
+    std::unique_ptr<TShaderObject<GL_VERTEX_SHADER>> shader(new TShaderObject<GL_VERTEX_SHADER>(text, false));
     // Move to map
     m_vertexShader[id] = std::move(shader);
     return true;
@@ -312,13 +421,9 @@ bool GraphicsResourceManager::loadTessControlShader(ResourceId id, IResourceMana
     {
         return false;
     }
-    std::unique_ptr<TShaderObject<GL_TESS_CONTROL_SHADER>> shader(new TShaderObject<GL_TESS_CONTROL_SHADER>(text));
-    // Check compile error
-    if (!shader->isValid())
-    {
-        loge("{}", shader->getErrorString().c_str());
-        return false;
-    }
+    // Compile status is resolved with the program, see resolveShaderPrograms
+    std::unique_ptr<TShaderObject<GL_TESS_CONTROL_SHADER>> shader(
+        new TShaderObject<GL_TESS_CONTROL_SHADER>(text, false));
     // Move to map
     m_tessConstrolShader[id] = std::move(shader);
     return true;
@@ -343,14 +448,9 @@ bool GraphicsResourceManager::loadTessEvalShader(ResourceId id, IResourceManager
     {
         return false;
     }
+    // Compile status is resolved with the program, see resolveShaderPrograms
     std::unique_ptr<TShaderObject<GL_TESS_EVALUATION_SHADER>> shader(
-        new TShaderObject<GL_TESS_EVALUATION_SHADER>(text));
-    // Check compile error
-    if (!shader->isValid())
-    {
-        loge("{}", shader->getErrorString().c_str());
-        return false;
-    }
+        new TShaderObject<GL_TESS_EVALUATION_SHADER>(text, false));
     // Move to map
     m_tessEvalShader[id] = std::move(shader);
     return true;
@@ -375,13 +475,8 @@ bool GraphicsResourceManager::loadGeometryShader(ResourceId id, IResourceManager
     {
         return false;
     }
-    std::unique_ptr<TShaderObject<GL_GEOMETRY_SHADER>> shader(new TShaderObject<GL_GEOMETRY_SHADER>(text));
-    // Check compile error
-    if (!shader->isValid())
-    {
-        loge("{}", shader->getErrorString().c_str());
-        return false;
-    }
+    // Compile status is resolved with the program, see resolveShaderPrograms
+    std::unique_ptr<TShaderObject<GL_GEOMETRY_SHADER>> shader(new TShaderObject<GL_GEOMETRY_SHADER>(text, false));
     // Move to map
     m_geometryShader[id] = std::move(shader);
     return true;
@@ -406,13 +501,8 @@ bool GraphicsResourceManager::loadFragmentShader(ResourceId id, IResourceManager
     {
         return false;
     }
-    std::unique_ptr<TShaderObject<GL_FRAGMENT_SHADER>> shader(new TShaderObject<GL_FRAGMENT_SHADER>(text));
-    // Check compile error
-    if (!shader->isValid())
-    {
-        loge("{}", shader->getErrorString().c_str());
-        return false;
-    }
+    // Compile status is resolved with the program, see resolveShaderPrograms
+    std::unique_ptr<TShaderObject<GL_FRAGMENT_SHADER>> shader(new TShaderObject<GL_FRAGMENT_SHADER>(text, false));
     // Move to map
     m_fragmentShader[id] = std::move(shader);
     return true;
@@ -420,33 +510,37 @@ bool GraphicsResourceManager::loadFragmentShader(ResourceId id, IResourceManager
 
 void GraphicsResourceManager::handleImageEvent(ResourceId id, ResourceEvent event, IResourceManager *resourceManager)
 {
-    std::vector<unsigned char> data;
-    unsigned int width;
-    unsigned int height;
-    ColorFormat format;
+    Image image;
 
     switch (event)
     {
     case ResourceEvent::Create:
         assert(m_textures.count(id) == 0 && "Texture id already exists");
 
-        if (!resourceManager->getImage(id, data, width, height, format))
+        if (!resourceManager->getImage(id, image))
         {
             assert(false && "Failed to access image resource");
         }
-        // Create new texture
-        m_textures[id] = std::move(std::unique_ptr<Texture>(new Texture(data, width, height, format)));
+        // Create new texture, data is streamed in by the uploader
+        m_textures[id] = std::move(std::unique_ptr<Texture>(new Texture));
+        if (!initTexture(m_textures.at(id).get(), std::move(image)))
+        {
+            loge("Failed to initialize texture for image {}.", id);
+        }
         break;
 
     case ResourceEvent::Change:
         assert(m_textures.count(id) == 1 && "Texture id does not exist");
 
-        if (!resourceManager->getImage(id, data, width, height, format))
+        if (!resourceManager->getImage(id, image))
         {
             assert(false && "Failed to access image resource");
         }
-        // Reinitialize texture on change
-        m_textures.at(id)->init(data, width, height, format);
+        // Reinitialize texture on change, replaces pending uploads
+        if (!initTexture(m_textures.at(id).get(), std::move(image)))
+        {
+            loge("Failed to initialize texture for image {}.", id);
+        }
         break;
 
     case ResourceEvent::Delete:
@@ -458,6 +552,29 @@ void GraphicsResourceManager::handleImageEvent(ResourceId id, ResourceEvent even
     }
 }
 
+bool GraphicsResourceManager::initTexture(Texture *texture, Image image)
+{
+    // Small images share texture arrays, stored mip levels are streamed by screen size,
+    // other images are uploaded completely
+    m_texturePacker->remove(texture);
+    m_textureStreamer->remove(texture);
+    m_textureUploader->cancel(texture);
+    if (m_texturePacker->add(texture, image))
+    {
+        return true;
+    }
+    if (image.m_levels > 1)
+    {
+        return m_textureStreamer->add(texture, std::move(image));
+    }
+    if (!texture->initStorage(image))
+    {
+        return false;
+    }
+    m_textureUploader->enqueue(texture, std::move(image));
+    return true;
+}
+
 void GraphicsResourceManager::handleMeshEvent(ResourceId id, ResourceEvent event, IResourceManager *resourceManager)
 {
     std::vector<float> vertices;
@@ -610,20 +727,46 @@ void GraphicsResourceManager::handleShaderEvent(ResourceId id, ResourceEvent eve
             assert(false && "Failed to access shader resource");
         }
 
-        // Load shader objects from source
-        if (!loadVertexShader(vertex, resourceManager) || !loadTessControlShader(tessControl, resourceManager) ||
-            !loadTessEvalShader(tessEval, resourceManager) || !loadGeometryShader(geometry, resourceManager) ||
-            !loadFragmentShader(fragment, resourceManager))
+        // Program binary of a previous run skips compiling and linking
         {
-            // TODO Log error
-            return;
+            SPendingShaderProgram pending;
+            pending.id = id;
+            pending.stages[0] = vertex;
+            pending.stages[1] = tessControl;
+            pending.stages[2] = tessEval;
+            pending.stages[3] = geometry;
+            pending.stages[4] = fragment;
+            pending.cacheKey = getShaderCacheKey(pending.stages, resourceManager);
+            GLenum binaryFormat = 0;
+            std::vector<char> binary;
+            if (!pending.cacheKey.empty() && m_shaderCache.load(pending.cacheKey, binaryFormat, binary))
+            {
+                std::unique_ptr<ShaderProgram> program(new ShaderProgram(binaryFormat, binary));
+                if (program->isValid())
+                {
+                    m_shaderPrograms[id] = std::move(program);
+                    break;
+                }
+                logi("Cached binary of shader program {} rejected, compiling from source.", id);
+            }
+
+            // Load shader objects from source
+            if (!loadVertexShader(vertex, resourceManager) || !loadTessControlShader(tessControl, resourceManager) ||
+                !loadTessEvalShader(tessEval, resourceManager) || !loadGeometryShader(geometry, resourceManager) ||
+                !loadFragmentShader(fragment, resourceManager))
+            {
+                // TODO Log error
+                return;
+            }
+
+            // Add create shader program, compile and link are only submitted to let the driver work on all
+            // programs in parallel
+            m_shaderPrograms[id] = std::move(std::unique_ptr<ShaderProgram>(
+                new ShaderProgram(getVertexShaderObject(vertex), getTessControlShaderObject(tessControl),
+                                  getTessEvalShaderObject(tessEval), getGeometryShaderObject(geometry),
+                                  getFragmentShaderObject(fragment), false)));
+            m_pendingShaderPrograms.push_back(pending);
         }
-
-        // Add create shader program
-        m_shaderPrograms[id] = std::move(std::unique_ptr<ShaderProgram>(new ShaderProgram(
-            getVertexShaderObject(vertex), getTessControlShaderObject(tessControl), getTessEvalShaderObject(tessEval),
-            getGeometryShaderObject(geometry), getFragmentShaderObject(fragment))));
-
         break;
 
     case ResourceEvent::Change:
@@ -639,7 +782,94 @@ void GraphicsResourceManager::handleShaderEvent(ResourceId id, ResourceEvent eve
     }
 }
 
+std::string GraphicsResourceManager::getShaderCacheKey(const ResourceId stages[5],
+                                                       IResourceManager *resourceManager) const
+{
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0)
+    {
+        return "";
+    }
+
+    // Binaries are only valid for the driver which created them
+    std::vector<std::string> parts;
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        const GLubyte *value = glGetString(name);
+        parts.emplace_back(value != nullptr ? (const char *)value : "");
+    }
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        std::string source;
+        if (stages[i] != InvalidResource && !resourceManager->getString(stages[i], source))
+        {
+            return "";
+        }
+        parts.push_back(std::move(source));
+    }
+    return ShaderCache::getKey(parts);
+}
+
 void GraphicsResourceManager::handleStringEvent(ResourceId id, ResourceEvent event, IResourceManager *resourceManager)
 {
-    // Does not need processing, shader events handle source loading
+    // Shader events handle source loading, only changed sources need processing
+    if (event != ResourceEvent::Change)
+    {
+        return;
+    }
+    std::string text;
+    if (!resourceManager->getString(id, text) || text.empty())
+    {
+        return;
+    }
+
+    // Recompile shader objects of the source, they keep their former compile until resolved
+    auto recompile = [id, &text](auto &shaders)
+    {
+        auto iter = shaders.find(id);
+        if (iter != shaders.end())
+        {
+            iter->second->submit(text);
+        }
+    };
+    recompile(m_vertexShader);
+    recompile(m_tessConstrolShader);
+    recompile(m_tessEvalShader);
+    recompile(m_geometryShader);
+    recompile(m_fragmentShader);
+
+    // Relink affected programs only, they are swapped in when resolved, see resolveShaderPrograms
+    for (const auto &entry : m_shaderPrograms)
+    {
+        SPendingShaderProgram pending;
+        pending.id = entry.first;
+        ResourceId *stages = pending.stages;
+        if (!resourceManager->getShader(entry.first, stages[0], stages[1], stages[2], stages[3], stages[4]) ||
+            std::find(stages, stages + 5, id) == stages + 5)
+        {
+            continue;
+        }
+
+        // Programs loaded from a binary have no shader objects yet
+        if (!loadVertexShader(stages[0], resourceManager) || !loadTessControlShader(stages[1], resourceManager) ||
+            !loadTessEvalShader(stages[2], resourceManager) || !loadGeometryShader(stages[3], resourceManager) ||
+            !loadFragmentShader(stages[4], resourceManager) ||
+            !entry.second->submit(getVertexShaderObject(stages[0]), getTessControlShaderObject(stages[1]),
+                                  getTessEvalShaderObject(stages[2]), getGeometryShaderObject(stages[3]),
+                                  getFragmentShaderObject(stages[4])))
+        {
+            loge("Failed to relink shader program {}.", entry.first);
+            continue;
+        }
+        logi("Relinking shader program {}.", entry.first);
+        pending.cacheKey = getShaderCacheKey(stages, resourceManager);
+
+        // Replaces a relink submitted before
+        m_pendingShaderPrograms.erase(std::remove_if(m_pendingShaderPrograms.begin(), m_pendingShaderPrograms.end(),
+                                                     [&pending](const SPendingShaderProgram &other)
+                                                     { return other.id == pending.id; }),
+                                      m_pendingShaderPrograms.end());
+        m_pendingShaderPrograms.push_back(pending);
+    }
 }
@@ -2,6 +2,8 @@
 
 #include <fmtlog/fmtlog.h>
 
+#include <initializer_list>
+
 Material::Material(const Texture *diffuse, const Texture *normal, const Texture *specular,
                      const Texture *glow, const Texture *alpha)
     : m_diffuseTexture(nullptr),
@@ -70,4 +72,27 @@ const Texture *Material::getSpecular() const { return m_specularTexture; }
 
 const Texture *Material::getGlow() const { return m_glowTexture; }
 
-const Texture *Material::getAlpha() const { return m_alphaTexture; }
\ No newline at end of file
+const Texture *Material::getAlpha() const { return m_alphaTexture; }
+
+void Material::requestScreenSize(float pixels) const
+{
+    for (const Texture *texture : {m_diffuseTexture, m_normalTexture, m_specularTexture, m_glowTexture, m_alphaTexture})
+    {
+        if (texture != nullptr)
+        {
+            texture->requestScreenSize(pixels);
+        }
+    }
+}
+
+bool Material::isPacked() const
+{
+    for (const Texture *texture : {m_diffuseTexture, m_normalTexture, m_specularTexture, m_glowTexture, m_alphaTexture})
+    {
+        if (texture != nullptr && texture->getArray() == nullptr)
+        {
+            return false;
+        }
+    }
+    return true;
+}
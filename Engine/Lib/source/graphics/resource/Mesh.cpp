@@ -122,6 +122,23 @@ const std::unique_ptr<VertexArrayObject> &Mesh::getVertexArray() const {
 
 const BoundingSphere &Mesh::getBoundingSphere() const { return m_boundingSphere; }
 
+std::size_t Mesh::getGpuSize() const
+{
+    std::size_t size = 0;
+    for (const VertexBuffer *buffer : {m_vertices.get(), m_normals.get(), m_uvs.get()})
+    {
+        if (buffer != nullptr)
+        {
+            size += buffer->getGpuSize();
+        }
+    }
+    if (m_indices != nullptr)
+    {
+        size += m_indices->getGpuSize();
+    }
+    return size;
+}
+
 GLenum Mesh::toGLPrimitive(PrimitiveType type)
 {
     switch (type)
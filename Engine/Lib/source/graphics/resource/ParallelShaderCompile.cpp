@@ -0,0 +1,73 @@
+#include "kern/graphics/resource/ParallelShaderCompile.h"
+
+#include <cstring>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+typedef void (*MaxShaderCompilerThreadsFunction)(GLuint count);
+
+// Extension state of the context, queried once
+static int s_supported = -1;
+
+bool isParallelShaderCompileSupported()
+{
+    if (s_supported < 0)
+    {
+        s_supported = 0;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            const char *name = (const char *)glGetStringi(GL_EXTENSIONS, i);
+            if (name != nullptr && (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0 ||
+                                    std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0))
+            {
+                s_supported = 1;
+                break;
+            }
+        }
+    }
+    return s_supported == 1;
+}
+
+void enableParallelShaderCompile()
+{
+    if (!isParallelShaderCompileSupported())
+    {
+        return;
+    }
+    // Entry point has a different suffix depending on the extension
+    auto maxThreads = (MaxShaderCompilerThreadsFunction)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+    if (maxThreads == nullptr)
+    {
+        maxThreads = (MaxShaderCompilerThreadsFunction)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+    }
+    if (maxThreads != nullptr)
+    {
+        // Maximum value leaves the thread count to the driver
+        maxThreads(0xFFFFFFFF);
+    }
+}
+
+bool isShaderCompileComplete(GLuint shaderId)
+{
+    if (!isParallelShaderCompileSupported())
+    {
+        return true;
+    }
+    GLint complete = GL_TRUE;
+    glGetShaderiv(shaderId, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+bool isProgramLinkComplete(GLuint programId)
+{
+    if (!isParallelShaderCompileSupported())
+    {
+        return true;
+    }
+    GLint complete = GL_TRUE;
+    glGetProgramiv(programId, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
@@ -0,0 +1,125 @@
+#include "kern/graphics/resource/ShaderCache.h"
+
+#include <fmtlog/fmtlog.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+// Binary file header
+const char cacheMagic[4] = {'K', 'S', 'P', 'B'};
+const std::uint32_t cacheVersion = 1;
+
+// 64 bit FNV-1a
+static void hash(std::uint64_t &value, const void *data, std::size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        value ^= bytes[i];
+        value *= 1099511628211ull;
+    }
+}
+
+ShaderCache::ShaderCache(const std::string &directory) : m_directory(directory) {}
+
+std::string ShaderCache::getKey(const std::vector<std::string> &parts)
+{
+    std::uint64_t value = 14695981039346656037ull;
+    for (const auto &part : parts)
+    {
+        std::uint64_t size = part.size();
+        hash(value, &size, sizeof(size));
+        hash(value, part.data(), part.size());
+    }
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", (unsigned long long)value);
+    return key;
+}
+
+bool ShaderCache::load(const std::string &key, GLenum &binaryFormat, std::vector<char> &binary) const
+{
+    std::ifstream file(getFile(key), std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t format = 0;
+    std::uint64_t size = 0;
+    file.read(magic, sizeof(magic));
+    file.read((char *)&version, sizeof(version));
+    file.read((char *)&format, sizeof(format));
+    file.read((char *)&size, sizeof(size));
+    if (!file || !std::equal(magic, magic + 4, cacheMagic) || version != cacheVersion || size == 0)
+    {
+        logw("Invalid shader cache file {}.", getFile(key));
+        return false;
+    }
+
+    // Check the size against the file before allocating, a corrupt size may be huge
+    std::error_code error;
+    std::uintmax_t fileSize = std::filesystem::file_size(getFile(key), error);
+    std::uint64_t headerSize = sizeof(magic) + sizeof(version) + sizeof(format) + sizeof(size);
+    if (error || fileSize < headerSize || size > fileSize - headerSize)
+    {
+        logw("Truncated shader cache file {}.", getFile(key));
+        return false;
+    }
+
+    binary.resize(size);
+    file.read(binary.data(), size);
+    if ((std::uint64_t)file.gcount() != size)
+    {
+        logw("Truncated shader cache file {}.", getFile(key));
+        return false;
+    }
+    binaryFormat = format;
+    return true;
+}
+
+bool ShaderCache::store(const std::string &key, GLenum binaryFormat, const std::vector<char> &binary) const
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+    {
+        logw("Failed to create shader cache directory {}.", m_directory);
+        return false;
+    }
+
+    // Write to a temporary file first, a crash never leaves a truncated binary behind
+    std::string file = getFile(key);
+    std::string temporaryFile = file + ".tmp";
+    {
+        std::ofstream stream(temporaryFile, std::ios::binary | std::ios::trunc);
+        std::uint32_t format = binaryFormat;
+        std::uint64_t size = binary.size();
+        stream.write(cacheMagic, sizeof(cacheMagic));
+        stream.write((const char *)&cacheVersion, sizeof(cacheVersion));
+        stream.write((const char *)&format, sizeof(format));
+        stream.write((const char *)&size, sizeof(size));
+        stream.write(binary.data(), binary.size());
+        if (!stream)
+        {
+            logw("Failed to write shader cache file {}.", temporaryFile);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporaryFile, file, error);
+    if (error)
+    {
+        logw("Failed to write shader cache file {}.", file);
+        std::filesystem::remove(temporaryFile, error);
+        return false;
+    }
+    return true;
+}
+
+const std::string &ShaderCache::getDirectory() const { return m_directory; }
+
+std::string ShaderCache::getFile(const std::string &key) const { return m_directory + "/" + key + ".bin"; }
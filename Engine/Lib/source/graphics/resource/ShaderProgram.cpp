@@ -5,6 +5,7 @@
 #include <cassert>
 #include <glm/ext.hpp>
 
+#include "kern/graphics/renderer/RenderStats.h"
 #include "kern/graphics/resource/Texture.h"
 
 GLuint ShaderProgram::s_activeShaderProgram = 0;
@@ -12,10 +13,23 @@ GLuint ShaderProgram::s_activeShaderProgram = 0;
 ShaderProgram::ShaderProgram(TShaderObject<GL_VERTEX_SHADER> *vertex,
                              TShaderObject<GL_TESS_CONTROL_SHADER> *tessControl,
                              TShaderObject<GL_TESS_EVALUATION_SHADER> *tessEval,
-                             TShaderObject<GL_GEOMETRY_SHADER> *geometry, TShaderObject<GL_FRAGMENT_SHADER> *fragment)
+                             TShaderObject<GL_GEOMETRY_SHADER> *geometry, TShaderObject<GL_FRAGMENT_SHADER> *fragment,
+                             bool wait)
     : m_programId(0), m_valid(false)
 {
-    init(vertex, tessControl, tessEval, geometry, fragment);
+    if (wait)
+    {
+        init(vertex, tessControl, tessEval, geometry, fragment);
+    }
+    else
+    {
+        submit(vertex, tessControl, tessEval, geometry, fragment);
+    }
+}
+
+ShaderProgram::ShaderProgram(GLenum binaryFormat, const std::vector<char> &binary) : m_programId(0), m_valid(false)
+{
+    init(binaryFormat, binary);
 }
 
 ShaderProgram::~ShaderProgram()
@@ -24,41 +38,53 @@ ShaderProgram::~ShaderProgram()
     {
         glDeleteProgram(m_programId);
     }
+    if (m_pendingId != 0)
+    {
+        glDeleteProgram(m_pendingId);
+    }
 }
 
 bool ShaderProgram::init(TShaderObject<GL_VERTEX_SHADER> *vertex, TShaderObject<GL_TESS_CONTROL_SHADER> *tessControl,
                          TShaderObject<GL_TESS_EVALUATION_SHADER> *tessEval,
                          TShaderObject<GL_GEOMETRY_SHADER> *geometry, TShaderObject<GL_FRAGMENT_SHADER> *fragment)
 {
-    // Needs vertex shader
-    if (vertex == nullptr || !vertex->isValid())
+    // Objects are checked before linking, reports compile errors instead of link errors
+    if (vertex == nullptr || !vertex->isValid() || fragment == nullptr || !fragment->isValid() ||
+        (geometry != nullptr && !geometry->isValid()) || (tessControl != nullptr && !tessControl->isValid()) ||
+        (tessEval != nullptr && !tessEval->isValid()))
     {
         return false;
     }
-    // Need fragment shader
-    if (fragment == nullptr || !fragment->isValid())
+    if (!submit(vertex, tessControl, tessEval, geometry, fragment))
     {
         return false;
     }
+    resolve();
+    return m_infoLog.empty() && m_valid;
+}
 
-    // Check if any of the other shaders are invalid
-    // nullptr signals unused stage
-    if (geometry != nullptr && !geometry->isValid())
-    {
-        return false;
-    }
-    else if (tessControl != nullptr && !tessControl->isValid())
+bool ShaderProgram::submit(TShaderObject<GL_VERTEX_SHADER> *vertex, TShaderObject<GL_TESS_CONTROL_SHADER> *tessControl,
+                           TShaderObject<GL_TESS_EVALUATION_SHADER> *tessEval,
+                           TShaderObject<GL_GEOMETRY_SHADER> *geometry, TShaderObject<GL_FRAGMENT_SHADER> *fragment)
+{
+    m_infoLog.clear();
+
+    // Needs vertex and fragment shader, nullptr signals unused stage for the others
+    // Objects still compiling are attached anyway, a failed compile fails the link
+    if (vertex == nullptr || fragment == nullptr)
     {
         return false;
     }
-    else if (tessEval != nullptr && !tessEval->isValid())
+    if ((!vertex->isPending() && !vertex->isValid()) || (!fragment->isPending() && !fragment->isValid()) ||
+        (geometry != nullptr && !geometry->isPending() && !geometry->isValid()) ||
+        (tessControl != nullptr && !tessControl->isPending() && !tessControl->isValid()) ||
+        (tessEval != nullptr && !tessEval->isPending() && !tessEval->isValid()))
     {
         return false;
     }
 
     // Create program id
     GLuint programId = glCreateProgram();
-    // Attach shader objects after checking validity
 
     // Needed stages
     glAttachShader(programId, vertex->getId());
@@ -77,8 +103,34 @@ bool ShaderProgram::init(TShaderObject<GL_VERTEX_SHADER> *vertex, TShaderObject<
         glAttachShader(programId, tessEval->getId());
     }
 
-    // Link program
+    // Link program, keep the binary retrievable for the shader cache
+    // The status is queried when resolved
+    glProgramParameteri(programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(programId);
+
+    // Replace a former submitted link
+    if (m_pendingId != 0)
+    {
+        glDeleteProgram(m_pendingId);
+    }
+    m_pendingId = programId;
+    return true;
+}
+
+bool ShaderProgram::isPending() const { return m_pendingId != 0; }
+
+bool ShaderProgram::isLinking() const { return m_pendingId != 0 && !isProgramLinkComplete(m_pendingId); }
+
+bool ShaderProgram::resolve() const
+{
+    if (m_pendingId == 0)
+    {
+        // Already resolved, e.g. by a first query, reports the result of the last submitted link
+        return m_valid && m_infoLog.empty();
+    }
+    GLuint programId = m_pendingId;
+    m_pendingId = 0;
+
     // Check result
     GLint result;
     glGetProgramiv(programId, GL_LINK_STATUS, &result);
@@ -86,7 +138,7 @@ bool ShaderProgram::init(TShaderObject<GL_VERTEX_SHADER> *vertex, TShaderObject<
     {
         // Set info log size
         GLint size;
-        glGetShaderiv(programId, GL_INFO_LOG_LENGTH, &size);
+        glGetProgramiv(programId, GL_INFO_LOG_LENGTH, &size);
         if (size > 0)
         {
             // Create buffer
@@ -95,15 +147,23 @@ bool ShaderProgram::init(TShaderObject<GL_VERTEX_SHADER> *vertex, TShaderObject<
             glGetProgramInfoLog(programId, size, NULL, log.data());
             m_infoLog.assign(log.data(), size);
         }
+        else
+        {
+            m_infoLog = "Shader program link failed.";
+        }
         // Clean up temp id
         glDeleteProgram(programId);
         return false;
     }
     // New shader program linked successfully
-    // Delete old shader object
+    // Delete old program
     if (m_valid)
     {
-        glDeleteShader(m_programId);
+        if (s_activeShaderProgram == m_programId)
+        {
+            s_activeShaderProgram = 0;
+        }
+        glDeleteProgram(m_programId);
     }
     // Set new id
     m_programId = programId;
@@ -111,16 +171,71 @@ bool ShaderProgram::init(TShaderObject<GL_VERTEX_SHADER> *vertex, TShaderObject<
     m_valid = true;
     // Clear uniform location cache
     m_uniformLocations.clear();
+    return true;
+}
 
+bool ShaderProgram::init(GLenum binaryFormat, const std::vector<char> &binary)
+{
+    m_infoLog.clear();
+    if (binary.empty())
+    {
+        return false;
+    }
+
+    GLuint programId = glCreateProgram();
+    glProgramBinary(programId, binaryFormat, binary.data(), (GLsizei)binary.size());
+    // Link status reports whether the driver accepted the binary
+    GLint result;
+    glGetProgramiv(programId, GL_LINK_STATUS, &result);
+    if (result == GL_FALSE)
+    {
+        m_infoLog = "Program binary rejected by the driver.";
+        glDeleteProgram(programId);
+        return false;
+    }
+    // Replaces former links, also submitted ones
+    if (m_pendingId != 0)
+    {
+        glDeleteProgram(m_pendingId);
+        m_pendingId = 0;
+    }
+    if (m_valid)
+    {
+        if (s_activeShaderProgram == m_programId)
+        {
+            s_activeShaderProgram = 0;
+        }
+        glDeleteProgram(m_programId);
+    }
+    m_programId = programId;
+    m_valid = true;
+    m_uniformLocations.clear();
     return true;
 }
 
+bool ShaderProgram::getBinary(GLenum &binaryFormat, std::vector<char> &binary) const
+{
+    assert(isValid());
+    GLint size = 0;
+    glGetProgramiv(m_programId, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0)
+    {
+        return false;
+    }
+    binary.resize(size);
+    GLsizei length = 0;
+    glGetProgramBinary(m_programId, size, &length, &binaryFormat, binary.data());
+    binary.resize(length);
+    return length > 0;
+}
+
 void ShaderProgram::setActive()
 {
     assert(isValid());
     if (s_activeShaderProgram != m_programId)
     {
         glUseProgram(m_programId);
+        ++getRenderStats().programBinds;
         s_activeShaderProgram = m_programId;
     }
 }
@@ -131,16 +246,29 @@ void ShaderProgram::setInactive()
     if (s_activeShaderProgram == m_programId)
     {
         glUseProgram(0);
+        ++getRenderStats().programBinds;
         s_activeShaderProgram = 0;
     }
 }
 
-const std::string &ShaderProgram::getErrorString() const { return m_infoLog; }
+const std::string &ShaderProgram::getErrorString() const
+{
+    resolve();
+    return m_infoLog;
+}
 
-bool ShaderProgram::isValid() const { return m_valid; }
+bool ShaderProgram::isValid() const
+{
+    if (!m_valid)
+    {
+        resolve();
+    }
+    return m_valid;
+}
 
 GLint ShaderProgram::getUniformLocation(const std::string &uniformName) const
 {
+    isValid();
     // Search for cached location
     auto iter = m_uniformLocations.find(uniformName);
     // Not found
@@ -162,6 +290,7 @@ GLint ShaderProgram::getUniformLocation(const std::string &uniformName) const
 
 GLint ShaderProgram::getAttributeLocation(const std::string &attributeName) const
 {
+    isValid();
     return glGetAttribLocation(m_programId, attributeName.data());
 }
 
@@ -173,6 +302,7 @@ bool ShaderProgram::setUniform(GLint location, int i)
     }
     setActive();
     glUniform1i(location, i);
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
@@ -186,6 +316,7 @@ bool ShaderProgram::setUniform(GLint location, float f)
     }
     setActive();
     glUniform1f(location, f);
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
@@ -199,6 +330,7 @@ bool ShaderProgram::setUniform(GLint location, const glm::vec2 &v)
     }
     setActive();
     glUniform2f(location, v.x, v.y);
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
@@ -215,6 +347,7 @@ bool ShaderProgram::setUniform(GLint location, const glm::vec3 &v)
     }
     setActive();
     glUniform3f(location, v.x, v.y, v.z);
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
@@ -231,6 +364,7 @@ bool ShaderProgram::setUniform(GLint location, const glm::vec4 &v)
     }
     setActive();
     glUniform4f(location, v.x, v.y, v.z, v.w);
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
@@ -247,6 +381,7 @@ bool ShaderProgram::setUniform(GLint location, const glm::mat2 &m)
     }
     setActive();
     glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(m));
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
@@ -263,6 +398,7 @@ bool ShaderProgram::setUniform(GLint location, const glm::mat3 &m)
     }
     setActive();
     glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(m));
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
@@ -279,6 +415,7 @@ bool ShaderProgram::setUniform(GLint location, const glm::mat4 &m)
     }
     setActive();
     glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(m));
+    ++getRenderStats().uniformUpdates;
     return true;
 }
 
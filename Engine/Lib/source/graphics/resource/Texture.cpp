@@ -1,12 +1,25 @@
 #include "kern/graphics/resource/Texture.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <string>
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <fmtlog/fmtlog.h>
 #include <stb_image_write.h>
 
+#include "kern/graphics/renderer/RenderStats.h"
+#include "kern/graphics/resource/TextureArray.h"
+
+// S3TC is not part of core profile, glad only defines the enums if the extension was generated
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 Texture::Texture()
 {
     // empty
@@ -22,6 +35,15 @@ Texture::Texture(const std::vector<unsigned char> &image, unsigned int width, un
     }
 }
 
+Texture::Texture(const Image &image)
+{
+    // Init texture with data
+    if (!init(image))
+    {
+        loge("Failed to initialize texture.");
+    }
+}
+
 Texture::Texture(unsigned int width, unsigned int height, ColorFormat format, bool createMipmaps)
 {
     // Init texture with data
@@ -79,6 +101,329 @@ bool Texture::init(unsigned int width, unsigned int height, GLint format)
     return init({}, width, height, format, false);
 }
 
+bool Texture::init(const Image &image)
+{
+    if (!initStorage(image))
+    {
+        return false;
+    }
+
+    // Synchronous upload from client memory
+    const unsigned char *data = image.m_data.data();
+    for (unsigned int level = 0; level < image.m_levels; ++level)
+    {
+        std::size_t size = getImageSize(image.m_format, getLevelWidth(level), getLevelHeight(level));
+        setLevelData(level, data, size);
+        data += size;
+    }
+    if (m_generateMipmaps)
+    {
+        generateMipmaps();
+    }
+    setBaseLevel(0);
+    return true;
+}
+
+bool Texture::initStorage(const Image &image, unsigned int topLevel)
+{
+    // Sanity checks
+    if (image.m_width == 0 || image.m_height == 0 || image.m_levels == 0 || topLevel >= image.m_levels ||
+        image.m_data.size() != getImageSize(image.m_format, image.m_width, image.m_height, image.m_levels))
+    {
+        return false;
+    }
+
+    // Set internal and external format
+    GLint internalFormat = 0;
+    if (!getFormat(image.m_format, internalFormat, m_externalFormat))
+    {
+        return false;
+    }
+
+    // Uncompressed single level images get a full chain generated after the upload
+    m_generateMipmaps = image.m_levels == 1 && !isCompressed(image.m_format);
+    m_levels = image.m_levels;
+    if (m_generateMipmaps)
+    {
+        m_levels = (unsigned int)std::floor(std::log2(std::max(image.m_width, image.m_height))) + 1;
+    }
+
+    m_format = internalFormat;
+    m_colorFormat = image.m_format;
+    m_hasMipmaps = m_levels > 1;
+    m_width = image.m_width;
+    m_height = image.m_height;
+    GLuint textureId = createStorage(topLevel);
+
+    // Sample the smallest level until finer levels are uploaded
+    glTextureParameteri(textureId, GL_TEXTURE_BASE_LEVEL, (GLint)(m_levels - 1 - topLevel));
+    if (m_generateMipmaps)
+    {
+        // Smallest level is only generated after the upload, clear to black meanwhile
+        glClearTexImage(textureId, m_levels - 1, m_externalFormat, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    // Clean up previously created id
+    if (m_textureId != 0)
+    {
+        glDeleteTextures(1, &m_textureId);
+    }
+
+    m_textureId = textureId;
+    m_topLevel = topLevel;
+    m_baseLevel = m_levels - 1;
+    m_array = nullptr;
+    m_layer = 0;
+    m_valid = true;
+    return true;
+}
+
+bool Texture::initView(const TextureArray &array, unsigned int layer)
+{
+    if (array.getId() == 0 || layer >= array.getCapacity() ||
+        !getFormat(array.getColorFormat(), m_format, m_externalFormat))
+    {
+        return false;
+    }
+
+    // Views need a name which was never bound
+    GLuint textureId = 0;
+    glGenTextures(1, &textureId);
+    glTextureView(textureId, GL_TEXTURE_2D, array.getId(), array.getInternalFormat(), 0, array.getLevelCount(),
+                  layer, 1);
+    glTextureParameteri(textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(textureId, GL_TEXTURE_MIN_FILTER,
+                        array.getLevelCount() > 1 ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_R, GL_MIRRORED_REPEAT);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+
+    // Clean up previously created id
+    if (m_textureId != 0)
+    {
+        glDeleteTextures(1, &m_textureId);
+    }
+
+    m_textureId = textureId;
+    m_colorFormat = array.getColorFormat();
+    m_width = array.getWidth();
+    m_height = array.getHeight();
+    m_levels = array.getLevelCount();
+    m_hasMipmaps = m_levels > 1;
+    m_generateMipmaps = false;
+    m_baseLevel = 0;
+    m_topLevel = 0;
+    m_array = &array;
+    m_layer = layer;
+    m_valid = true;
+    return true;
+}
+
+const TextureArray *Texture::getArray() const { return m_array; }
+
+unsigned int Texture::getLayer() const { return m_layer; }
+
+bool Texture::getFormat(ColorFormat format, GLint &internalFormat, GLenum &externalFormat)
+{
+    switch (format)
+    {
+    case ColorFormat::GreyScale8:
+        internalFormat = GL_R8;
+        externalFormat = GL_RED;
+        break;
+    case ColorFormat::RGB24:
+        internalFormat = GL_RGB8;
+        externalFormat = GL_RGB;
+        break;
+    case ColorFormat::RGBA32:
+        internalFormat = GL_RGBA8;
+        externalFormat = GL_RGBA;
+        break;
+    case ColorFormat::BC1:
+        internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        externalFormat = GL_RGB;
+        break;
+    case ColorFormat::BC3:
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        externalFormat = GL_RGBA;
+        break;
+    case ColorFormat::BC5:
+        internalFormat = GL_COMPRESSED_RG_RGTC2;
+        externalFormat = GL_RG;
+        break;
+    case ColorFormat::BC7:
+        internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+        externalFormat = GL_RGBA;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+bool Texture::setTopLevel(unsigned int topLevel)
+{
+    assert(isValid());
+    if (m_generateMipmaps || m_array != nullptr || topLevel >= m_levels)
+    {
+        return false;
+    }
+    if (topLevel == m_topLevel)
+    {
+        return true;
+    }
+
+    // Keep uploaded levels which are still in storage
+    unsigned int baseLevel = std::max(m_baseLevel, topLevel);
+    GLuint textureId = createStorage(topLevel);
+    for (unsigned int level = baseLevel; level < m_levels; ++level)
+    {
+        glCopyImageSubData(m_textureId, GL_TEXTURE_2D, level - m_topLevel, 0, 0, 0, textureId, GL_TEXTURE_2D,
+                           level - topLevel, 0, 0, 0, getLevelWidth(level), getLevelHeight(level), 1);
+    }
+    glTextureParameteri(textureId, GL_TEXTURE_BASE_LEVEL, (GLint)(baseLevel - topLevel));
+    glDeleteTextures(1, &m_textureId);
+
+    m_textureId = textureId;
+    m_topLevel = topLevel;
+    m_baseLevel = baseLevel;
+    return true;
+}
+
+unsigned int Texture::getTopLevel() const { return m_topLevel; }
+
+std::size_t Texture::getStorageSize() const
+{
+    return getImageSize(m_colorFormat, getLevelWidth(m_topLevel), getLevelHeight(m_topLevel), m_levels - m_topLevel);
+}
+
+std::size_t Texture::getGpuSize() const
+{
+    if (!m_valid || m_array != nullptr)
+    {
+        return 0;
+    }
+    if (m_colorFormat != ColorFormat::Invalid)
+    {
+        return getStorageSize();
+    }
+
+    std::size_t size = 0;
+    for (unsigned int level = m_topLevel; level < m_levels; ++level)
+    {
+        size += (std::size_t)getLevelWidth(level) * getLevelHeight(level) * getPixelSize(m_format);
+    }
+    return size;
+}
+
+std::size_t Texture::getPixelSize(GLint internalFormat)
+{
+    // Drivers pad three component and 24 bit formats to four bytes per component group
+    switch (internalFormat)
+    {
+    case GL_R8:
+        return 1;
+    case GL_RG8:
+    case GL_R16F:
+        return 2;
+    case GL_RGB:
+    case GL_RGB8:
+    case GL_RGBA:
+    case GL_RGBA8:
+    case GL_RG16F:
+    case GL_R32F:
+    case GL_DEPTH_COMPONENT:
+    case GL_DEPTH_COMPONENT24:
+    case GL_DEPTH_COMPONENT32F:
+    case GL_DEPTH24_STENCIL8:
+        return 4;
+    case GL_RGB16F:
+    case GL_RGBA16F:
+    case GL_RG32F:
+        return 8;
+    case GL_RGB32F:
+    case GL_RGBA32F:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+void Texture::requestScreenSize(float pixels) const { m_requestedScreenSize = std::max(m_requestedScreenSize, pixels); }
+
+float Texture::fetchRequestedScreenSize()
+{
+    float pixels = m_requestedScreenSize;
+    m_requestedScreenSize = 0.f;
+    return pixels;
+}
+
+GLuint Texture::createStorage(unsigned int topLevel) const
+{
+    GLuint textureId = 0;
+    glCreateTextures(GL_TEXTURE_2D, 1, &textureId);
+    glTextureStorage2D(textureId, m_levels - topLevel, m_format, getLevelWidth(topLevel), getLevelHeight(topLevel));
+
+    // Filters, trilinear only with a mip chain
+    glTextureParameteri(textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(textureId, GL_TEXTURE_MIN_FILTER, m_levels > 1 ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_R, GL_MIRRORED_REPEAT);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+    return textureId;
+}
+
+void Texture::setLevelData(unsigned int level, const void *data, std::size_t size)
+{
+    setLevelData(level, 0, getLevelHeight(level), data, size);
+}
+
+void Texture::setLevelData(unsigned int level, unsigned int y, unsigned int height, const void *data,
+                           std::size_t size)
+{
+    assert(isValid() && level >= m_topLevel && level < m_levels);
+    assert(y + height <= getLevelHeight(level) && (!isCompressed(m_colorFormat) || y % 4 == 0));
+    // Rows of small uncompressed levels are not 4 byte aligned
+    GLint unpackAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (isCompressed(m_colorFormat))
+    {
+        glCompressedTextureSubImage2D(m_textureId, level - m_topLevel, 0, y, getLevelWidth(level), height, m_format,
+                                      (GLsizei)size, data);
+    }
+    else
+    {
+        glTextureSubImage2D(m_textureId, level - m_topLevel, 0, y, getLevelWidth(level), height, m_externalFormat,
+                            GL_UNSIGNED_BYTE, data);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+}
+
+void Texture::generateMipmaps()
+{
+    assert(isValid());
+    glGenerateTextureMipmap(m_textureId);
+}
+
+void Texture::setBaseLevel(unsigned int level)
+{
+    assert(isValid() && level >= m_topLevel && level < m_levels);
+    glTextureParameteri(m_textureId, GL_TEXTURE_BASE_LEVEL, (GLint)(level - m_topLevel));
+    m_baseLevel = level;
+}
+
+unsigned int Texture::getBaseLevel() const { return m_baseLevel; }
+
+unsigned int Texture::getLevelCount() const { return m_levels; }
+
+bool Texture::generatesMipmaps() const { return m_generateMipmaps; }
+
+unsigned int Texture::getLevelWidth(unsigned int level) const { return std::max(m_width >> level, 1u); }
+
+unsigned int Texture::getLevelHeight(unsigned int level) const { return std::max(m_height >> level, 1u); }
+
+ColorFormat Texture::getColorFormat() const { return m_colorFormat; }
+
 void Texture::resize(unsigned int width, unsigned int height)
 {
     // TODO Remove resizing functionality
@@ -101,6 +446,7 @@ void Texture::setActive(GLint textureUnit) const
 {
     assert(isValid());
     glBindTextureUnit(textureUnit, m_textureId);
+    ++getRenderStats().textureBinds;
 }
 
 void Texture::saveAsPng(const std::string &file)
@@ -247,6 +593,10 @@ bool Texture::init(const std::vector<unsigned char> &image, unsigned int width,
     m_textureId = textureId;
     m_width = width;
     m_height = height;
+    m_levels = levels;
+    m_topLevel = 0;
+    m_array = nullptr;
+    m_layer = 0;
     m_valid = true;
     return true;
 }
@@ -255,3 +605,4 @@ void Texture::setParameter(GLenum parameterName, GLint value)
 {
     glTextureParameteri(m_textureId, parameterName, value);
 }
+
@@ -0,0 +1,116 @@
+#include "kern/graphics/resource/TextureArray.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <fmtlog/fmtlog.h>
+
+#include "kern/graphics/renderer/RenderStats.h"
+#include "kern/graphics/resource/Texture.h"
+
+TextureArray::TextureArray(ColorFormat format, unsigned int width, unsigned int height, unsigned int levels)
+    : m_colorFormat(format), m_width(width), m_height(height), m_levels(levels)
+{
+    if (!Texture::getFormat(format, m_format, m_externalFormat))
+    {
+        loge("Unsupported color format for texture array.");
+    }
+}
+
+TextureArray::~TextureArray()
+{
+    if (m_textureId != 0)
+    {
+        glDeleteTextures(1, &m_textureId);
+    }
+}
+
+bool TextureArray::reserve(unsigned int layers)
+{
+    if (layers <= m_capacity)
+    {
+        return true;
+    }
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (m_format == 0 || layers > (unsigned int)maxLayers)
+    {
+        return false;
+    }
+
+    GLuint textureId = 0;
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &textureId);
+    glTextureStorage3D(textureId, m_levels, m_format, m_width, m_height, layers);
+
+    // Same filters as single textures, trilinear only with a mip chain
+    glTextureParameteri(textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(textureId, GL_TEXTURE_MIN_FILTER, m_levels > 1 ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_R, GL_MIRRORED_REPEAT);
+    glTextureParameteri(textureId, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+
+    // Copy all levels of the existing layers
+    if (m_textureId != 0)
+    {
+        for (unsigned int level = 0; level < m_levels; ++level)
+        {
+            glCopyImageSubData(m_textureId, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, textureId, GL_TEXTURE_2D_ARRAY,
+                               level, 0, 0, 0, std::max(m_width >> level, 1u), std::max(m_height >> level, 1u),
+                               m_capacity);
+        }
+        glDeleteTextures(1, &m_textureId);
+    }
+
+    m_textureId = textureId;
+    m_capacity = layers;
+    return true;
+}
+
+unsigned int TextureArray::getCapacity() const { return m_capacity; }
+
+std::size_t TextureArray::getGpuSize() const
+{
+    return getImageSize(m_colorFormat, m_width, m_height, m_levels) * m_capacity;
+}
+
+void TextureArray::setLayerData(unsigned int layer, unsigned int level, const void *data, std::size_t size)
+{
+    assert(m_textureId != 0 && layer < m_capacity && level < m_levels);
+    unsigned int width = std::max(m_width >> level, 1u);
+    unsigned int height = std::max(m_height >> level, 1u);
+
+    // Rows of small uncompressed levels are not 4 byte aligned
+    GLint unpackAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (isCompressed(m_colorFormat))
+    {
+        glCompressedTextureSubImage3D(m_textureId, level, 0, 0, layer, width, height, 1, m_format, (GLsizei)size,
+                                      data);
+    }
+    else
+    {
+        glTextureSubImage3D(m_textureId, level, 0, 0, layer, width, height, 1, m_externalFormat, GL_UNSIGNED_BYTE,
+                            data);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+}
+
+ColorFormat TextureArray::getColorFormat() const { return m_colorFormat; }
+
+unsigned int TextureArray::getWidth() const { return m_width; }
+
+unsigned int TextureArray::getHeight() const { return m_height; }
+
+unsigned int TextureArray::getLevelCount() const { return m_levels; }
+
+GLint TextureArray::getInternalFormat() const { return m_format; }
+
+GLuint TextureArray::getId() const { return m_textureId; }
+
+void TextureArray::setActive(GLint textureUnit) const
+{
+    assert(m_textureId != 0);
+    glBindTextureUnit(textureUnit, m_textureId);
+    ++getRenderStats().textureBinds;
+}
@@ -0,0 +1,128 @@
+#include "kern/graphics/resource/TexturePacker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <fmtlog/fmtlog.h>
+
+#include "kern/graphics/resource/Texture.h"
+
+// Layers of a new array, grows by doubling
+const unsigned int initialLayerCount = 8;
+
+TexturePacker::TexturePacker(unsigned int maxSize) : m_maxSize(maxSize) {}
+
+bool TexturePacker::add(Texture *texture, const Image &image)
+{
+    if (image.m_width == 0 || image.m_height == 0 || image.m_levels == 0 ||
+        std::max(image.m_width, image.m_height) > m_maxSize ||
+        image.m_data.size() != getImageSize(image.m_format, image.m_width, image.m_height, image.m_levels))
+    {
+        return false;
+    }
+
+    // Uncompressed single level images get a full chain like single textures
+    bool generateMipmaps = image.m_levels == 1 && !isCompressed(image.m_format);
+    unsigned int levels = image.m_levels;
+    if (generateMipmaps)
+    {
+        levels = (unsigned int)std::floor(std::log2(std::max(image.m_width, image.m_height))) + 1;
+    }
+
+    SArray *entry = nullptr;
+    unsigned int layer = 0;
+    if (!allocateLayer(image.m_format, image.m_width, image.m_height, levels, entry, layer) ||
+        !texture->initView(*entry->array, layer))
+    {
+        return false;
+    }
+    entry->layers[layer] = texture;
+
+    // Synchronous upload, levels are generated on the view to only touch this layer
+    const unsigned char *data = image.m_data.data();
+    for (unsigned int level = 0; level < image.m_levels; ++level)
+    {
+        std::size_t size = getImageSize(image.m_format, texture->getLevelWidth(level), texture->getLevelHeight(level));
+        entry->array->setLayerData(layer, level, data, size);
+        data += size;
+    }
+    if (generateMipmaps && levels > 1)
+    {
+        texture->generateMipmaps();
+    }
+    return true;
+}
+
+void TexturePacker::remove(const Texture *texture)
+{
+    for (auto &entry : m_arrays)
+    {
+        std::replace(entry.layers.begin(), entry.layers.end(), const_cast<Texture *>(texture), (Texture *)nullptr);
+    }
+}
+
+std::size_t TexturePacker::getArrayCount() const { return m_arrays.size(); }
+
+std::size_t TexturePacker::getGpuSize() const
+{
+    std::size_t size = 0;
+    for (const auto &entry : m_arrays)
+    {
+        size += entry.array->getGpuSize();
+    }
+    return size;
+}
+
+bool TexturePacker::allocateLayer(ColorFormat format, unsigned int width, unsigned int height, unsigned int levels,
+                                  SArray *&result, unsigned int &layer)
+{
+    for (auto &entry : m_arrays)
+    {
+        const TextureArray &array = *entry.array;
+        if (array.getColorFormat() != format || array.getWidth() != width || array.getHeight() != height ||
+            array.getLevelCount() != levels)
+        {
+            continue;
+        }
+
+        // Reuse free layers first
+        auto iter = std::find(entry.layers.begin(), entry.layers.end(), nullptr);
+        if (iter != entry.layers.end())
+        {
+            result = &entry;
+            layer = (unsigned int)(iter - entry.layers.begin());
+            return true;
+        }
+
+        // Grow the array, views of the old storage are recreated
+        unsigned int capacity = array.getCapacity();
+        if (entry.array->reserve(capacity * 2))
+        {
+            for (unsigned int i = 0; i < capacity; ++i)
+            {
+                if (entry.layers[i] != nullptr)
+                {
+                    entry.layers[i]->initView(array, i);
+                }
+            }
+            entry.layers.resize(array.getCapacity(), nullptr);
+            result = &entry;
+            layer = capacity;
+            return true;
+        }
+    }
+
+    // New array, also if the existing ones reached the layer limit
+    SArray entry;
+    entry.array.reset(new TextureArray(format, width, height, levels));
+    if (!entry.array->reserve(initialLayerCount))
+    {
+        logw("Failed to create texture array of size {}x{}.", width, height);
+        return false;
+    }
+    entry.layers.resize(entry.array->getCapacity(), nullptr);
+    m_arrays.push_back(std::move(entry));
+    result = &m_arrays.back();
+    layer = 0;
+    return true;
+}
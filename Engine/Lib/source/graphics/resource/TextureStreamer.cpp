@@ -0,0 +1,197 @@
+#include "kern/graphics/resource/TextureStreamer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "kern/graphics/ICamera.h"
+#include "kern/graphics/collision/BoundingSphere.h"
+#include "kern/graphics/resource/Texture.h"
+#include "kern/graphics/resource/TextureUploader.h"
+
+// Levels up to this size in pixels are always resident
+const unsigned int tailSize = 64;
+// Frames until levels which are not requested anymore are dropped
+const unsigned int dropDelay = 120;
+
+float getProjectedSize(const BoundingSphere &sphere, const glm::vec3 &position, const glm::quat &rotation,
+                       const glm::vec3 &scale, const ICamera &camera, unsigned int screenHeight)
+{
+    glm::vec3 absScale = glm::abs(scale);
+    float radius = sphere.getRadius() * std::max(std::max(absScale.x, absScale.y), absScale.z);
+    glm::vec3 center = position + rotation * (sphere.getPosition() * scale);
+    float distance = glm::length(center - camera.getPosition());
+    if (distance <= radius)
+    {
+        // Camera inside the bounds
+        return std::numeric_limits<float>::max();
+    }
+    // Projection scales by the cotangent of the half vertical field of view
+    return radius / distance * camera.getProjection()[1][1] * (float)screenHeight;
+}
+
+TextureStreamer::TextureStreamer(TextureUploader &uploader, std::size_t budget) : m_uploader(uploader), m_budget(budget)
+{
+    // empty
+}
+
+void TextureStreamer::setBudget(std::size_t budget) { m_budget = budget; }
+
+std::size_t TextureStreamer::getBudget() const { return m_budget; }
+
+std::size_t TextureStreamer::getResidentSize() const
+{
+    std::size_t size = 0;
+    for (const auto &entry : m_entries)
+    {
+        size += entry.texture->getStorageSize();
+    }
+    return size;
+}
+
+bool TextureStreamer::add(Texture *texture, Image image)
+{
+    assert(texture != nullptr);
+    remove(texture);
+    if (image.m_levels <= 1)
+    {
+        return false;
+    }
+
+    SEntry entry;
+    entry.texture = texture;
+    entry.image = std::make_shared<const Image>(std::move(image));
+    const Image &source = *entry.image;
+    while (entry.tailLevel + 1 < source.m_levels &&
+           std::max(source.m_width >> entry.tailLevel, source.m_height >> entry.tailLevel) > tailSize)
+    {
+        ++entry.tailLevel;
+    }
+    entry.targetLevel = entry.tailLevel;
+
+    if (!texture->initStorage(source, entry.tailLevel))
+    {
+        return false;
+    }
+    m_uploader.enqueue(texture, entry.image, entry.tailLevel, source.m_levels);
+    m_entries.push_back(entry);
+    return true;
+}
+
+void TextureStreamer::remove(Texture *texture)
+{
+    auto iter = std::find_if(m_entries.begin(), m_entries.end(),
+                             [texture](const SEntry &entry) { return entry.texture == texture; });
+    if (iter != m_entries.end())
+    {
+        m_uploader.cancel(texture);
+        m_entries.erase(iter);
+    }
+}
+
+void TextureStreamer::update()
+{
+    // Select levels from the requests
+    for (auto &entry : m_entries)
+    {
+        entry.screenSize = entry.texture->fetchRequestedScreenSize();
+        unsigned int level = entry.tailLevel;
+        if (entry.screenSize > 0.f)
+        {
+            // Finest level needed for a texel per pixel
+            float texels = (float)std::max(entry.image->m_width, entry.image->m_height);
+            level = texels <= entry.screenSize ? 0 : (unsigned int)std::floor(std::log2(texels / entry.screenSize));
+            level = std::min(level, entry.tailLevel);
+        }
+
+        if (level < entry.targetLevel)
+        {
+            entry.targetLevel = level;
+            entry.unusedFrames = 0;
+        }
+        else if (level > entry.targetLevel)
+        {
+            // Delay dropping to avoid streaming the same levels in and out
+            ++entry.unusedFrames;
+            if (entry.unusedFrames > dropDelay)
+            {
+                entry.targetLevel = level;
+                entry.unusedFrames = 0;
+            }
+        }
+        else
+        {
+            entry.unusedFrames = 0;
+        }
+    }
+
+    applyBudget();
+
+    // Reallocate storage and stream in missing levels
+    for (auto &entry : m_entries)
+    {
+        Texture *texture = entry.texture;
+        if (entry.targetLevel == texture->getTopLevel())
+        {
+            continue;
+        }
+        texture->setTopLevel(entry.targetLevel);
+        if (texture->getBaseLevel() > entry.targetLevel)
+        {
+            m_uploader.enqueue(texture, entry.image, entry.targetLevel, texture->getBaseLevel());
+        }
+        else
+        {
+            m_uploader.cancel(texture);
+        }
+    }
+}
+
+std::size_t TextureStreamer::getStorageSize(const SEntry &entry, unsigned int topLevel)
+{
+    const Image &image = *entry.image;
+    return getImageSize(image.m_format, std::max(image.m_width >> topLevel, 1u),
+                        std::max(image.m_height >> topLevel, 1u), image.m_levels - topLevel);
+}
+
+void TextureStreamer::applyBudget()
+{
+    std::size_t size = 0;
+    for (const auto &entry : m_entries)
+    {
+        size += getStorageSize(entry, entry.targetLevel);
+    }
+    if (size <= m_budget)
+    {
+        return;
+    }
+
+    // Coarsen the textures with the smallest screen size first, one level per pass
+    std::vector<SEntry *> order;
+    for (auto &entry : m_entries)
+    {
+        order.push_back(&entry);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const SEntry *a, const SEntry *b) { return a->screenSize < b->screenSize; });
+    bool changed = true;
+    while (size > m_budget && changed)
+    {
+        changed = false;
+        for (SEntry *entry : order)
+        {
+            if (entry->targetLevel < entry->tailLevel)
+            {
+                size -= getStorageSize(*entry, entry->targetLevel);
+                ++entry->targetLevel;
+                size += getStorageSize(*entry, entry->targetLevel);
+                changed = true;
+                if (size <= m_budget)
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
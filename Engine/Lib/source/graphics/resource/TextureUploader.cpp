@@ -0,0 +1,187 @@
+#include "kern/graphics/resource/TextureUploader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <fmtlog/fmtlog.h>
+
+#include "kern/graphics/resource/Texture.h"
+
+// Level offsets in the ring are aligned for block compressed data
+const std::size_t uploadAlignment = 16;
+
+TextureUploader::TextureUploader(std::size_t frameBudget, unsigned int framesInFlight)
+    : m_frameBudget(frameBudget), m_framesInFlight(std::max(framesInFlight, 1u)), m_fences(m_framesInFlight, nullptr)
+{
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    std::size_t size = m_frameBudget * m_framesInFlight;
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, size, nullptr, flags);
+    m_mapped = (unsigned char *)glMapNamedBufferRange(m_buffer, 0, size, flags);
+    if (m_mapped == nullptr)
+    {
+        loge("Failed to map texture upload buffer, uploading from client memory.");
+    }
+}
+
+TextureUploader::~TextureUploader()
+{
+    for (GLsync fence : m_fences)
+    {
+        if (fence != nullptr)
+        {
+            glDeleteSync(fence);
+        }
+    }
+    if (m_mapped != nullptr)
+    {
+        glUnmapNamedBuffer(m_buffer);
+    }
+    glDeleteBuffers(1, &m_buffer);
+}
+
+void TextureUploader::enqueue(Texture *texture, Image image)
+{
+    unsigned int levels = image.m_levels;
+    enqueue(texture, std::make_shared<const Image>(std::move(image)), 0, levels);
+}
+
+void TextureUploader::enqueue(Texture *texture, const std::shared_ptr<const Image> &image, unsigned int beginLevel,
+                              unsigned int endLevel)
+{
+    assert(texture != nullptr && texture->isValid());
+    assert(beginLevel >= texture->getTopLevel() && endLevel <= image->m_levels);
+    cancel(texture);
+
+    // Coarsest level first, the stable sort keeps this order for levels of equal size
+    std::size_t offset = getImageSize(image->m_format, image->m_width, image->m_height, endLevel);
+    for (unsigned int level = endLevel; level-- > beginLevel;)
+    {
+        SUpload upload;
+        upload.texture = texture;
+        upload.image = image;
+        upload.level = level;
+        upload.size = getImageSize(image->m_format, texture->getLevelWidth(level), texture->getLevelHeight(level));
+        offset -= upload.size;
+        upload.offset = offset;
+        m_pendingBytes += upload.size;
+        m_pending.push_back(upload);
+    }
+    std::stable_sort(m_pending.begin(), m_pending.end(),
+                     [](const SUpload &a, const SUpload &b) { return a.size < b.size; });
+}
+
+void TextureUploader::cancel(const Texture *texture)
+{
+    auto iter = std::remove_if(m_pending.begin(), m_pending.end(),
+                               [texture](const SUpload &upload) { return upload.texture == texture; });
+    for (auto removed = iter; removed != m_pending.end(); ++removed)
+    {
+        m_pendingBytes -= removed->size;
+    }
+    m_pending.erase(iter, m_pending.end());
+}
+
+void TextureUploader::update()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    // Wait for the GPU to consume the uploads from the last use of this slot, usually signaled already
+    GLsync &fence = m_fences[m_slot];
+    if (fence != nullptr)
+    {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    std::size_t slotOffset = m_slot * m_frameBudget;
+    std::size_t used = 0;
+    std::size_t uploaded = 0;
+    bool usedBuffer = false;
+    while (uploaded < m_pending.size())
+    {
+        SUpload &upload = m_pending[uploaded];
+        const unsigned char *data = upload.image->m_data.data() + upload.offset;
+        std::size_t offset = (used + uploadAlignment - 1) / uploadAlignment * uploadAlignment;
+        ColorFormat format = upload.image->m_format;
+        unsigned int width = upload.texture->getLevelWidth(upload.level);
+        unsigned int rows = upload.texture->getLevelHeight(upload.level) - upload.row;
+        std::size_t size = upload.size;
+
+        // Levels larger than a slot are split into bands of rows, compressed formats at block rows
+        unsigned int bandRows = isCompressed(format) ? 4 : 1;
+        std::size_t bandSize = getImageSize(format, width, bandRows);
+        if (m_mapped == nullptr || bandSize > m_frameBudget)
+        {
+            // Does not fit into a slot, upload alone from client memory
+            if (used > 0)
+            {
+                break;
+            }
+            upload.texture->setLevelData(upload.level, upload.row, rows, data, size);
+            used = m_frameBudget;
+        }
+        else
+        {
+            if (size > m_frameBudget && offset < m_frameBudget)
+            {
+                // Fill the slot, the next frames continue with the remaining rows
+                std::size_t bands = (m_frameBudget - offset) / bandSize;
+                rows = (unsigned int)std::min<std::size_t>(rows, bands * bandRows);
+                size = getImageSize(format, width, rows);
+            }
+            if (rows == 0 || offset + size > m_frameBudget)
+            {
+                break;
+            }
+            std::memcpy(m_mapped + slotOffset + offset, data, size);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffer);
+            upload.texture->setLevelData(upload.level, upload.row, rows, (const void *)(slotOffset + offset), size);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            used = offset + size;
+            usedBuffer = true;
+        }
+
+        m_pendingBytes -= size;
+        upload.row += rows;
+        upload.offset += size;
+        upload.size -= size;
+        if (upload.size > 0)
+        {
+            // Slot is full
+            break;
+        }
+        finishUpload(upload);
+        ++uploaded;
+    }
+    m_pending.erase(m_pending.begin(), m_pending.begin() + uploaded);
+
+    if (usedBuffer)
+    {
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_slot = (m_slot + 1) % m_framesInFlight;
+    }
+}
+
+std::size_t TextureUploader::getPendingBytes() const { return m_pendingBytes; }
+
+void TextureUploader::finishUpload(const SUpload &upload)
+{
+    Texture *texture = upload.texture;
+    if (texture->generatesMipmaps())
+    {
+        // Level 0 is the only stored level
+        texture->generateMipmaps();
+        texture->setBaseLevel(0);
+    }
+    else if (upload.level < texture->getBaseLevel())
+    {
+        // All coarser levels are uploaded already
+        texture->setBaseLevel(upload.level);
+    }
+}
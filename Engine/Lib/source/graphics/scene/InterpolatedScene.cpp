@@ -0,0 +1,203 @@
+#include "kern/graphics/scene/InterpolatedScene.h"
+
+InterpolatedScene::InterpolatedScene(IScene &scene) : m_scene(scene) {}
+
+SceneObjectId InterpolatedScene::createObject(ResourceId model, const glm::vec3 &position,
+                                              const glm::quat &rotation, const glm::vec3 &scale)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SceneObjectId id = m_scene.createObject(model, position, rotation, scale);
+    addObject(id);
+    return id;
+}
+
+SceneObjectId InterpolatedScene::createObject(ResourceId mesh, ResourceId material, const glm::vec3 &position,
+                                              const glm::quat &rotation, const glm::vec3 &scale)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SceneObjectId id = m_scene.createObject(mesh, material, position, rotation, scale);
+    addObject(id);
+    return id;
+}
+
+bool InterpolatedScene::getObject(SceneObjectId id, ResourceId &mesh, ResourceId &material, glm::vec3 &position,
+                                  glm::quat &rotation, glm::vec3 &scale, bool &visible) const
+{
+    if (id < 0 || ((unsigned int)id) >= m_objects.size())
+    {
+        return false;
+    }
+
+    const SObjectState &object = m_objects[id];
+    mesh = object.mesh;
+    material = object.material;
+    position = object.position;
+    rotation = object.rotation;
+    scale = object.scale;
+    visible = object.visible;
+    return true;
+}
+
+void InterpolatedScene::setObject(SceneObjectId id, ResourceId mesh, ResourceId material,
+                                  const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale,
+                                  bool visible)
+{
+    if (id < 0 || ((unsigned int)id) >= m_objects.size())
+    {
+        return;
+    }
+
+    // Only recorded, the render thread sees the change after the next publish
+    SObjectState &object = m_objects[id];
+    object.mesh = mesh;
+    object.material = material;
+    object.position = position;
+    object.rotation = rotation;
+    object.scale = scale;
+    object.visible = visible;
+}
+
+SceneObjectId InterpolatedScene::createPointLight(const glm::vec3 &position, float radius, const glm::vec3 &color,
+                                                  float intensity, bool castsShadow)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_scene.createPointLight(position, radius, color, intensity, castsShadow);
+}
+
+bool InterpolatedScene::getPointLight(SceneObjectId id, glm::vec3 &position, float &radius, glm::vec3 &color,
+                                      float &intensity, bool &castsShadow) const
+{
+    // No lock, only the simulation thread changes lights and the render thread reads them with the mutex locked
+    return m_scene.getPointLight(id, position, radius, color, intensity, castsShadow);
+}
+
+void InterpolatedScene::setPointLight(SceneObjectId id, const glm::vec3 &position, float radius,
+                                      const glm::vec3 &color, float intensity, bool castsShadow)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scene.setPointLight(id, position, radius, color, intensity, castsShadow);
+}
+
+SceneObjectId InterpolatedScene::createDirectionalLight(const glm::vec3 &direction, const glm::vec3 &color,
+                                                        float intensity, bool castsShadow)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_scene.createDirectionalLight(direction, color, intensity, castsShadow);
+}
+
+bool InterpolatedScene::getDirectionalLight(SceneObjectId id, glm::vec3 &direction, glm::vec3 &color,
+                                            float &intensity, bool &castsShadow) const
+{
+    return m_scene.getDirectionalLight(id, direction, color, intensity, castsShadow);
+}
+
+void InterpolatedScene::setDirectionalLight(SceneObjectId id, const glm::vec3 &direction, const glm::vec3 &color,
+                                            float intensity, bool castsShadow)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scene.setDirectionalLight(id, direction, color, intensity, castsShadow);
+}
+
+void InterpolatedScene::setAmbientLight(const glm::vec3 &color, float intensity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scene.setAmbientLight(color, intensity);
+}
+
+bool InterpolatedScene::getAmbientLight(glm::vec3 &color, float &intensity) const
+{
+    return m_scene.getAmbientLight(color, intensity);
+}
+
+void InterpolatedScene::setOccluder(SceneObjectId id, const std::vector<float> &vertices,
+                                    const std::vector<unsigned int> &indices)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scene.setOccluder(id, vertices, indices);
+}
+
+void InterpolatedScene::getVisibleObjects(const ICamera &camera, ISceneQuery &query) const
+{
+    m_scene.getVisibleObjects(camera, query);
+}
+
+void InterpolatedScene::getVisibleLights(const ICamera &camera, ISceneQuery &query) const
+{
+    m_scene.getVisibleLights(camera, query);
+}
+
+unsigned int InterpolatedScene::getVisibleObjects(const SCullingView *views, std::size_t viewCount,
+                                                  ISceneQuery *const *queries) const
+{
+    return m_scene.getVisibleObjects(views, viewCount, queries);
+}
+
+void InterpolatedScene::publish()
+{
+    // Copy outside of the lock, the render thread only waits for the swap
+    // The pair always holds two consecutive ticks, also if the render thread skips snapshots
+    m_publishPrevious = m_published;
+    m_published = m_objects;
+    m_publish = m_objects;
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_pendingPrevious.swap(m_publishPrevious);
+    m_pending.swap(m_publish);
+    m_hasPending = true;
+}
+
+void InterpolatedScene::apply(float alpha)
+{
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        if (m_hasPending)
+        {
+            // Storage of the taken snapshots is reused by the next publish
+            m_previous.swap(m_pendingPrevious);
+            m_current.swap(m_pending);
+            m_hasPending = false;
+            changed = true;
+        }
+    }
+
+    alpha = glm::clamp(alpha, 0.f, 1.f);
+    for (std::size_t i = 0; i < m_current.size(); ++i)
+    {
+        const SObjectState &current = m_current[i];
+        bool moving = i < m_previous.size() && (m_previous[i].position != current.position ||
+                                                m_previous[i].rotation != current.rotation ||
+                                                m_previous[i].scale != current.scale);
+        if (moving)
+        {
+            const SObjectState &previous = m_previous[i];
+            m_scene.setObject((SceneObjectId)i, current.mesh, current.material,
+                              glm::mix(previous.position, current.position, alpha),
+                              glm::slerp(previous.rotation, current.rotation, alpha),
+                              glm::mix(previous.scale, current.scale, alpha), current.visible);
+        }
+        else if (changed)
+        {
+            // Resting objects only need the newest state once
+            m_scene.setObject((SceneObjectId)i, current.mesh, current.material, current.position, current.rotation,
+                              current.scale, current.visible);
+        }
+    }
+}
+
+std::mutex &InterpolatedScene::getMutex() { return m_mutex; }
+
+void InterpolatedScene::addObject(SceneObjectId id)
+{
+    if (id < 0)
+    {
+        return;
+    }
+    if (((unsigned int)id) >= m_objects.size())
+    {
+        m_objects.resize(id + 1);
+    }
+
+    SObjectState &object = m_objects[id];
+    m_scene.getObject(id, object.mesh, object.material, object.position, object.rotation, object.scale,
+                      object.visible);
+}
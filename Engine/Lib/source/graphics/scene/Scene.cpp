@@ -2,9 +2,13 @@
 
 #include <fmtlog/fmtlog.h>
 
+#include <algorithm>
+
+#include "kern/foundation/Transformer.h"
 #include "kern/graphics/ICamera.h"
 #include "kern/graphics/IGraphicsResourceManager.h"
 #include "kern/graphics/collision/Frustum.h"
+#include "kern/graphics/collision/FrustumCulling.h"
 #include "kern/graphics/resource/Mesh.h"
 #include "kern/graphics/scene/SceneDirectionalLight.h"
 #include "kern/graphics/scene/SceneObject.h"
@@ -17,7 +21,16 @@ void Scene::setViewFrustumCulling(bool enable) { s_useViewFrustumCulling = enabl
 
 bool Scene::s_useViewFrustumCulling = true;
 
-Scene::Scene(const IGraphicsResourceManager *manager) : m_resourceManager(manager) {}
+bool Scene::getOcclusionCulling() { return s_useOcclusionCulling; }
+
+void Scene::setOcclusionCulling(bool enable) { s_useOcclusionCulling = enable; }
+
+bool Scene::s_useOcclusionCulling = true;
+
+Scene::Scene(const IGraphicsResourceManager *manager, JobSystem &jobs)
+    : m_occlusionBuffer(jobs), m_resourceManager(manager)
+{
+}
 
 Scene::~Scene() {}
 
@@ -26,6 +39,8 @@ SceneObjectId Scene::createObject(ResourceId model, const glm::vec3 &position, c
 {
     // const Mesh* meshPtr = m_resourceManager->getMesh(meshId);
     m_objects.push_back(SceneObject(model, position, rotation, scale, true, BoundingSphere()));
+    m_objectBounds.resize(m_objects.size());
+    m_objectBounds.set(m_objects.size() - 1, m_objects.back().boundingSphere);
     return (SceneObjectId)m_objects.size() - 1;
 }
 
@@ -34,6 +49,8 @@ SceneObjectId Scene::createObject(ResourceId meshId, ResourceId material, const
 {
     const Mesh *meshPtr = m_resourceManager->getMesh(meshId);
     m_objects.push_back(SceneObject(meshId, material, position, rotation, scale, true, meshPtr->getBoundingSphere()));
+    m_objectBounds.resize(m_objects.size());
+    m_objectBounds.set(m_objects.size() - 1, m_objects.back().boundingSphere);
     return (SceneObjectId)m_objects.size() - 1;
 }
 
@@ -64,10 +81,42 @@ void Scene::setObject(SceneObjectId id, ResourceId meshId, ResourceId material,
     unsigned int index = (unsigned int)id;
     // Write data
     const Mesh *meshPtr = m_resourceManager->getMesh(meshId);
+    if (m_objects[index].m_visible && !visible)
+    {
+        ++m_hiddenObjectCount;
+    }
+    else if (!m_objects[index].m_visible && visible)
+    {
+        --m_hiddenObjectCount;
+    }
     m_objects[index] = SceneObject(meshId, material, position, rotation, scale, visible, meshPtr->getBoundingSphere());
+    m_objectBounds.set(index, m_objects[index].boundingSphere);
     return;
 }
 
+void Scene::setOccluder(SceneObjectId id, const std::vector<float> &vertices, const std::vector<unsigned int> &indices)
+{
+    assert(id >= 0 && ((unsigned int)id) < m_objects.size() && "Invalid scene object id");
+    auto iter = std::find_if(m_occluders.begin(), m_occluders.end(),
+                             [id](const SOccluder &occluder) { return occluder.object == id; });
+    if (vertices.empty())
+    {
+        if (iter != m_occluders.end())
+        {
+            m_occluders.erase(iter);
+        }
+        return;
+    }
+    if (iter == m_occluders.end())
+    {
+        m_occluders.push_back(SOccluder());
+        iter = m_occluders.end() - 1;
+    }
+    iter->object = id;
+    iter->vertices = vertices;
+    iter->indices = indices;
+}
+
 SceneObjectId Scene::createPointLight(const glm::vec3 &position, float radius, const glm::vec3 &color, float intensity,
                                       bool castsShadow)
 {
@@ -161,36 +210,25 @@ bool Scene::getAmbientLight(glm::vec3 &color, float &intensity) const
 
 void Scene::getVisibleObjects(const ICamera &camera, ISceneQuery &query) const
 {
-    // Create frustum from camera matrices
-    Frustum viewFrustum;
-    viewFrustum.setFromViewProjectionClipSpaceApproach(camera.getView(), camera.getProjection());
+    // Frustum and occlusion culling from camera matrices
+    SCullingView view(camera.getView(), camera.getProjection());
 
     // Hackyyy
-    int culledObjectCount = 0;
+    ISceneQuery *queries[] = {&query};
+    camera.getFeatureInfo().culledObjectCount = getVisibleObjects(&view, 1, queries);
 
+    getVisibleLights(camera, query);
+    return;
+}
+
+void Scene::getVisibleLights(const ICamera &camera, ISceneQuery &query) const
+{
     // Do not cull if disabled
     if (s_useViewFrustumCulling)
     {
-        // TODO Occlusion culling, better data structure for objects
-        for (unsigned int i = 0; i < m_objects.size(); ++i)
-        {
-            const auto &object = m_objects.at(i);
-            // Return only objects with visibility flag set
-            if (object.m_visible)
-            {
-                // Check the objects bounding sphere against the view frustum
-                if (viewFrustum.isInsideOrIntersects(object.boundingSphere))
-                {
-                    // Object is (at least partially) visible, add to query result
-                    // Counter variable is object id
-                    query.addObject(i);
-                }
-                else
-                {
-                    ++culledObjectCount;
-                }
-            }
-        }
+        // Create frustum from camera matrices
+        Frustum viewFrustum;
+        viewFrustum.setFromViewProjectionClipSpaceApproach(camera.getView(), camera.getProjection());
 
         // Add visible point Lights
         for (unsigned int i = 0; i < m_pointLights.size(); ++i)
@@ -204,7 +242,6 @@ void Scene::getVisibleObjects(const ICamera &camera, ISceneQuery &query) const
             }
         }
     }
-    camera.getFeatureInfo().culledObjectCount = culledObjectCount;
 
     // TODO Directional light culling?
     // For now add all directional lights
@@ -215,3 +252,98 @@ void Scene::getVisibleObjects(const ICamera &camera, ISceneQuery &query) const
     }
     return;
 }
+
+unsigned int Scene::getVisibleObjects(const SCullingView *views, std::size_t viewCount,
+                                      ISceneQuery *const *queries) const
+{
+    // Do not cull if disabled
+    if (!s_useViewFrustumCulling || viewCount == 0)
+    {
+        return 0;
+    }
+
+    // Occlusion culling of the first view, objects passing the frustum test are tested against the occluder depth
+    bool occlusionCulling = rasterizeOccluders(views[0]);
+    std::size_t candidateCount = m_objects.size() - m_hiddenObjectCount;
+    std::size_t addedObjectCount = 0;
+    if (viewCount == 1 && !views[0].isSphere)
+    {
+        // Single frustum, check all bounding spheres at once and only touch the visible objects
+        m_visibleObjects.resize(m_objects.size());
+        std::size_t count = getVisibleSpheres(views[0].frustum, m_objectBounds, m_visibleObjects.data());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // Return only objects with visibility flag set
+            unsigned int id = m_visibleObjects[i];
+            if (m_objects[id].m_visible &&
+                (!occlusionCulling || m_occlusionBuffer.isVisible(m_objects[id].boundingSphere)))
+            {
+                // Object is (at least partially) visible, add to query result
+                queries[0]->addObject(id);
+                ++addedObjectCount;
+            }
+        }
+        return (unsigned int)(candidateCount - addedObjectCount);
+    }
+
+    // One bit per view and object, a traversal handles up to 32 views
+    m_viewMasks.resize(m_objects.size());
+    for (std::size_t first = 0; first < viewCount; first += maxCullingViewCount)
+    {
+        std::size_t count = std::min(viewCount - first, maxCullingViewCount);
+        getViewMasks(views + first, count, m_objectBounds, m_viewMasks.data());
+        for (unsigned int i = 0; i < m_objects.size(); ++i)
+        {
+            // Return only objects with visibility flag set
+            if (!m_objects[i].m_visible)
+            {
+                continue;
+            }
+            std::uint32_t mask = m_viewMasks[i];
+            if (first == 0 && (mask & 1u) != 0)
+            {
+                if (occlusionCulling && !m_occlusionBuffer.isVisible(m_objects[i].boundingSphere))
+                {
+                    mask &= ~1u;
+                }
+                else
+                {
+                    ++addedObjectCount;
+                }
+            }
+            for (std::size_t view = first; mask != 0; ++view, mask >>= 1)
+            {
+                if ((mask & 1u) != 0)
+                {
+                    queries[view]->addObject(i);
+                }
+            }
+        }
+    }
+    return (unsigned int)(candidateCount - addedObjectCount);
+}
+
+bool Scene::rasterizeOccluders(const SCullingView &view) const
+{
+    if (!s_useOcclusionCulling || m_occluders.empty() || !view.isCamera)
+    {
+        return false;
+    }
+
+    m_occlusionBuffer.begin(view.viewProjection);
+    Transformer transformer;
+    for (const auto &occluder : m_occluders)
+    {
+        // Hidden objects do not occlude
+        const auto &object = m_objects[occluder.object];
+        if (object.m_visible)
+        {
+            transformer.setPosition(object.m_position);
+            transformer.setRotation(object.m_rotation);
+            transformer.setScale(object.m_scale);
+            m_occlusionBuffer.addOccluder(transformer.getModelMatrix(), occluder.vertices, occluder.indices);
+        }
+    }
+    m_occlusionBuffer.rasterize();
+    return true;
+}
@@ -9,6 +9,13 @@ SceneQuery::SceneQuery(unsigned int objectStorage, unsigned int lightStorage)
     m_visiblePointLights.reserve(lightStorage);
 }
 
+SceneQuery::SceneQuery(FrameArena &arena, unsigned int objectStorage, unsigned int lightStorage)
+    : m_visibleObjects(&arena), m_visiblePointLights(&arena), m_visibleDirectionalLights(&arena)
+{
+    m_visibleObjects.reserve(objectStorage);
+    m_visiblePointLights.reserve(lightStorage);
+}
+
 bool SceneQuery::hasNextObject() const { return m_nextObjectIndex < m_visibleObjects.size(); }
 
 SceneObjectId SceneQuery::getNextObject()
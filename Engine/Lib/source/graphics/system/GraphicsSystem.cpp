@@ -11,7 +11,7 @@
 #include "kern/resource/IResourceManager.h"
 #include "kern/graphics/scene/Scene.h"
 
-GraphicsSystem::GraphicsSystem() {}
+GraphicsSystem::GraphicsSystem(JobSystem &jobs) : m_jobs(jobs) {}
 
 GraphicsSystem::~GraphicsSystem() {}
 
@@ -69,7 +69,7 @@ void GraphicsSystem::setActiveRenderer(const std::string &renderer)
 IScene *GraphicsSystem::createScene()
 {
     // TODO Refactor
-    IScene *scene = new Scene(m_resourceManager.get());
+    IScene *scene = new Scene(m_resourceManager.get(), m_jobs);
     m_scenes.push_back(std::unique_ptr<IScene>(scene));
     return scene;
 }
@@ -157,6 +157,9 @@ void GraphicsSystem::draw(Window &window)
     // Update frame count
     ++m_currentFrameCount;
 
+    // Stream pending texture data
+    m_resourceManager->update();
+
     // Scene draw
     if (m_activeScene != nullptr && m_activeCamera != nullptr)
     {
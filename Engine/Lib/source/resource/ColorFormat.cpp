@@ -0,0 +1,51 @@
+#include "kern/resource/ColorFormat.h"
+
+#include <algorithm>
+
+bool isCompressed(ColorFormat format)
+{
+    switch (format)
+    {
+    case ColorFormat::BC1:
+    case ColorFormat::BC3:
+    case ColorFormat::BC5:
+    case ColorFormat::BC7:
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::size_t getImageSize(ColorFormat format, unsigned int width, unsigned int height)
+{
+    // Blocks cover 4x4 pixels, partial blocks at the border are stored completely
+    std::size_t blocks = (((std::size_t)width + 3) / 4) * (((std::size_t)height + 3) / 4);
+    switch (format)
+    {
+    case ColorFormat::GreyScale8:
+    case ColorFormat::RGB24:
+    case ColorFormat::RGBA32:
+        // Enum value is the byte count per pixel
+        return (std::size_t)width * height * (std::size_t)format;
+    case ColorFormat::BC1:
+        return blocks * 8;
+    case ColorFormat::BC3:
+    case ColorFormat::BC5:
+    case ColorFormat::BC7:
+        return blocks * 16;
+    default:
+        return 0;
+    }
+}
+
+std::size_t getImageSize(ColorFormat format, unsigned int width, unsigned int height, unsigned int levels)
+{
+    std::size_t size = 0;
+    for (unsigned int level = 0; level < levels; ++level)
+    {
+        size += getImageSize(format, width, height);
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+    return size;
+}
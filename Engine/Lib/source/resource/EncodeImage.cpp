@@ -0,0 +1,510 @@
+#include "kern/resource/EncodeImage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <fmtlog/fmtlog.h>
+
+// Interpolation weights for 4 bit BC7 indices
+static const int bc7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// Pixels of a 4x4 block in RGBA
+struct SBlock
+{
+    float pixels[16][4];
+};
+
+// Writes a little endian bit stream for BC7 blocks
+struct SBitWriter
+{
+    unsigned char *data;
+    unsigned int position = 0;
+
+    void write(unsigned int value, unsigned int bits)
+    {
+        for (unsigned int i = 0; i < bits; ++i, ++position)
+        {
+            if ((value >> i) & 1)
+            {
+                data[position / 8] |= (unsigned char)(1 << (position % 8));
+            }
+        }
+    }
+};
+
+static unsigned char clampByte(float value) { return (unsigned char)std::min(std::max(value + 0.5f, 0.f), 255.f); }
+
+static float squaredError(const float *a, const float *b, int channels)
+{
+    float error = 0.f;
+    for (int c = 0; c < channels; ++c)
+    {
+        error += (a[c] - b[c]) * (a[c] - b[c]);
+    }
+    return error;
+}
+
+// Converts the source to RGBA32
+static std::vector<unsigned char> toRGBA(const Image &source)
+{
+    std::size_t pixels = (std::size_t)source.m_width * source.m_height;
+    unsigned int channels = (unsigned int)source.m_format;
+    std::vector<unsigned char> rgba(pixels * 4);
+    for (std::size_t i = 0; i < pixels; ++i)
+    {
+        const unsigned char *pixel = &source.m_data[i * channels];
+        rgba[i * 4 + 0] = pixel[0];
+        rgba[i * 4 + 1] = channels >= 3 ? pixel[1] : pixel[0];
+        rgba[i * 4 + 2] = channels >= 3 ? pixel[2] : pixel[0];
+        rgba[i * 4 + 3] = channels == 4 ? pixel[3] : 255;
+    }
+    return rgba;
+}
+
+// Box filters the RGBA level to half size, odd dimensions clamp at the border
+static std::vector<unsigned char> downsample(const std::vector<unsigned char> &rgba, unsigned int width,
+                                             unsigned int height, bool normalMap)
+{
+    unsigned int halfWidth = std::max(width / 2, 1u);
+    unsigned int halfHeight = std::max(height / 2, 1u);
+    std::vector<unsigned char> result((std::size_t)halfWidth * halfHeight * 4);
+    for (unsigned int y = 0; y < halfHeight; ++y)
+    {
+        for (unsigned int x = 0; x < halfWidth; ++x)
+        {
+            float sum[4] = {0.f, 0.f, 0.f, 0.f};
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                unsigned int sx = std::min(x * 2 + i % 2, width - 1);
+                unsigned int sy = std::min(y * 2 + i / 2, height - 1);
+                const unsigned char *pixel = &rgba[((std::size_t)sy * width + sx) * 4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    sum[c] += pixel[c] * 0.25f;
+                }
+            }
+
+            if (normalMap)
+            {
+                // Averaged normals are shorter than unit length, same mapping as in the geometry pass shader
+                float normal[3];
+                float length = 0.f;
+                for (int c = 0; c < 3; ++c)
+                {
+                    normal[c] = (sum[c] - 128.f) / 127.f;
+                    length += normal[c] * normal[c];
+                }
+                length = std::sqrt(length);
+                for (int c = 0; c < 3 && length > 0.f; ++c)
+                {
+                    sum[c] = normal[c] / length * 127.f + 128.f;
+                }
+            }
+
+            unsigned char *target = &result[((std::size_t)y * halfWidth + x) * 4];
+            for (int c = 0; c < 4; ++c)
+            {
+                target[c] = clampByte(sum[c]);
+            }
+        }
+    }
+    return result;
+}
+
+// Reads the 4x4 block at the block coordinates, border blocks repeat the edge pixels
+static void readBlock(const std::vector<unsigned char> &rgba, unsigned int width, unsigned int height,
+                      unsigned int blockX, unsigned int blockY, SBlock &block)
+{
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        unsigned int x = std::min(blockX * 4 + i % 4, width - 1);
+        unsigned int y = std::min(blockY * 4 + i / 4, height - 1);
+        const unsigned char *pixel = &rgba[((std::size_t)y * width + x) * 4];
+        for (int c = 0; c < 4; ++c)
+        {
+            block.pixels[i][c] = pixel[c];
+        }
+    }
+}
+
+// End points along the principal axis of the block pixels in the first channels
+static void findEndPoints(const SBlock &block, int channels, float *start, float *end)
+{
+    float mean[4] = {0.f, 0.f, 0.f, 0.f};
+    float min[4] = {255.f, 255.f, 255.f, 255.f};
+    float max[4] = {0.f, 0.f, 0.f, 0.f};
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < channels; ++c)
+        {
+            mean[c] += block.pixels[i][c] / 16.f;
+            min[c] = std::min(min[c], block.pixels[i][c]);
+            max[c] = std::max(max[c], block.pixels[i][c]);
+        }
+    }
+
+    float covariance[4][4] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int a = 0; a < channels; ++a)
+        {
+            for (int b = 0; b < channels; ++b)
+            {
+                covariance[a][b] += (block.pixels[i][a] - mean[a]) * (block.pixels[i][b] - mean[b]);
+            }
+        }
+    }
+
+    // Power iteration, starting with the bounding box diagonal
+    float axis[4] = {0.f, 0.f, 0.f, 0.f};
+    for (int c = 0; c < channels; ++c)
+    {
+        axis[c] = max[c] - min[c];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        float next[4] = {0.f, 0.f, 0.f, 0.f};
+        float length = 0.f;
+        for (int a = 0; a < channels; ++a)
+        {
+            for (int b = 0; b < channels; ++b)
+            {
+                next[a] += covariance[a][b] * axis[b];
+            }
+            length = std::max(length, std::abs(next[a]));
+        }
+        if (length == 0.f)
+        {
+            break;
+        }
+        for (int c = 0; c < channels; ++c)
+        {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    // Project the pixels onto the axis through the mean
+    float axisLength = 0.f;
+    for (int c = 0; c < channels; ++c)
+    {
+        axisLength += axis[c] * axis[c];
+    }
+    if (axisLength == 0.f)
+    {
+        // Solid block
+        std::copy(mean, mean + channels, start);
+        std::copy(mean, mean + channels, end);
+        return;
+    }
+    float minProjection = 0.f;
+    float maxProjection = 0.f;
+    for (int i = 0; i < 16; ++i)
+    {
+        float projection = 0.f;
+        for (int c = 0; c < channels; ++c)
+        {
+            projection += (block.pixels[i][c] - mean[c]) * axis[c];
+        }
+        minProjection = std::min(minProjection, projection / axisLength);
+        maxProjection = std::max(maxProjection, projection / axisLength);
+    }
+    for (int c = 0; c < channels; ++c)
+    {
+        start[c] = std::min(std::max(mean[c] + axis[c] * minProjection, 0.f), 255.f);
+        end[c] = std::min(std::max(mean[c] + axis[c] * maxProjection, 0.f), 255.f);
+    }
+}
+
+static std::uint16_t toRGB565(const float *color)
+{
+    unsigned int r = (unsigned int)(color[0] * 31.f / 255.f + 0.5f);
+    unsigned int g = (unsigned int)(color[1] * 63.f / 255.f + 0.5f);
+    unsigned int b = (unsigned int)(color[2] * 31.f / 255.f + 0.5f);
+    return (std::uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void fromRGB565(std::uint16_t value, float *color)
+{
+    unsigned int r = (value >> 11) & 31;
+    unsigned int g = (value >> 5) & 63;
+    unsigned int b = value & 31;
+    color[0] = (float)((r << 3) | (r >> 2));
+    color[1] = (float)((g << 2) | (g >> 4));
+    color[2] = (float)((b << 3) | (b >> 2));
+}
+
+// 8 byte color block with 4 color palette
+static void encodeBC1Block(const SBlock &block, unsigned char *output)
+{
+    float start[4];
+    float end[4];
+    findEndPoints(block, 3, start, end);
+    std::uint16_t color0 = toRGB565(end);
+    std::uint16_t color1 = toRGB565(start);
+    // Color 0 larger than color 1 selects the 4 color palette
+    if (color0 < color1)
+    {
+        std::swap(color0, color1);
+    }
+
+    float palette[4][3];
+    fromRGB565(color0, palette[0]);
+    fromRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+        palette[2][c] = (2.f * palette[0][c] + palette[1][c]) / 3.f;
+        palette[3][c] = (palette[0][c] + 2.f * palette[1][c]) / 3.f;
+    }
+
+    std::uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            unsigned int best = 0;
+            float bestError = squaredError(block.pixels[i], palette[0], 3);
+            for (unsigned int p = 1; p < 4; ++p)
+            {
+                float error = squaredError(block.pixels[i], palette[p], 3);
+                if (error < bestError)
+                {
+                    best = p;
+                    bestError = error;
+                }
+            }
+            indices |= best << (i * 2);
+        }
+    }
+
+    output[0] = (unsigned char)(color0 & 0xFF);
+    output[1] = (unsigned char)(color0 >> 8);
+    output[2] = (unsigned char)(color1 & 0xFF);
+    output[3] = (unsigned char)(color1 >> 8);
+    for (int i = 0; i < 4; ++i)
+    {
+        output[4 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+    }
+}
+
+// 8 byte single channel block with 8 value palette
+static void encodeBC4Block(const SBlock &block, int channel, unsigned char *output)
+{
+    float min = 255.f;
+    float max = 0.f;
+    for (int i = 0; i < 16; ++i)
+    {
+        min = std::min(min, block.pixels[i][channel]);
+        max = std::max(max, block.pixels[i][channel]);
+    }
+    unsigned char value0 = clampByte(max);
+    unsigned char value1 = clampByte(min);
+
+    // Value 0 larger than value 1 selects the 8 value palette
+    std::uint64_t indices = 0;
+    if (value0 > value1)
+    {
+        float palette[8];
+        palette[0] = value0;
+        palette[1] = value1;
+        for (int p = 1; p < 7; ++p)
+        {
+            palette[p + 1] = ((7 - p) * value0 + p * value1) / 7.f;
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            std::uint64_t best = 0;
+            float bestError = std::abs(block.pixels[i][channel] - palette[0]);
+            for (unsigned int p = 1; p < 8; ++p)
+            {
+                float error = std::abs(block.pixels[i][channel] - palette[p]);
+                if (error < bestError)
+                {
+                    best = p;
+                    bestError = error;
+                }
+            }
+            indices |= best << (i * 3);
+        }
+    }
+
+    output[0] = value0;
+    output[1] = value1;
+    for (int i = 0; i < 6; ++i)
+    {
+        output[2 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+    }
+}
+
+// 16 byte mode 6 block, single RGBA end point pair with 7 bit channels, p bits and 4 bit indices
+static void encodeBC7Block(const SBlock &block, unsigned char *output)
+{
+    float endPoints[2][4];
+    findEndPoints(block, 4, endPoints[0], endPoints[1]);
+
+    // Quantize end points, the p bit is shared by all channels of an end point
+    unsigned int quantized[2][4];
+    unsigned int pBits[2];
+    int values[2][4];
+    for (int e = 0; e < 2; ++e)
+    {
+        float bestError = -1.f;
+        for (unsigned int p = 0; p < 2; ++p)
+        {
+            unsigned int channels[4];
+            float error = 0.f;
+            for (int c = 0; c < 4; ++c)
+            {
+                float value = (endPoints[e][c] - p) / 2.f;
+                channels[c] = (unsigned int)std::min(std::max(value + 0.5f, 0.f), 127.f);
+                float restored = (float)((channels[c] << 1) | p);
+                error += (restored - endPoints[e][c]) * (restored - endPoints[e][c]);
+            }
+            if (bestError < 0.f || error < bestError)
+            {
+                bestError = error;
+                pBits[e] = p;
+                std::copy(channels, channels + 4, quantized[e]);
+            }
+        }
+        for (int c = 0; c < 4; ++c)
+        {
+            values[e][c] = (int)((quantized[e][c] << 1) | pBits[e]);
+        }
+    }
+
+    float palette[16][4];
+    for (int p = 0; p < 16; ++p)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            palette[p][c] = (float)(((64 - bc7Weights[p]) * values[0][c] + bc7Weights[p] * values[1][c] + 32) >> 6);
+        }
+    }
+
+    unsigned int indices[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        indices[i] = 0;
+        float bestError = squaredError(block.pixels[i], palette[0], 4);
+        for (unsigned int p = 1; p < 16; ++p)
+        {
+            float error = squaredError(block.pixels[i], palette[p], 4);
+            if (error < bestError)
+            {
+                indices[i] = p;
+                bestError = error;
+            }
+        }
+    }
+
+    // The most significant bit of the first index is implicitly zero, the weights are symmetric
+    if (indices[0] >= 8)
+    {
+        std::swap(quantized[0], quantized[1]);
+        std::swap(pBits[0], pBits[1]);
+        for (int i = 0; i < 16; ++i)
+        {
+            indices[i] = 15 - indices[i];
+        }
+    }
+
+    std::fill(output, output + 16, (unsigned char)0);
+    SBitWriter writer{output};
+    writer.write(1 << 6, 7);
+    for (int c = 0; c < 4; ++c)
+    {
+        writer.write(quantized[0][c], 7);
+        writer.write(quantized[1][c], 7);
+    }
+    writer.write(pBits[0], 1);
+    writer.write(pBits[1], 1);
+    writer.write(indices[0], 3);
+    for (int i = 1; i < 16; ++i)
+    {
+        writer.write(indices[i], 4);
+    }
+}
+
+// Appends one compressed level
+static void encodeLevel(const std::vector<unsigned char> &rgba, unsigned int width, unsigned int height,
+                        ColorFormat format, std::vector<unsigned char> &output)
+{
+    std::size_t offset = output.size();
+    output.resize(offset + getImageSize(format, width, height));
+    unsigned char *target = output.data() + offset;
+
+    SBlock block;
+    for (unsigned int blockY = 0; blockY < (height + 3) / 4; ++blockY)
+    {
+        for (unsigned int blockX = 0; blockX < (width + 3) / 4; ++blockX)
+        {
+            readBlock(rgba, width, height, blockX, blockY, block);
+            switch (format)
+            {
+            case ColorFormat::BC1:
+                encodeBC1Block(block, target);
+                target += 8;
+                break;
+            case ColorFormat::BC3:
+                encodeBC4Block(block, 3, target);
+                encodeBC1Block(block, target + 8);
+                target += 16;
+                break;
+            case ColorFormat::BC5:
+                encodeBC4Block(block, 0, target);
+                encodeBC4Block(block, 1, target + 8);
+                target += 16;
+                break;
+            case ColorFormat::BC7:
+                encodeBC7Block(block, target);
+                target += 16;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+bool encode(const Image &source, ColorFormat format, bool createMipmaps, Image &result)
+{
+    if (!isCompressed(format))
+    {
+        loge("Target format for image encoding is not block compressed.");
+        return false;
+    }
+    if (isCompressed(source.m_format) || source.m_format == ColorFormat::Invalid || source.m_levels != 1 ||
+        source.m_width == 0 || source.m_height == 0 ||
+        source.m_data.size() != getImageSize(source.m_format, source.m_width, source.m_height))
+    {
+        loge("Source image for encoding must be a single uncompressed level.");
+        return false;
+    }
+
+    unsigned int levels = 1;
+    if (createMipmaps)
+    {
+        // Full chain down to 1x1
+        levels = (unsigned int)std::floor(std::log2(std::max(source.m_width, source.m_height))) + 1;
+    }
+
+    std::vector<unsigned char> data;
+    data.reserve(getImageSize(format, source.m_width, source.m_height, levels));
+    std::vector<unsigned char> rgba = toRGBA(source);
+    unsigned int width = source.m_width;
+    unsigned int height = source.m_height;
+    for (unsigned int level = 0; level < levels; ++level)
+    {
+        if (level > 0)
+        {
+            rgba = downsample(rgba, width, height, format == ColorFormat::BC5);
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+        encodeLevel(rgba, width, height, format, data);
+    }
+
+    result = Image(std::move(data), source.m_width, source.m_height, format, levels);
+    return true;
+}
@@ -7,6 +7,6 @@ bool ImageLoader::loadFromFile(const std::string& file, IResourceManager& manage
     if (!load(file, img))
         return false;
 
-    manager.createImage(img.m_data, img.m_width, img.m_height, img.m_format);
+    manager.createImage(img);
     return true;
 }
\ No newline at end of file
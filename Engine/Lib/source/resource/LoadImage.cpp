@@ -3,8 +3,49 @@
 #include <fmtlog/fmtlog.h>
 #include <stb_image.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <vector>
 
+// DXGI formats from the DDS DX10 extension header
+const std::uint32_t dxgiFormatBC1 = 71;
+const std::uint32_t dxgiFormatBC1Srgb = 72;
+const std::uint32_t dxgiFormatBC3 = 77;
+const std::uint32_t dxgiFormatBC3Srgb = 78;
+const std::uint32_t dxgiFormatBC5 = 83;
+const std::uint32_t dxgiFormatBC7 = 98;
+const std::uint32_t dxgiFormatBC7Srgb = 99;
+
+// Vulkan formats used by KTX2
+const std::uint32_t vkFormatR8 = 9;
+const std::uint32_t vkFormatRGB8 = 23;
+const std::uint32_t vkFormatRGBA8 = 37;
+const std::uint32_t vkFormatBC1 = 131;
+const std::uint32_t vkFormatBC1Srgb = 132;
+const std::uint32_t vkFormatBC3 = 137;
+const std::uint32_t vkFormatBC3Srgb = 138;
+const std::uint32_t vkFormatBC5 = 141;
+const std::uint32_t vkFormatBC7 = 145;
+const std::uint32_t vkFormatBC7Srgb = 146;
+
+// Largest texture dimension every GL 4.6 implementation supports, see GL_MAX_TEXTURE_SIZE
+const unsigned int maxImageDimension = 16384;
+
+// DDS header flag marking the mip count as valid
+const std::uint32_t ddsdMipMapCount = 0x20000;
+
+// Byte sizes of the container headers
+const std::size_t ddsHeaderSize = 4 + 124;
+const std::size_t ddsHeaderDx10Size = 20;
+const std::size_t ktx2HeaderSize = 80;
+const std::size_t ktx2LevelIndexSize = 24;
+
+static const unsigned char ktx2Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
 static ColorFormat channelsToFormat(int channels)
 {
     switch (channels)
@@ -20,6 +61,254 @@ static ColorFormat channelsToFormat(int channels)
     }
 }
 
+static bool hasExtension(const std::string &file, const std::string &extension)
+{
+    return file.size() >= extension.size() &&
+           file.compare(file.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+// Length of the full mip chain down to 1x1
+static unsigned int getMaxLevelCount(unsigned int width, unsigned int height)
+{
+    return (unsigned int)std::floor(std::log2(std::max(width, height))) + 1;
+}
+
+// Little endian reads, offsets are checked by the caller
+// Rejects empty images and images too large for a texture
+static bool isValidSize(unsigned int width, unsigned int height)
+{
+    return width > 0 && height > 0 && width <= maxImageDimension && height <= maxImageDimension;
+}
+
+static std::uint32_t read32(const std::vector<unsigned char> &data, std::size_t offset)
+{
+    return (std::uint32_t)data[offset] | ((std::uint32_t)data[offset + 1] << 8) |
+           ((std::uint32_t)data[offset + 2] << 16) | ((std::uint32_t)data[offset + 3] << 24);
+}
+
+static std::uint64_t read64(const std::vector<unsigned char> &data, std::size_t offset)
+{
+    return (std::uint64_t)read32(data, offset) | ((std::uint64_t)read32(data, offset + 4) << 32);
+}
+
+static std::uint32_t fourCC(const char *code)
+{
+    return (std::uint32_t)code[0] | ((std::uint32_t)code[1] << 8) | ((std::uint32_t)code[2] << 16) |
+           ((std::uint32_t)code[3] << 24);
+}
+
+static bool readFile(const std::string &file, std::vector<unsigned char> &data)
+{
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs.is_open())
+    {
+        loge("Failed to open image file {}.", file);
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static bool loadDds(const std::string &file, Image &image)
+{
+    std::vector<unsigned char> data;
+    if (!readFile(file, data))
+    {
+        return false;
+    }
+
+    if (data.size() < ddsHeaderSize || read32(data, 0) != fourCC("DDS ") || read32(data, 4) != 124)
+    {
+        loge("Invalid DDS header in image file {}.", file);
+        return false;
+    }
+
+    unsigned int height = read32(data, 12);
+    unsigned int width = read32(data, 16);
+    // The mip count is only valid with its flag set
+    unsigned int levels = (read32(data, 8) & ddsdMipMapCount) != 0 ? std::max(read32(data, 28), 1u) : 1;
+    std::uint32_t pixelFormatFlags = read32(data, 80);
+    std::uint32_t code = read32(data, 84);
+    std::size_t offset = ddsHeaderSize;
+
+    // Only compressed pixel formats, identified by a four character code
+    ColorFormat format = ColorFormat::Invalid;
+    if ((pixelFormatFlags & 0x4) != 0)
+    {
+        if (code == fourCC("DXT1"))
+        {
+            format = ColorFormat::BC1;
+        }
+        else if (code == fourCC("DXT5"))
+        {
+            format = ColorFormat::BC3;
+        }
+        else if (code == fourCC("ATI2") || code == fourCC("BC5U"))
+        {
+            format = ColorFormat::BC5;
+        }
+        else if (code == fourCC("DX10") && data.size() >= ddsHeaderSize + ddsHeaderDx10Size)
+        {
+            offset += ddsHeaderDx10Size;
+            // Array textures and cube maps are not supported
+            if (read32(data, ddsHeaderSize + 4) != 3 || read32(data, ddsHeaderSize + 12) != 1)
+            {
+                loge("Only single 2D textures are supported in DDS image file {}.", file);
+                return false;
+            }
+            switch (read32(data, ddsHeaderSize))
+            {
+            case dxgiFormatBC1:
+                format = ColorFormat::BC1;
+                break;
+            case dxgiFormatBC3:
+                format = ColorFormat::BC3;
+                break;
+            case dxgiFormatBC5:
+                format = ColorFormat::BC5;
+                break;
+            case dxgiFormatBC7:
+                format = ColorFormat::BC7;
+                break;
+            case dxgiFormatBC1Srgb:
+            case dxgiFormatBC3Srgb:
+            case dxgiFormatBC7Srgb:
+                // Textures are sampled as linear UNORM data, decoding would change the colors
+                loge("sRGB formats are not supported, export DDS image file {} as UNORM.", file);
+                return false;
+            default:
+                break;
+            }
+        }
+    }
+    if (format == ColorFormat::Invalid)
+    {
+        loge("Unsupported pixel format in DDS image file {}.", file);
+        return false;
+    }
+
+    if (!isValidSize(width, height) || levels > getMaxLevelCount(width, height))
+    {
+        loge("Invalid size or mip count in DDS image file {}.", file);
+        return false;
+    }
+
+    // Mip levels are stored back to back after the header
+    std::size_t size = getImageSize(format, width, height, levels);
+    if (data.size() < offset + size)
+    {
+        loge("Truncated image data in DDS image file {}.", file);
+        return false;
+    }
+
+    image.m_data.assign(data.begin() + offset, data.begin() + offset + size);
+    image.m_width = width;
+    image.m_height = height;
+    image.m_format = format;
+    image.m_levels = levels;
+    return true;
+}
+
+static bool loadKtx2(const std::string &file, Image &image)
+{
+    std::vector<unsigned char> data;
+    if (!readFile(file, data))
+    {
+        return false;
+    }
+
+    if (data.size() < ktx2HeaderSize || std::memcmp(data.data(), ktx2Identifier, sizeof(ktx2Identifier)) != 0)
+    {
+        loge("Invalid KTX2 header in image file {}.", file);
+        return false;
+    }
+
+    std::uint32_t vkFormat = read32(data, 12);
+    unsigned int width = read32(data, 20);
+    unsigned int height = read32(data, 24);
+    // Level count 0 requests runtime mip generation
+    unsigned int levels = std::max(read32(data, 40), 1u);
+    if (read32(data, 28) != 0 || read32(data, 32) != 0 || read32(data, 36) != 1)
+    {
+        loge("Only single 2D textures are supported in KTX2 image file {}.", file);
+        return false;
+    }
+    if (read32(data, 44) != 0)
+    {
+        loge("Supercompressed KTX2 image file {} is not supported.", file);
+        return false;
+    }
+
+    ColorFormat format = ColorFormat::Invalid;
+    switch (vkFormat)
+    {
+    case vkFormatR8:
+        format = ColorFormat::GreyScale8;
+        break;
+    case vkFormatRGB8:
+        format = ColorFormat::RGB24;
+        break;
+    case vkFormatRGBA8:
+        format = ColorFormat::RGBA32;
+        break;
+    case vkFormatBC1:
+        format = ColorFormat::BC1;
+        break;
+    case vkFormatBC3:
+        format = ColorFormat::BC3;
+        break;
+    case vkFormatBC5:
+        format = ColorFormat::BC5;
+        break;
+    case vkFormatBC7:
+        format = ColorFormat::BC7;
+        break;
+    case vkFormatBC1Srgb:
+    case vkFormatBC3Srgb:
+    case vkFormatBC7Srgb:
+        // Textures are sampled as linear UNORM data, decoding would change the colors
+        loge("sRGB formats are not supported, export KTX2 image file {} as UNORM.", file);
+        return false;
+    default:
+        loge("Unsupported format {} in KTX2 image file {}.", vkFormat, file);
+        return false;
+    }
+    if (!isValidSize(width, height) || levels > getMaxLevelCount(width, height) ||
+        data.size() < ktx2HeaderSize + levels * ktx2LevelIndexSize)
+    {
+        loge("Invalid KTX2 level index in image file {}.", file);
+        return false;
+    }
+
+    // Levels may be stored in any order and with padding, gather them largest first
+    std::vector<unsigned char> levelData;
+    levelData.reserve(getImageSize(format, width, height, levels));
+    unsigned int levelWidth = width;
+    unsigned int levelHeight = height;
+    for (unsigned int level = 0; level < levels; ++level)
+    {
+        std::size_t index = ktx2HeaderSize + level * ktx2LevelIndexSize;
+        std::uint64_t levelOffset = read64(data, index);
+        std::uint64_t levelSize = read64(data, index + 8);
+        if (levelSize != getImageSize(format, levelWidth, levelHeight) || levelOffset > data.size() ||
+            levelSize > data.size() - levelOffset)
+        {
+            loge("Invalid size of level {} in KTX2 image file {}.", level, file);
+            return false;
+        }
+        levelData.insert(levelData.end(), data.begin() + levelOffset, data.begin() + levelOffset + levelSize);
+        levelWidth = std::max(levelWidth / 2, 1u);
+        levelHeight = std::max(levelHeight / 2, 1u);
+    }
+
+    image.m_data = std::move(levelData);
+    image.m_width = width;
+    image.m_height = height;
+    image.m_format = format;
+    image.m_levels = levels;
+    return true;
+}
+
 static bool loadInternal(const std::string& file, int stbiDesiredChannels, Image& image)
 {
     stbi_set_flip_vertically_on_load(true);
@@ -45,19 +334,41 @@ static bool loadInternal(const std::string& file, int stbiDesiredChannels, Image
     image.m_format = channelsToFormat(channels);
     image.m_width = width;
     image.m_height = height;
+    image.m_levels = 1;
     image.m_data.assign(data, data + channels * width * height);
     stbi_image_free(data);
 
     return true;
 }
 
+static bool loadContainer(const std::string &file, Image &image)
+{
+    if (hasExtension(file, ".dds"))
+    {
+        return loadDds(file, image);
+    }
+    return loadKtx2(file, image);
+}
+
+static bool isContainer(const std::string &file) { return hasExtension(file, ".dds") || hasExtension(file, ".ktx2"); }
+
 bool load(const std::string& file, Image& image)
 { 
+    if (isContainer(file))
+    {
+        return loadContainer(file, image);
+    }
     return loadInternal(file, STBI_default, image);
 }
 
 bool load(const std::string &file, ColorFormat format, Image &image)
 {
+    // Containers hold baked data, no conversion
+    if (isContainer(file))
+    {
+        return loadContainer(file, image);
+    }
+
     // Map color type
     int desiredChannels = 0;
     switch (format)
@@ -78,4 +389,4 @@ bool load(const std::string &file, ColorFormat format, Image &image)
     }
 
     return loadInternal(file, desiredChannels, image);
-}
\ No newline at end of file
+}
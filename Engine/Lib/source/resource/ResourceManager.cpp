@@ -10,6 +10,7 @@
 #include "kern/foundation/IniFile.h"
 #include "kern/foundation/JsonDeserialize.h"
 #include "kern/foundation/JsonUtil.h"
+#include "kern/foundation/MemoryReport.h"
 #include "kern/resource/IResourceListener.h"
 #include "kern/resource/LoadImage.h"
 #include "kern/resource/LoadMaterial.h"
@@ -103,6 +104,11 @@ bool ResourceManager::getMesh(ResourceId id, std::vector<float> &vertices, std::
 
 ResourceId ResourceManager::createImage(const std::vector<unsigned char> &imageData, unsigned int width,
                                         unsigned int height, ColorFormat format)
+{
+    return createImage(Image(imageData, width, height, format));
+}
+
+ResourceId ResourceManager::createImage(const Image &image)
 {
     // Create image
     ResourceId id = m_nextImageId;
@@ -110,7 +116,7 @@ ResourceId ResourceManager::createImage(const std::vector<unsigned char> &imageD
 
     // TODO Sanity check if image already exists?
     // Add mesh
-    m_images[id] = Image(imageData, width, height, format);
+    m_images[id] = image;
 
     // Notify listener with create event
     notifyResourceListeners(ResourceType::Image, id, ResourceEvent::Create);
@@ -134,7 +140,7 @@ ResourceId ResourceManager::loadImage(const std::string &file, ColorFormat forma
     }
 
     // Create managed resource
-    ResourceId imageId = createImage(image.m_data, image.m_width, image.m_height, image.m_format);
+    ResourceId imageId = createImage(image);
     if (imageId == InvalidResource)
     {
         loge("Failed to create image resource id from file {}.", file.c_str());
@@ -161,6 +167,18 @@ bool ResourceManager::getImage(ResourceId id, std::vector<unsigned char> &data,
     return true;
 }
 
+bool ResourceManager::getImage(ResourceId id, Image &image) const
+{
+    // Retrieve from map
+    auto iter = m_images.find(id);
+    if (iter == m_images.end())
+    {
+        return false;
+    }
+    image = iter->second;
+    return true;
+}
+
 ResourceId ResourceManager::createMaterial(ResourceId base, ResourceId normal, ResourceId specular, ResourceId glow,
                                            ResourceId alpha)
 {
@@ -433,5 +451,86 @@ ResourceId ResourceManager::loadString(const std::string &file)
     }
 
     m_textFiles[file] = stringId;
+    if (m_fileWatcher != nullptr)
+    {
+        m_fileWatcher->watch(file);
+    }
     return stringId;
+}
+
+void ResourceManager::setHotReload(bool enabled)
+{
+    if (enabled && m_fileWatcher == nullptr)
+    {
+        m_fileWatcher = std::make_unique<FileWatcher>();
+        for (const auto &entry : m_textFiles)
+        {
+            m_fileWatcher->watch(entry.first);
+        }
+    }
+    else if (!enabled)
+    {
+        m_fileWatcher = nullptr;
+    }
+}
+
+void ResourceManager::update()
+{
+    if (m_fileWatcher == nullptr)
+    {
+        return;
+    }
+
+    std::vector<std::string> changed;
+    m_fileWatcher->poll(changed);
+    for (const auto &file : changed)
+    {
+        // Keep the previous text if the file is gone or not readable yet
+        std::ifstream ifs(file);
+        if (!ifs.is_open())
+        {
+            logw("Failed to reload text file {}.", file);
+            continue;
+        }
+        std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+        ResourceId id = m_textFiles.at(file);
+        if (text == m_strings[id])
+        {
+            continue;
+        }
+        logi("Reloading text file {}.", file);
+        m_strings[id] = std::move(text);
+        notifyResourceListeners(ResourceType::String, id, ResourceEvent::Change);
+    }
+}
+
+void ResourceManager::reportMemory(MemoryReport &report) const
+{
+    std::size_t meshBytes = 0;
+    for (const auto &mesh : m_meshes)
+    {
+        meshBytes += (mesh.second.m_vertices.size() + mesh.second.m_normals.size() + mesh.second.m_uvs.size()) *
+                         sizeof(float) +
+                     mesh.second.m_indices.size() * sizeof(unsigned int);
+    }
+    report.add("resource/mesh", m_meshes.size(), meshBytes);
+
+    std::size_t imageBytes = 0;
+    for (const auto &image : m_images)
+    {
+        imageBytes += image.second.m_data.size();
+    }
+    report.add("resource/image", m_images.size(), imageBytes);
+
+    std::size_t stringBytes = 0;
+    for (const auto &text : m_strings)
+    {
+        stringBytes += text.second.size();
+    }
+    report.add("resource/string", m_strings.size(), stringBytes);
+
+    report.add("resource/material", m_materials.size(), m_materials.size() * sizeof(SMaterial));
+    report.add("resource/model", m_models.size(), m_models.size() * sizeof(SModel));
+    report.add("resource/shader", m_shaders.size(), m_shaders.size() * sizeof(SShader));
 }
\ No newline at end of file
@@ -1,8 +1,8 @@
 #include "kern/resource/Image.h"
 
 Image::Image(std::vector<unsigned char> data, unsigned int width, unsigned int height,
-               ColorFormat format)
-    : m_data(data), m_width(width), m_height(height), m_format(format)
+               ColorFormat format, unsigned int levels)
+    : m_data(data), m_width(width), m_height(height), m_format(format), m_levels(levels)
 {
     return;
 }
@@ -0,0 +1,106 @@
+#include "kern/resource/SaveImage.h"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include <fmtlog/fmtlog.h>
+
+// DDS header flags
+const std::uint32_t ddsFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;
+const std::uint32_t ddsPixelFormatFourCC = 0x4;
+const std::uint32_t ddsCapsTexture = 0x1000;
+const std::uint32_t ddsCapsMipmap = 0x8 | 0x400000;
+
+// DDS DX10 extension header values for BC7
+const std::uint32_t dxgiFormatBC7 = 98;
+const std::uint32_t dimensionTexture2D = 3;
+
+static void write32(std::vector<unsigned char> &data, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        data.push_back((unsigned char)((value >> (i * 8)) & 0xFF));
+    }
+}
+
+static std::uint32_t fourCC(const char *code)
+{
+    return (std::uint32_t)code[0] | ((std::uint32_t)code[1] << 8) | ((std::uint32_t)code[2] << 16) |
+           ((std::uint32_t)code[3] << 24);
+}
+
+bool save(const std::string &file, const Image &image)
+{
+    // Legacy four character codes where available
+    std::uint32_t code = 0;
+    switch (image.m_format)
+    {
+    case ColorFormat::BC1:
+        code = fourCC("DXT1");
+        break;
+    case ColorFormat::BC3:
+        code = fourCC("DXT5");
+        break;
+    case ColorFormat::BC5:
+        code = fourCC("ATI2");
+        break;
+    case ColorFormat::BC7:
+        code = fourCC("DX10");
+        break;
+    default:
+        loge("Only block compressed images can be saved as DDS file {}.", file);
+        return false;
+    }
+    if (image.m_data.size() != getImageSize(image.m_format, image.m_width, image.m_height, image.m_levels))
+    {
+        loge("Image data size does not match the image dimensions for file {}.", file);
+        return false;
+    }
+
+    std::vector<unsigned char> header;
+    write32(header, fourCC("DDS "));
+    write32(header, 124);
+    write32(header, ddsFlags);
+    write32(header, image.m_height);
+    write32(header, image.m_width);
+    write32(header, (std::uint32_t)getImageSize(image.m_format, image.m_width, image.m_height));
+    write32(header, 0);
+    write32(header, image.m_levels);
+    for (int i = 0; i < 11; ++i)
+    {
+        write32(header, 0);
+    }
+    // Pixel format
+    write32(header, 32);
+    write32(header, ddsPixelFormatFourCC);
+    write32(header, code);
+    for (int i = 0; i < 5; ++i)
+    {
+        write32(header, 0);
+    }
+    // Caps
+    write32(header, ddsCapsTexture | (image.m_levels > 1 ? ddsCapsMipmap : 0));
+    for (int i = 0; i < 4; ++i)
+    {
+        write32(header, 0);
+    }
+    if (image.m_format == ColorFormat::BC7)
+    {
+        write32(header, dxgiFormatBC7);
+        write32(header, dimensionTexture2D);
+        write32(header, 0);
+        write32(header, 1);
+        write32(header, 0);
+    }
+
+    std::ofstream ofs(file, std::ios::binary);
+    if (!ofs.is_open())
+    {
+        loge("Failed to open image file {} for writing.", file);
+        return false;
+    }
+    ofs.write((const char *)header.data(), header.size());
+    ofs.write((const char *)image.m_data.data(), image.m_data.size());
+    return ofs.good();
+}
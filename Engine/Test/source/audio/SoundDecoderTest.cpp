@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vorbis/vorbisenc.h>
+
+#include <kern/audio/Mp3Decoder.h>
+#include <kern/audio/VorbisDecoder.h>
+
+// Encodes interleaved 16 bit samples into an Ogg Vorbis file
+static bool encodeVorbis(const std::string &fileName, const std::vector<std::int16_t> &samples, int channels,
+                         long frequency)
+{
+    std::FILE *file = std::fopen(fileName.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    vorbis_info info;
+    vorbis_info_init(&info);
+    if (vorbis_encode_init_vbr(&info, channels, frequency, 0.4f) != 0)
+    {
+        vorbis_info_clear(&info);
+        std::fclose(file);
+        return false;
+    }
+    vorbis_comment comment;
+    vorbis_comment_init(&comment);
+    vorbis_dsp_state dsp;
+    vorbis_analysis_init(&dsp, &info);
+    vorbis_block block;
+    vorbis_block_init(&dsp, &block);
+    ogg_stream_state stream;
+    ogg_stream_init(&stream, 1);
+
+    ogg_page page;
+    ogg_packet header;
+    ogg_packet headerComment;
+    ogg_packet headerCode;
+    vorbis_analysis_headerout(&dsp, &comment, &header, &headerComment, &headerCode);
+    ogg_stream_packetin(&stream, &header);
+    ogg_stream_packetin(&stream, &headerComment);
+    ogg_stream_packetin(&stream, &headerCode);
+    while (ogg_stream_flush(&stream, &page) != 0)
+    {
+        std::fwrite(page.header, 1, page.header_len, file);
+        std::fwrite(page.body, 1, page.body_len, file);
+    }
+
+    auto writePackets = [&]()
+    {
+        ogg_packet packet;
+        while (vorbis_analysis_blockout(&dsp, &block) == 1)
+        {
+            vorbis_analysis(&block, nullptr);
+            vorbis_bitrate_addblock(&block);
+            while (vorbis_bitrate_flushpacket(&dsp, &packet) != 0)
+            {
+                ogg_stream_packetin(&stream, &packet);
+                while (ogg_stream_pageout(&stream, &page) != 0)
+                {
+                    std::fwrite(page.header, 1, page.header_len, file);
+                    std::fwrite(page.body, 1, page.body_len, file);
+                }
+            }
+        }
+    };
+
+    const std::size_t blockFrames = 4096;
+    std::size_t frameCount = samples.size() / channels;
+    for (std::size_t first = 0; first < frameCount; first += blockFrames)
+    {
+        std::size_t frames = std::min(blockFrames, frameCount - first);
+        float **buffer = vorbis_analysis_buffer(&dsp, (int)frames);
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            for (int channel = 0; channel < channels; ++channel)
+            {
+                buffer[channel][i] = samples[(first + i) * channels + channel] / 32768.f;
+            }
+        }
+        vorbis_analysis_wrote(&dsp, (int)frames);
+        writePackets();
+    }
+    vorbis_analysis_wrote(&dsp, 0);
+    writePackets();
+
+    ogg_stream_clear(&stream);
+    vorbis_block_clear(&block);
+    vorbis_dsp_clear(&dsp);
+    vorbis_comment_clear(&comment);
+    vorbis_info_clear(&info);
+    std::fclose(file);
+    return true;
+}
+
+// Decodes the whole file in blocks like streamed playback does
+static std::size_t decodeAll(SoundDecoder &decoder, std::vector<std::int16_t> &block)
+{
+    std::size_t total = 0;
+    std::size_t count = 0;
+    while ((count = decoder.read(block.data(), block.size())) > 0)
+    {
+        total += count;
+    }
+    return total;
+}
+
+TEST_CASE("Vorbis decoder decodes and rewinds", "[audio]")
+{
+    // One second of a stereo sine
+    const long frequency = 44100;
+    std::vector<std::int16_t> samples(frequency * 2);
+    for (std::size_t i = 0; i < samples.size() / 2; ++i)
+    {
+        samples[i * 2] = samples[i * 2 + 1] = (std::int16_t)(std::sin(i * 0.0627f) * 16000.f);
+    }
+    std::string fileName = (std::filesystem::temp_directory_path() / "kern_vorbis_decoder_test.ogg").string();
+    REQUIRE(encodeVorbis(fileName, samples, 2, frequency));
+
+    {
+        VorbisDecoder decoder(fileName);
+        CHECK(decoder.getChannels() == 2);
+        CHECK(decoder.getFrequency() == frequency);
+        CHECK(decoder.getSampleCount() == samples.size());
+
+        std::vector<std::int16_t> block(1000);
+        CHECK(decodeAll(decoder, block) == samples.size());
+        CHECK(decoder.read(block.data(), block.size()) == 0);
+
+        REQUIRE(decoder.rewind());
+        std::vector<std::int16_t> first(1000);
+        REQUIRE(decoder.read(first.data(), first.size()) == first.size());
+        REQUIRE(decoder.rewind());
+        REQUIRE(decoder.read(block.data(), block.size()) == block.size());
+        CHECK(block == first);
+    }
+
+    std::filesystem::remove(fileName);
+    CHECK_THROWS(VorbisDecoder(fileName));
+}
+
+TEST_CASE("Sound decode throughput", "[.][benchmark][audio]")
+{
+    // Same content in both formats, the ogg file is encoded from the decoded mp3
+    std::string mp3File =
+        std::string(KERN_DEMO_DIRECTORY) + "/RenderDemo/data/sounds/bgm/lofi-chill-medium-version-159456.mp3";
+    std::string oggFile = (std::filesystem::temp_directory_path() / "kern_sound_decode_benchmark.ogg").string();
+
+    std::vector<std::int16_t> samples;
+    std::vector<std::int16_t> block(8192 * 2);
+    unsigned short channels = 0;
+    unsigned int frequency = 0;
+    {
+        Mp3Decoder decoder(mp3File);
+        channels = decoder.getChannels();
+        frequency = decoder.getFrequency();
+        std::size_t count = 0;
+        while ((count = decoder.read(block.data(), block.size())) > 0)
+        {
+            samples.insert(samples.end(), block.begin(), block.begin() + count);
+        }
+    }
+    REQUIRE(encodeVorbis(oggFile, samples, channels, frequency));
+    WARN("mp3 " << std::filesystem::file_size(mp3File) << " bytes, ogg " << std::filesystem::file_size(oggFile)
+                << " bytes, " << samples.size() / channels / frequency << " seconds");
+
+    BENCHMARK("mp3 decode")
+    {
+        Mp3Decoder decoder(mp3File);
+        return decodeAll(decoder, block);
+    };
+    BENCHMARK("ogg vorbis decode")
+    {
+        VorbisDecoder decoder(oggFile);
+        return decodeAll(decoder, block);
+    };
+
+    std::filesystem::remove(oggFile);
+}
@@ -0,0 +1,40 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/FileWatcher.h>
+
+TEST_CASE("File watcher reports modified files once", "[foundation]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "kern_file_watcher_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::string file = (directory / "shader.glsl").string();
+    std::string other = (directory / "other.glsl").string();
+    std::ofstream(file) << "void main() {}";
+    std::ofstream(other) << "void main() {}";
+
+    FileWatcher watcher;
+    REQUIRE(watcher.watch(file));
+
+    std::vector<std::string> changed;
+    watcher.poll(changed);
+    CHECK(changed.empty());
+
+    // Unwatched files in the same directory are not reported
+    std::ofstream(other) << "void main() { }";
+    std::ofstream(file) << "void main() { }";
+    std::ofstream(file) << "void main() {  }";
+    watcher.poll(changed);
+    REQUIRE(changed.size() == 1);
+    CHECK(changed.front() == file);
+
+    changed.clear();
+    watcher.poll(changed);
+    CHECK(changed.empty());
+
+    std::filesystem::remove_all(directory);
+}
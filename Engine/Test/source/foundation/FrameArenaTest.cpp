@@ -0,0 +1,56 @@
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/AllocationCounter.h>
+#include <kern/foundation/FrameArena.h>
+#include <kern/graphics/scene/SceneQuery.h>
+
+TEST_CASE("Frame arena bump allocates and grows to the peak", "[foundation]")
+{
+    FrameArena arena(256);
+
+    void *first = arena.allocate(3, 1);
+    double *second = (double *)arena.allocate(sizeof(double), alignof(double));
+    CHECK((std::uintptr_t)second % alignof(double) == 0);
+    CHECK((unsigned char *)second >= (unsigned char *)first + 3);
+
+    // Latest allocation is reclaimed
+    std::size_t used = arena.getUsed();
+    arena.deallocate(arena.allocate(16, 1), 16);
+    CHECK(arena.getUsed() == used);
+
+    // Overflow is served from the heap until the next reset
+    arena.allocate(1024, 16);
+    CHECK(arena.getOverflowCount() == 1);
+    arena.reset();
+    CHECK(arena.getUsed() == 0);
+    CHECK(arena.getCapacity() >= 256 + 1024);
+    arena.allocate(1024, 16);
+    CHECK(arena.getOverflowCount() == 0);
+}
+
+TEST_CASE("Scene queries do not allocate in steady state frames", "[foundation]")
+{
+    FrameArena arena(1024);
+    auto frame = [&arena]() {
+        arena.reset();
+        SceneQuery query(arena, 16, 16);
+        for (SceneObjectId id = 0; id < 1000; ++id)
+        {
+            query.addObject(id);
+            query.addPointLight(id);
+        }
+        query.addDirectionalLight(0);
+    };
+
+    // The first frame grows the arena
+    frame();
+    frame();
+    std::uint64_t allocations = getAllocationCount();
+    frame();
+    CHECK(arena.getOverflowCount() == 0);
+    // The tests are always built with the allocation hook
+    REQUIRE(isAllocationCounterEnabled());
+    CHECK(getAllocationCount() == allocations);
+}
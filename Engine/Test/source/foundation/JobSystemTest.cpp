@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/JobSystem.h>
+
+TEST_CASE("Job system runs every range once", "[foundation]")
+{
+    for (unsigned int threadCount : {1u, 4u})
+    {
+        JobSystem jobs(threadCount);
+        CHECK(jobs.getThreadCount() == threadCount);
+
+        // Assertions are not thread safe, ranges record their result instead
+        std::vector<int> visits(1000, 0);
+        std::atomic<bool> aligned{true};
+        jobs.parallelFor(visits.size(), 64, [&visits, &aligned](std::size_t begin, std::size_t end) {
+            aligned = aligned && begin % 64 == 0;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                ++visits[i];
+            }
+        });
+        CHECK(aligned);
+        CHECK(std::count(visits.begin(), visits.end(), 1) == 1000);
+    }
+}
+
+TEST_CASE("Job system waits for nested jobs and dependencies", "[foundation]")
+{
+    JobSystem jobs(4);
+    std::atomic<int> sum{0};
+    std::atomic<bool> orderViolated{false};
+
+    JobCounter first;
+    JobCounter second;
+    for (int i = 0; i < 16; ++i)
+    {
+        // Jobs submitting and waiting for jobs help instead of blocking a worker
+        jobs.submit(
+            [&jobs, &sum]() {
+                JobCounter nested;
+                for (int j = 0; j < 16; ++j)
+                {
+                    jobs.submit([&sum]() { ++sum; }, &nested);
+                }
+                jobs.wait(nested);
+            },
+            &first);
+    }
+    jobs.submit([&sum, &orderViolated]() { orderViolated = orderViolated || sum != 256; }, &second, &first);
+
+    jobs.wait(second);
+    CHECK(first.isDone());
+    CHECK(sum == 256);
+    CHECK_FALSE(orderViolated);
+}
+
+TEST_CASE("Job system waits for jobs running on other threads", "[foundation]")
+{
+    JobSystem jobs(2);
+    for (int round = 0; round < 100; ++round)
+    {
+        // The worker takes the only job, the waiting thread finds the queues empty and blocks
+        std::atomic<bool> finished{false};
+        JobCounter counter;
+        jobs.submit(
+            [&finished, round]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(round % 10 == 0 ? 5000 : 50));
+                finished = true;
+            },
+            &counter);
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        jobs.wait(counter);
+        CHECK(finished);
+    }
+}
@@ -0,0 +1,48 @@
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/AllocationCounter.h>
+#include <kern/foundation/MemoryReport.h>
+
+TEST_CASE("Memory report accumulates categories", "[foundation]")
+{
+    MemoryReport report;
+    report.add("graphics/texture", 2, 0, 4096);
+    report.add("graphics/texture", 1, 0, 1024);
+    report.add("resource/image", 3, 6000);
+
+    SMemoryUsage textures = report.getUsage("graphics/texture");
+    CHECK(textures.count == 3);
+    CHECK(textures.gpuBytes == 5120);
+    CHECK(report.getUsage("audio/sound").count == 0);
+
+    SMemoryUsage total = report.getTotal();
+    CHECK(total.count == 6);
+    CHECK(total.cpuBytes == 6000);
+    CHECK(total.gpuBytes == 5120);
+
+    nlohmann::json root = report.toJson();
+    CHECK(root["categories"]["resource/image"]["cpuBytes"] == 6000);
+    CHECK(root["total"]["gpuBytes"] == 5120);
+    CHECK(root["allocations"]["enabled"] == isAllocationCounterEnabled());
+}
+
+TEST_CASE("Frame allocation counts cover the last frame", "[foundation]")
+{
+    beginAllocationFrame();
+    std::string *text = new std::string(64, 'x');
+    beginAllocationFrame();
+    delete text;
+
+    if (isAllocationCounterEnabled())
+    {
+        // String object and its storage
+        CHECK(getFrameAllocationCount() >= 2);
+        CHECK(getFrameAllocatedBytes() >= 64);
+    }
+    else
+    {
+        CHECK(getFrameAllocationCount() == 0);
+    }
+}
@@ -0,0 +1,159 @@
+#include <memory>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/JobSystem.h>
+#include <kern/game/GameObject.h>
+#include <kern/game/GameWorld.h>
+#include <kern/game/IGameObjectController.h>
+#include <kern/game/MessageQueue.h>
+#include <kern/graphics/collision/Collidable.h>
+#include <kern/graphics/collision/CollisionSystem.h>
+
+// Moves the object along x, only writes to its object
+class MoveController : public IGameObjectController
+{
+   public:
+    void attach(GameObject *object) { m_object = object; }
+    void detach() { m_object = nullptr; }
+    void update(float dtime) { m_object->setPosition(m_object->getPosition() + glm::vec3(dtime, 0.f, 0.f)); }
+    void setActive(bool state) {}
+    void receiveMessage(Message message) {}
+    bool isParallel() const { return true; }
+
+   private:
+    GameObject *m_object = nullptr;
+};
+
+// Spawns a new object and deletes its own object on the first update
+class SpawnController : public IGameObjectController
+{
+   public:
+    SpawnController(GameWorld *world) : m_world(world) {}
+    void attach(GameObject *object) { m_object = object; }
+    void detach() { m_object = nullptr; }
+    void update(float dtime)
+    {
+        ++m_updateCount;
+        GameObject *object = new GameObject;
+        object->addController(std::make_shared<MoveController>());
+        m_world->addObject(object);
+        m_object->markDeleted();
+    }
+    void setActive(bool state) {}
+    void receiveMessage(Message message) {}
+
+    int m_updateCount = 0;
+
+   private:
+    GameWorld *m_world = nullptr;
+    GameObject *m_object = nullptr;
+};
+
+// Records received messages
+class MessageController : public IGameObjectController
+{
+   public:
+    void attach(GameObject *object) {}
+    void detach() {}
+    void update(float dtime) {}
+    void setActive(bool state) {}
+    void receiveMessage(Message message) {}
+    void handleMessage(const SMessage &message)
+    {
+        m_types.push_back(message.type);
+        if (const SDamageMessage *damage = message.get<SDamageMessage>())
+        {
+            m_damage += damage->damage;
+        }
+    }
+
+    std::vector<Message> m_types;
+    float m_damage = 0.f;
+};
+
+TEST_CASE("Parallel controllers update every object once", "[game]")
+{
+    JobSystem jobs(4);
+    GameWorld world(jobs);
+
+    std::vector<GameObject *> objects;
+    for (int i = 0; i < 1000; ++i)
+    {
+        GameObject *object = new GameObject;
+        object->addController(std::make_shared<MoveController>());
+        world.addObject(object);
+        objects.push_back(object);
+    }
+
+    world.update(1.f);
+    world.update(1.f);
+    for (GameObject *object : objects)
+    {
+        REQUIRE(object->getPosition().x == 2.f);
+    }
+}
+
+TEST_CASE("Structural changes are applied at the end of the update", "[game]")
+{
+    JobSystem jobs(1);
+    GameWorld world(jobs);
+    auto spawner = std::make_shared<SpawnController>(&world);
+    GameObject *object = new GameObject;
+    object->addController(spawner);
+    world.addObject(object);
+
+    // Spawner deletes itself, the spawned object is not updated in the same tick
+    world.update(1.f);
+    REQUIRE(spawner->m_updateCount == 1);
+
+    // Spawner is gone
+    world.update(1.f);
+    REQUIRE(spawner->m_updateCount == 1);
+    REQUIRE(spawner.use_count() == 1);
+}
+
+TEST_CASE("Messages are dispatched in batches by type", "[game]")
+{
+    GameObject object;
+    auto controller = std::make_shared<MessageController>();
+    object.addController(controller);
+
+    MessageQueue queue;
+    SDamageMessage damage;
+    damage.damage = 2.f;
+    queue.post(&object, Message::DEATH);
+    queue.post(&object, Message::DAMAGE, damage);
+    queue.post(&object, Message::DAMAGE, damage);
+    // Payload of the same size but another type is not taken as damage
+    queue.post(&object, Message::DAMAGE, 8.f);
+    REQUIRE(queue.size() == 4);
+
+    queue.dispatch();
+    REQUIRE(queue.size() == 0);
+    std::vector<Message> expected = {Message::DAMAGE, Message::DAMAGE, Message::DAMAGE, Message::DEATH};
+    REQUIRE(controller->m_types == expected);
+    REQUIRE(controller->m_damage == 4.f);
+}
+
+TEST_CASE("Collision damage is delivered as message", "[game]")
+{
+    JobSystem jobs(1);
+    CollisionSystem collisionSystem(jobs);
+    unsigned int playerGroup = collisionSystem.getNewGroupId();
+    unsigned int enemyGroup = collisionSystem.getNewGroupId();
+
+    GameWorld world(jobs);
+    auto controller = std::make_shared<MessageController>();
+    GameObject *object = new GameObject;
+    object->addController(controller);
+    object->setCollidable(collisionSystem.add(AABBox(), enemyGroup));
+    world.addObject(object);
+
+    Collidable *bullet = collisionSystem.add(AABBox(), playerGroup);
+    bullet->setDamage(50.f);
+
+    collisionSystem.update();
+    world.update(1.f);
+    REQUIRE(controller->m_damage == 50.f);
+}
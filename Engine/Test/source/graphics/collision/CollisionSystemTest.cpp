@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/foundation/JobSystem.h>
+#include <kern/graphics/collision/Collidable.h>
+#include <kern/graphics/collision/CollisionSystem.h>
+
+// Fills the collision system with randomly placed collidables split over two groups
+static std::vector<Collidable *> createCollidables(CollisionSystem &system, unsigned int count)
+{
+    unsigned int groups[2] = {system.getNewGroupId(), system.getNewGroupId()};
+
+    // Keep the density roughly constant for all counts
+    float extent = std::cbrt((float)count) * 4.f;
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.5f, 2.f);
+
+    std::vector<Collidable *> collidables;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        Collidable *collidable = system.add(AABBox(), groups[i % 2]);
+        collidable->setTranslation(glm::vec3(position(generator), position(generator), position(generator)));
+        collidable->setScale(glm::vec3(size(generator)));
+        collidable->setDamage(1.f + (float)(i % 7) * 0.1f);
+        collidables.push_back(collidable);
+    }
+    return collidables;
+}
+
+// Runs a few updates and returns the received damage per collidable
+static std::vector<float> collectDamage(unsigned int count, unsigned int threadCount)
+{
+    JobSystem jobs(threadCount);
+    CollisionSystem system(jobs);
+    auto collidables = createCollidables(system, count);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        system.update();
+    }
+
+    std::vector<float> damage;
+    for (Collidable *collidable : collidables)
+    {
+        damage.push_back(collidable->getDamageReceived());
+    }
+    return damage;
+}
+
+TEST_CASE("Collision damage between groups", "[collision]")
+{
+    JobSystem jobs(1);
+    CollisionSystem system(jobs);
+    unsigned int playerGroup = system.getNewGroupId();
+    unsigned int enemyGroup = system.getNewGroupId();
+
+    Collidable *player = system.add(AABBox(), playerGroup);
+    player->setScale(glm::vec3(1.f));
+    player->setDamage(10.f);
+
+    Collidable *bullet = system.add(AABBox(), playerGroup);
+    bullet->setScale(glm::vec3(1.f));
+    bullet->setTranslation(glm::vec3(0.5f, 0.f, 0.f));
+    bullet->setDamage(50.f);
+
+    Collidable *enemy = system.add(AABBox(), enemyGroup);
+    enemy->setScale(glm::vec3(1.f));
+    enemy->setTranslation(glm::vec3(1.5f, 0.f, 0.f));
+    enemy->setDamage(5.f);
+
+    system.update();
+
+    // Same group does not collide
+    REQUIRE(player->getDamageReceived() == 5.f);
+    REQUIRE(bullet->getDamageReceived() == 5.f);
+    REQUIRE(enemy->getDamageReceived() == 60.f);
+
+    // Inactive entities are ignored
+    enemy->setCollidable(false);
+    system.update();
+    REQUIRE(player->getDamageReceived() == 0.f);
+    REQUIRE(enemy->getDamageReceived() == 0.f);
+}
+
+TEST_CASE("Continuous collision of fast entities", "[collision]")
+{
+    JobSystem jobs(1);
+    CollisionSystem system(jobs);
+    unsigned int playerGroup = system.getNewGroupId();
+    unsigned int enemyGroup = system.getNewGroupId();
+
+    Collidable *bullet = system.add(AABBox(), playerGroup);
+    bullet->setScale(glm::vec3(0.1f));
+    bullet->setTranslation(glm::vec3(-10.f, 0.f, 0.f));
+    bullet->setDamage(50.f);
+
+    Collidable *enemy = system.add(AABBox(), enemyGroup);
+    enemy->setScale(glm::vec3(1.f));
+
+    // Initial placement is not swept
+    system.update();
+    REQUIRE(enemy->getDamageReceived() == 0.f);
+
+    SECTION("Discrete testing misses")
+    {
+        bullet->setTranslation(glm::vec3(10.f, 0.f, 0.f));
+        system.update();
+        REQUIRE(enemy->getDamageReceived() == 0.f);
+    }
+
+    SECTION("Continuous testing hits")
+    {
+        bullet->setContinuous(true);
+        bullet->setTranslation(glm::vec3(10.f, 0.f, 0.f));
+        system.update();
+        REQUIRE(enemy->getDamageReceived() == 50.f);
+
+        // Bullet touches the enemy after 8.9 of 20 units, the enemy did not move
+        REQUIRE(std::abs(bullet->getTimeOfImpact() - 0.445f) < 0.001f);
+        REQUIRE(std::abs(bullet->getContactTranslation().x + 1.1f) < 0.001f);
+        REQUIRE(enemy->getContactTranslation() == glm::vec3(0.f));
+
+        // Sweep starts at the last update
+        bullet->setTranslation(glm::vec3(30.f, 0.f, 0.f));
+        system.update();
+        REQUIRE(enemy->getDamageReceived() == 0.f);
+        REQUIRE(bullet->getTimeOfImpact() == 1.f);
+    }
+}
+
+TEST_CASE("Swept box time of impact", "[collision]")
+{
+    AABBox moving;
+    moving.setMid(glm::vec3(-4.f, 0.f, 0.f));
+    moving.setHalfWidths(glm::vec3(1.f));
+    AABBox still;
+    still.setHalfWidths(glm::vec3(1.f));
+
+    float timeOfImpact = -1.f;
+    REQUIRE(collides(moving, glm::vec3(8.f, 0.f, 0.f), still, glm::vec3(0.f), timeOfImpact));
+    REQUIRE(timeOfImpact == 0.25f);
+    REQUIRE_FALSE(collides(moving, glm::vec3(1.f, 0.f, 0.f), still, glm::vec3(0.f), timeOfImpact));
+    REQUIRE_FALSE(collides(moving, glm::vec3(8.f, 12.f, 0.f), still, glm::vec3(0.f), timeOfImpact));
+}
+
+TEST_CASE("Collision results do not depend on the thread count", "[collision]")
+{
+    const unsigned int count = 5000;
+    std::vector<float> reference = collectDamage(count, 1);
+    for (unsigned int threadCount : {2u, 3u, 8u})
+    {
+        REQUIRE(collectDamage(count, threadCount) == reference);
+    }
+}
+
+TEST_CASE("Axis aligned rays starting on a box plane", "[collision]")
+{
+    JobSystem jobs(1);
+    CollisionSystem system(jobs);
+    Collidable *collidable = system.add(AABBox(), system.getNewGroupId());
+    collidable->setTranslation(glm::vec3(5.f, 0.f, 0.f));
+    system.update();
+    glm::vec3 min = collidable->getAABBox().getMid() - collidable->getAABBox().getHalfWidths();
+    glm::vec3 max = collidable->getAABBox().getMid() + collidable->getAABBox().getHalfWidths();
+
+    // Origin on the y and z planes of the box, the zero direction components must not give NaN
+    SRayHit hit;
+    REQUIRE(system.rayCast(glm::vec3(0.f, min.y, max.z), glm::vec3(1.f, 0.f, 0.f), 100.f, hit));
+    REQUIRE(hit.entity == collidable);
+    REQUIRE(hit.distance == min.x);
+    REQUIRE_FALSE(system.rayCast(glm::vec3(0.f, max.y + 0.1f, 0.f), glm::vec3(1.f, 0.f, 0.f), 100.f, hit));
+    REQUIRE_FALSE(system.rayCast(glm::vec3(0.f, min.y, 0.f), glm::vec3(-1.f, 0.f, 0.f), 100.f, hit));
+}
+
+TEST_CASE("Spatial queries match brute force", "[collision]")
+{
+    JobSystem jobs(1);
+    CollisionSystem system(jobs);
+    auto collidables = createCollidables(system, 2000);
+    system.update();
+
+    std::vector<Collidable *> results(collidables.size());
+    std::vector<float> distances(collidables.size());
+
+    SECTION("Ray cast")
+    {
+        // Aim through the first collidable
+        glm::vec3 origin = collidables[0]->getAABBox().getMid();
+        origin.x = -100.f;
+        glm::vec3 direction(1.f, 0.f, 0.f);
+
+        // Closest box entry along the ray
+        Collidable *expected = nullptr;
+        float expectedDistance = 1000.f;
+        for (Collidable *collidable : collidables)
+        {
+            glm::vec3 min = collidable->getAABBox().getMid() - collidable->getAABBox().getHalfWidths();
+            glm::vec3 max = collidable->getAABBox().getMid() + collidable->getAABBox().getHalfWidths();
+            if (min.y <= origin.y && origin.y <= max.y && min.z <= origin.z && origin.z <= max.z &&
+                min.x - origin.x < expectedDistance)
+            {
+                expectedDistance = min.x - origin.x;
+                expected = collidable;
+            }
+        }
+
+        SRayHit hit;
+        REQUIRE(expected != nullptr);
+        REQUIRE(system.rayCast(origin, direction, 1000.f, hit));
+        REQUIRE(hit.entity == expected);
+        REQUIRE(hit.distance == expectedDistance);
+        REQUIRE_FALSE(system.rayCast(origin, direction, 1.f, hit));
+    }
+
+    SECTION("Box overlap")
+    {
+        AABBox box;
+        box.setMid(glm::vec3(3.f, -2.f, 1.f));
+        box.setHalfWidths(glm::vec3(10.f));
+
+        std::size_t expected = 0;
+        for (Collidable *collidable : collidables)
+        {
+            expected += collides(box, collidable->getAABBox()) ? 1 : 0;
+        }
+        REQUIRE(expected > 0);
+        REQUIRE(system.overlap(box, results.data(), results.size()) == expected);
+        REQUIRE(system.overlap(box, results.data(), 3) == 3);
+    }
+
+    SECTION("Sphere overlap ignores the group")
+    {
+        BoundingSphere sphere(glm::vec3(0.f), 10.f);
+        std::size_t count = system.overlap(sphere, results.data(), results.size(), collidables[0]->getGroupId());
+        REQUIRE(count > 0);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            REQUIRE(results[i]->getGroupId() != collidables[0]->getGroupId());
+        }
+    }
+
+    SECTION("Nearest")
+    {
+        glm::vec3 point(5.f, 5.f, 5.f);
+        std::vector<float> expected;
+        for (Collidable *collidable : collidables)
+        {
+            expected.push_back(glm::distance(collidable->getAABBox().getMid(), point));
+        }
+        std::sort(expected.begin(), expected.end());
+
+        const std::size_t k = 16;
+        REQUIRE(system.findNearest(point, k, results.data(), distances.data()) == k);
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            REQUIRE(std::abs(distances[i] - expected[i]) < 0.001f);
+        }
+    }
+
+    SECTION("Removed entities are skipped")
+    {
+        for (Collidable *collidable : collidables)
+        {
+            collidable->markDeleted();
+        }
+        BoundingSphere sphere(glm::vec3(0.f), 1000.f);
+        REQUIRE(system.overlap(sphere, results.data(), results.size()) == 0);
+    }
+
+    SECTION("Removed entities leave the tree")
+    {
+        BoundingSphere sphere(glm::vec3(0.f), 1000.f);
+        system.remove(collidables[0]);
+        system.remove(collidables[1000]);
+        std::size_t count = system.overlap(sphere, results.data(), results.size());
+        REQUIRE(count == collidables.size() - 2);
+        REQUIRE(std::find(results.begin(), results.begin() + count, collidables[1000]) == results.begin() + count);
+    }
+}
@@ -0,0 +1,155 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <glm/ext.hpp>
+
+#include <kern/graphics/collision/Frustum.h>
+#include <kern/graphics/collision/FrustumCulling.h>
+
+static Frustum createFrustum()
+{
+    glm::mat4 view = glm::lookAt(glm::vec3(1.f, 2.f, 3.f), glm::vec3(10.f, 0.f, -20.f), glm::vec3(0.f, 1.f, 0.f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+    Frustum frustum;
+    frustum.setFromViewProjectionClipSpaceApproach(view, projection);
+    return frustum;
+}
+
+// Reference box test against all planes with the projected half widths
+static bool isBoxVisible(const Frustum &frustum, const AABBox &box)
+{
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        glm::vec4 plane = frustum.getPlanes()[i].getCoefficients();
+        float radius = glm::dot(glm::abs(glm::vec3(plane)), box.getHalfWidths());
+        if (glm::dot(glm::vec3(plane), box.getMid()) + plane.w < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Batch sphere culling matches the single sphere test", "[collision]")
+{
+    Frustum frustum = createFrustum();
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<float> position(-120.f, 120.f);
+    std::uniform_real_distribution<float> radius(0.f, 5.f);
+
+    // Counts with and without remainder after full blocks
+    for (std::size_t count : {0u, 3u, 64u, 1003u})
+    {
+        SSphereArray spheres;
+        spheres.resize(count);
+        std::vector<bool> expected;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            BoundingSphere sphere(glm::vec3(position(generator), position(generator), position(generator)),
+                                  radius(generator));
+            spheres.set(i, sphere);
+            expected.push_back(frustum.isInsideOrIntersects(sphere));
+        }
+
+        std::vector<std::uint32_t> mask(getCullingMaskSize(count), 0xFFFFFFFFu);
+        std::vector<unsigned int> visible(count);
+        std::size_t maskCount = cullSpheres(frustum, spheres, mask.data());
+        std::size_t visibleCount = getVisibleSpheres(frustum, spheres, visible.data());
+        REQUIRE(maskCount == visibleCount);
+
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bool bit = (mask[i / 32] >> (i % 32) & 1u) != 0;
+            REQUIRE(bit == expected[i]);
+            if (expected[i])
+            {
+                REQUIRE(next < visibleCount);
+                REQUIRE(visible[next++] == i);
+            }
+        }
+        REQUIRE(next == visibleCount);
+    }
+}
+
+TEST_CASE("Batch box culling", "[collision]")
+{
+    Frustum frustum = createFrustum();
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-120.f, 120.f);
+    std::uniform_real_distribution<float> size(0.f, 5.f);
+
+    const std::size_t count = 1001;
+    SBoxArray boxes;
+    boxes.resize(count);
+    std::vector<bool> expected;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        AABBox box;
+        box.setMid(glm::vec3(position(generator), position(generator), position(generator)));
+        box.setHalfWidths(glm::vec3(size(generator), size(generator), size(generator)));
+        boxes.set(i, box);
+        expected.push_back(isBoxVisible(frustum, box));
+    }
+
+    std::vector<std::uint32_t> mask(getCullingMaskSize(count));
+    std::vector<unsigned int> visible(count);
+    std::size_t visibleCount = getVisibleBoxes(frustum, boxes, visible.data());
+    REQUIRE(cullBoxes(frustum, boxes, mask.data()) == visibleCount);
+    CHECK(visibleCount > 0);
+    CHECK(visibleCount < count);
+
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        REQUIRE(((mask[i / 32] >> (i % 32) & 1u) != 0) == expected[i]);
+        if (expected[i])
+        {
+            REQUIRE(visible[next++] == i);
+        }
+    }
+}
+
+TEST_CASE("Multi-view culling matches the single view tests", "[collision]")
+{
+    Frustum frustum = createFrustum();
+    Frustum shadowFrustum;
+    shadowFrustum.setFromViewProjectionClipSpaceApproach(
+        glm::lookAt(glm::vec3(0.f), glm::vec3(-0.3f, -1.f, -0.2f), glm::vec3(0.f, 1.f, 0.f)),
+        glm::ortho(-50.f, 50.f, -50.f, 50.f, -100.f, 100.f));
+    BoundingSphere light(glm::vec3(20.f, 0.f, -10.f), 30.f);
+    std::vector<SCullingView> views = {SCullingView(frustum), SCullingView(shadowFrustum), SCullingView(light)};
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> position(-120.f, 120.f);
+    std::uniform_real_distribution<float> radius(0.f, 5.f);
+
+    const std::size_t count = 1003;
+    SSphereArray spheres;
+    spheres.resize(count);
+    std::vector<BoundingSphere> reference;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        reference.emplace_back(glm::vec3(position(generator), position(generator), position(generator)),
+                               radius(generator));
+        spheres.set(i, reference.back());
+    }
+
+    std::vector<std::uint32_t> masks(count, 0xFFFFFFFFu);
+    getViewMasks(views.data(), views.size(), spheres, masks.data());
+    std::size_t sphereHits = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float distance = glm::length(reference[i].getPosition() - light.getPosition());
+        bool inLight = distance <= reference[i].getRadius() + light.getRadius();
+        REQUIRE(((masks[i] & 1u) != 0) == frustum.isInsideOrIntersects(reference[i]));
+        REQUIRE(((masks[i] & 2u) != 0) == shadowFrustum.isInsideOrIntersects(reference[i]));
+        REQUIRE(((masks[i] & 4u) != 0) == inLight);
+        REQUIRE((masks[i] >> 3) == 0u);
+        sphereHits += inLight ? 1 : 0;
+    }
+    CHECK(sphereHits > 0);
+}
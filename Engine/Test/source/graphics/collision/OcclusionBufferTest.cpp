@@ -0,0 +1,52 @@
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <glm/ext.hpp>
+
+#include <kern/foundation/JobSystem.h>
+#include <kern/graphics/collision/OcclusionBuffer.h>
+
+// Camera at the origin looking down -z, wall of 10x10 units at distance 10
+static void drawWall(OcclusionBuffer &buffer)
+{
+    glm::mat4 view = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+    glm::mat4 projection = glm::perspective(glm::radians(90.f), 2.f, 0.1f, 100.f);
+    std::vector<float> vertices = {-5.f, -5.f, 0.f, 5.f, -5.f, 0.f, 5.f, 5.f, 0.f, -5.f, 5.f, 0.f};
+    std::vector<unsigned int> indices = {0, 1, 2, 0, 2, 3};
+    buffer.begin(projection * view);
+    buffer.addOccluder(glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, -10.f)), vertices, indices);
+    buffer.rasterize();
+}
+
+TEST_CASE("Occlusion buffer culls spheres behind occluders", "[collision]")
+{
+    JobSystem jobs(1);
+    OcclusionBuffer buffer(jobs);
+    drawWall(buffer);
+    REQUIRE(buffer.getTriangleCount() == 2);
+
+    // Center pixel is covered, corners are not
+    CHECK(buffer.getDepth(buffer.getWidth() / 2, buffer.getHeight() / 2) < 1.f);
+    CHECK(buffer.getDepth(0, 0) == 1.f);
+
+    CHECK_FALSE(buffer.isVisible(BoundingSphere(glm::vec3(0.f, 0.f, -30.f), 1.f)));
+    CHECK_FALSE(buffer.isVisible(BoundingSphere(glm::vec3(2.f, -2.f, -20.f), 0.5f)));
+    // In front of the wall, beside it, reaching in front of it, crossing the near plane
+    CHECK(buffer.isVisible(BoundingSphere(glm::vec3(0.f, 0.f, -5.f), 1.f)));
+    CHECK(buffer.isVisible(BoundingSphere(glm::vec3(20.f, 0.f, -30.f), 1.f)));
+    CHECK(buffer.isVisible(BoundingSphere(glm::vec3(0.f, 0.f, -29.f), 20.f)));
+    CHECK(buffer.isVisible(BoundingSphere(glm::vec3(0.f, 0.f, 0.f), 1.f)));
+
+    // Tiles rasterized in parallel give the same depth
+    JobSystem parallelJobs(4);
+    OcclusionBuffer parallel(parallelJobs);
+    drawWall(parallel);
+    for (unsigned int y = 0; y < buffer.getHeight(); ++y)
+    {
+        for (unsigned int x = 0; x < buffer.getWidth(); ++x)
+        {
+            REQUIRE(parallel.getDepth(x, y) == buffer.getDepth(x, y));
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/graphics/resource/ShaderCache.h>
+
+TEST_CASE("Shader cache keys cover every part", "[resource]")
+{
+    std::string key = ShaderCache::getKey({"vendor", "renderer", "version", "void main() {}", "", ""});
+    CHECK(key.size() == 16);
+    CHECK(key == ShaderCache::getKey({"vendor", "renderer", "version", "void main() {}", "", ""}));
+
+    // Changed source, driver or stage assignment change the key
+    CHECK(key != ShaderCache::getKey({"vendor", "renderer", "version", "void main() { }", "", ""}));
+    CHECK(key != ShaderCache::getKey({"vendor", "renderer", "version 2", "void main() {}", "", ""}));
+    CHECK(key != ShaderCache::getKey({"vendor", "renderer", "version", "", "void main() {}", ""}));
+}
+
+TEST_CASE("Shader cache stores and loads binaries", "[resource]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "kern_shader_cache_test";
+    std::filesystem::remove_all(directory);
+    ShaderCache cache(directory.string());
+
+    GLenum format = 0;
+    std::vector<char> binary;
+    std::string key = ShaderCache::getKey({"program"});
+    CHECK_FALSE(cache.load(key, format, binary));
+
+    SECTION("Round trip")
+    {
+        std::vector<char> stored = {1, 2, 3, 4, 5, 6, 7};
+        REQUIRE(cache.store(key, 42, stored));
+        REQUIRE(cache.load(key, format, binary));
+        CHECK(format == 42);
+        CHECK(binary == stored);
+
+        // Replaced by the next store
+        stored.pop_back();
+        REQUIRE(cache.store(key, 43, stored));
+        REQUIRE(cache.load(key, format, binary));
+        CHECK(format == 43);
+        CHECK(binary == stored);
+    }
+
+    SECTION("Corrupt files are rejected")
+    {
+        REQUIRE(cache.store(key, 42, {1, 2, 3, 4}));
+        std::string file = (directory / (key + ".bin")).string();
+        std::filesystem::resize_file(file, std::filesystem::file_size(file) - 1);
+        CHECK_FALSE(cache.load(key, format, binary));
+
+        std::ofstream(file, std::ios::binary | std::ios::trunc) << "not a binary";
+        CHECK_FALSE(cache.load(key, format, binary));
+    }
+
+    SECTION("Oversized length fields are rejected")
+    {
+        REQUIRE(cache.store(key, 42, {1, 2, 3, 4}));
+        std::string file = (directory / (key + ".bin")).string();
+        std::fstream stream(file, std::ios::binary | std::ios::in | std::ios::out);
+        std::uint64_t size = 0xFFFFFFFFFFFFull;
+        stream.seekp(12);
+        stream.write((const char *)&size, sizeof(size));
+        stream.close();
+        CHECK_FALSE(cache.load(key, format, binary));
+        CHECK(binary.empty());
+    }
+
+    std::filesystem::remove_all(directory);
+}
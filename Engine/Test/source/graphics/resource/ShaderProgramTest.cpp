@@ -0,0 +1,42 @@
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/graphics/Window.h>
+#include <kern/graphics/resource/ShaderProgram.h>
+#include <kern/graphics/resource/TShaderObject.h>
+
+TEST_CASE("Shader programs report early resolved link failures", "[resource]")
+{
+    Window window;
+    bool hasContext = false;
+    try
+    {
+        hasContext = window.init(64, 64, "ShaderProgramTest", false);
+    }
+    catch (const std::runtime_error &)
+    {
+        hasContext = false;
+    }
+    if (!hasContext)
+    {
+        SKIP("No GL context available.");
+    }
+
+    // Both stages compile, the undefined function only fails the link
+    TShaderObject<GL_VERTEX_SHADER> vertex("#version 330 core\nvoid main() { gl_Position = vec4(0.0); }\n");
+    TShaderObject<GL_FRAGMENT_SHADER> fragment(
+        "#version 330 core\nout vec4 color;\nvec4 undefinedColor();\nvoid main() { color = undefinedColor(); }\n");
+    REQUIRE(vertex.isValid());
+    REQUIRE(fragment.isValid());
+
+    ShaderProgram program(&vertex, nullptr, nullptr, nullptr, &fragment, false);
+    REQUIRE(program.isPending());
+
+    // The first query resolves the link before the owner does
+    CHECK_FALSE(program.isValid());
+    CHECK_FALSE(program.isPending());
+    CHECK_FALSE(program.resolve());
+    CHECK_FALSE(program.getErrorString().empty());
+}
@@ -0,0 +1,53 @@
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/graphics/Window.h>
+#include <kern/graphics/resource/Texture.h>
+#include <kern/graphics/resource/TextureUploader.h>
+
+TEST_CASE("Texture uploader splits levels larger than the budget", "[resource]")
+{
+    Window window;
+    bool hasContext = false;
+    try
+    {
+        hasContext = window.init(64, 64, "TextureUploaderTest", false);
+    }
+    catch (const std::runtime_error &)
+    {
+        hasContext = false;
+    }
+    if (!hasContext)
+    {
+        SKIP("No GL context available.");
+    }
+
+    // 64 KiB level with a 16 KiB budget, needs four frames
+    const unsigned int size = 128;
+    std::vector<unsigned char> data(size * size * 4);
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (unsigned char)(i * 7 + i / 251);
+    }
+    Image image(data, size, size, ColorFormat::RGBA32);
+
+    Texture texture;
+    REQUIRE(texture.initStorage(image));
+    TextureUploader uploader(16 * 1024, 2);
+    uploader.enqueue(&texture, image);
+    REQUIRE(uploader.getPendingBytes() == data.size());
+
+    uploader.update();
+    CHECK(uploader.getPendingBytes() == data.size() - 16 * 1024);
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        uploader.update();
+    }
+    CHECK(uploader.getPendingBytes() == 0);
+
+    std::vector<unsigned char> uploaded(data.size());
+    glGetTextureImage(texture.getId(), 0, GL_RGBA, GL_UNSIGNED_BYTE, (GLsizei)uploaded.size(), uploaded.data());
+    CHECK(uploaded == data);
+}
@@ -0,0 +1,122 @@
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/graphics/scene/InterpolatedScene.h>
+
+// Stores objects only, enough to observe what the render thread applies
+class ObjectScene : public IScene
+{
+   public:
+    SceneObjectId createObject(ResourceId model, const glm::vec3 &position, const glm::quat &rotation,
+                               const glm::vec3 &scale) override
+    {
+        return createObject(model, InvalidResource, position, rotation, scale);
+    }
+
+    SceneObjectId createObject(ResourceId mesh, ResourceId material, const glm::vec3 &position,
+                               const glm::quat &rotation, const glm::vec3 &scale) override
+    {
+        m_positions.push_back(position);
+        return (SceneObjectId)m_positions.size() - 1;
+    }
+
+    bool getObject(SceneObjectId id, ResourceId &mesh, ResourceId &material, glm::vec3 &position,
+                   glm::quat &rotation, glm::vec3 &scale, bool &visible) const override
+    {
+        position = m_positions.at(id);
+        return true;
+    }
+
+    void setObject(SceneObjectId id, ResourceId mesh, ResourceId material, const glm::vec3 &position,
+                   const glm::quat &rotation, const glm::vec3 &scale, bool visible) override
+    {
+        m_positions.at(id) = position;
+    }
+
+    SceneObjectId createPointLight(const glm::vec3 &, float, const glm::vec3 &, float, bool) override
+    {
+        return InvalidObject;
+    }
+    bool getPointLight(SceneObjectId, glm::vec3 &, float &, glm::vec3 &, float &, bool &) const override
+    {
+        return false;
+    }
+    void setPointLight(SceneObjectId, const glm::vec3 &, float, const glm::vec3 &, float, bool) override {}
+    SceneObjectId createDirectionalLight(const glm::vec3 &, const glm::vec3 &, float, bool) override
+    {
+        return InvalidObject;
+    }
+    bool getDirectionalLight(SceneObjectId, glm::vec3 &, glm::vec3 &, float &, bool &) const override
+    {
+        return false;
+    }
+    void setDirectionalLight(SceneObjectId, const glm::vec3 &, const glm::vec3 &, float, bool) override {}
+    void setAmbientLight(const glm::vec3 &, float) override {}
+    bool getAmbientLight(glm::vec3 &, float &) const override { return false; }
+    void getVisibleObjects(const ICamera &, ISceneQuery &) const override {}
+    void getVisibleLights(const ICamera &, ISceneQuery &) const override {}
+    void setOccluder(SceneObjectId, const std::vector<float> &, const std::vector<unsigned int> &) override {}
+    unsigned int getVisibleObjects(const SCullingView *, std::size_t, ISceneQuery *const *) const override
+    {
+        return 0;
+    }
+
+    std::vector<glm::vec3> m_positions;
+};
+
+TEST_CASE("Interpolated scene blends published snapshots", "[scene]")
+{
+    ObjectScene scene;
+    InterpolatedScene interpolated(scene);
+    SceneObjectId id = interpolated.createObject(1, 2, glm::vec3(0.f), glm::quat(), glm::vec3(1.f));
+    REQUIRE(id == 0);
+
+    interpolated.publish();
+    interpolated.setObject(id, 1, 2, glm::vec3(10.f, 0.f, 0.f), glm::quat(), glm::vec3(1.f), true);
+
+    // Not visible to the render thread before the tick is published
+    interpolated.apply(0.5f);
+    CHECK(scene.m_positions[0].x == 0.f);
+
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+    ResourceId mesh, material;
+    bool visible;
+    REQUIRE(interpolated.getObject(id, mesh, material, position, rotation, scale, visible));
+    CHECK(position.x == 10.f);
+
+    interpolated.publish();
+    interpolated.apply(0.f);
+    CHECK(scene.m_positions[0].x == 0.f);
+    interpolated.apply(0.5f);
+    CHECK(scene.m_positions[0].x == 5.f);
+    interpolated.apply(2.f);
+    CHECK(scene.m_positions[0].x == 10.f);
+
+    // Resting objects stay at the newest state
+    interpolated.publish();
+    interpolated.apply(0.25f);
+    CHECK(scene.m_positions[0].x == 10.f);
+}
+
+TEST_CASE("Interpolated scene blends consecutive ticks after skipped snapshots", "[scene]")
+{
+    ObjectScene scene;
+    InterpolatedScene interpolated(scene);
+    SceneObjectId id = interpolated.createObject(1, 2, glm::vec3(0.f), glm::quat(), glm::vec3(1.f));
+    interpolated.publish();
+    interpolated.apply(1.f);
+
+    // Two ticks between two renders, e.g. while catching up
+    interpolated.setObject(id, 1, 2, glm::vec3(10.f, 0.f, 0.f), glm::quat(), glm::vec3(1.f), true);
+    interpolated.publish();
+    interpolated.setObject(id, 1, 2, glm::vec3(20.f, 0.f, 0.f), glm::quat(), glm::vec3(1.f), true);
+    interpolated.publish();
+
+    interpolated.apply(0.f);
+    CHECK(scene.m_positions[0].x == 10.f);
+    interpolated.apply(0.5f);
+    CHECK(scene.m_positions[0].x == 15.f);
+}
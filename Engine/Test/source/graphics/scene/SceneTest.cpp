@@ -0,0 +1,53 @@
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <glm/ext.hpp>
+
+#include <kern/foundation/JobSystem.h>
+#include <kern/graphics/camera/Camera.h>
+#include <kern/graphics/scene/Scene.h>
+#include <kern/graphics/scene/SceneQuery.h>
+
+// Returns the ids of the objects the camera query returns
+static std::vector<SceneObjectId> getVisibleObjects(const Scene &scene, const Camera &camera)
+{
+    SceneQuery query;
+    scene.getVisibleObjects(camera, query);
+    std::vector<SceneObjectId> ids;
+    while (query.hasNextObject())
+    {
+        ids.push_back(query.getNextObject());
+    }
+    return ids;
+}
+
+TEST_CASE("Scene culls objects behind occluders", "[scene]")
+{
+    JobSystem jobs(4);
+    Scene scene(nullptr, jobs);
+
+    // Camera at the origin looking down -z, wall of 10x10 units at distance 10
+    Camera camera;
+    camera.setView(glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f)));
+    camera.setProjection(glm::perspective(glm::radians(90.f), 2.f, 0.1f, 100.f));
+
+    // Occluder slightly behind the wall object center, which stays visible itself
+    glm::quat rotation(1.f, 0.f, 0.f, 0.f);
+    SceneObjectId wall = scene.createObject(InvalidResource, glm::vec3(0.f, 0.f, -10.f), rotation, glm::vec3(1.f));
+    SceneObjectId front = scene.createObject(InvalidResource, glm::vec3(0.f, 0.f, -5.f), rotation, glm::vec3(1.f));
+    SceneObjectId behind = scene.createObject(InvalidResource, glm::vec3(1.f, 1.f, -30.f), rotation, glm::vec3(1.f));
+    SceneObjectId beside = scene.createObject(InvalidResource, glm::vec3(20.f, 0.f, -30.f), rotation, glm::vec3(1.f));
+    std::vector<float> vertices = {-5.f, -5.f, -1.f, 5.f, -5.f, -1.f, 5.f, 5.f, -1.f, -5.f, 5.f, -1.f};
+    scene.setOccluder(wall, vertices, {0, 1, 2, 0, 2, 3});
+
+    std::vector<SceneObjectId> visible = {wall, front, beside};
+    CHECK(getVisibleObjects(scene, camera) == visible);
+    CHECK(camera.getFeatureInfo().culledObjectCount == 1);
+
+    // Removed occluder
+    scene.setOccluder(wall, {}, {});
+    visible = {wall, front, behind, beside};
+    CHECK(getVisibleObjects(scene, camera) == visible);
+    CHECK(camera.getFeatureInfo().culledObjectCount == 0);
+}
@@ -0,0 +1,172 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <kern/resource/EncodeImage.h>
+#include <kern/resource/LoadImage.h>
+#include <kern/resource/SaveImage.h>
+
+// Horizontal red and vertical green gradient with constant blue and alpha
+static Image createGradient(unsigned int width, unsigned int height)
+{
+    std::vector<unsigned char> data;
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            data.push_back((unsigned char)(x * 255 / (width - 1)));
+            data.push_back((unsigned char)(y * 255 / (height - 1)));
+            data.push_back(64);
+            data.push_back(255);
+        }
+    }
+    return Image(data, width, height, ColorFormat::RGBA32);
+}
+
+TEST_CASE("Image sizes of block compressed formats", "[resource]")
+{
+    CHECK(getImageSize(ColorFormat::RGB24, 5, 3) == 45);
+    // Partial blocks are stored completely
+    CHECK(getImageSize(ColorFormat::BC1, 5, 3) == 16);
+    CHECK(getImageSize(ColorFormat::BC7, 8, 8) == 64);
+    // 8x8, 4x4, 2x2, 1x1
+    CHECK(getImageSize(ColorFormat::BC5, 8, 8, 4) == 64 + 16 + 16 + 16);
+    CHECK(getImageSize(ColorFormat::GreyScale8, 8, 2, 4) == 16 + 4 + 2 + 1);
+    // Block counts do not wrap for the largest dimensions
+    CHECK(getImageSize(ColorFormat::BC1, 0xFFFFFFFF, 4) == (std::size_t)0x40000000 * 8);
+}
+
+TEST_CASE("Block compression with mip levels", "[resource]")
+{
+    Image source = createGradient(16, 8);
+
+    SECTION("BC1 solid color")
+    {
+        Image solid(std::vector<unsigned char>(4 * 4 * 3, 0), 4, 4, ColorFormat::RGB24);
+        for (std::size_t i = 0; i < solid.m_data.size(); i += 3)
+        {
+            solid.m_data[i] = 255;
+        }
+        Image result;
+        REQUIRE(encode(solid, ColorFormat::BC1, false, result));
+        REQUIRE(result.m_data.size() == 8);
+        // Pure red in RGB565 for both end points, all indices select the first end point
+        std::vector<unsigned char> expected = {0x00, 0xF8, 0x00, 0xF8, 0, 0, 0, 0};
+        CHECK(result.m_data == expected);
+    }
+
+    SECTION("Full mip chain")
+    {
+        for (ColorFormat format : {ColorFormat::BC1, ColorFormat::BC3, ColorFormat::BC5, ColorFormat::BC7})
+        {
+            Image result;
+            REQUIRE(encode(source, format, true, result));
+            CHECK(result.m_format == format);
+            CHECK(result.m_width == 16);
+            CHECK(result.m_height == 8);
+            CHECK(result.m_levels == 5);
+            CHECK(result.m_data.size() == getImageSize(format, 16, 8, 5));
+        }
+    }
+
+    SECTION("BC7 blocks use mode 6")
+    {
+        Image result;
+        REQUIRE(encode(source, ColorFormat::BC7, false, result));
+        for (std::size_t i = 0; i < result.m_data.size(); i += 16)
+        {
+            CHECK((result.m_data[i] & 0x7F) == 0x40);
+        }
+    }
+
+    SECTION("Unsupported formats")
+    {
+        Image result;
+        CHECK_FALSE(encode(source, ColorFormat::RGB24, true, result));
+        Image compressed;
+        REQUIRE(encode(source, ColorFormat::BC1, false, compressed));
+        CHECK_FALSE(encode(compressed, ColorFormat::BC7, true, result));
+    }
+}
+
+TEST_CASE("DDS save and load keeps mip levels", "[resource]")
+{
+    Image source = createGradient(32, 16);
+    for (ColorFormat format : {ColorFormat::BC1, ColorFormat::BC3, ColorFormat::BC5, ColorFormat::BC7})
+    {
+        Image baked;
+        REQUIRE(encode(source, format, true, baked));
+
+        std::string file = (std::filesystem::temp_directory_path() / "kern_encode_image_test.dds").string();
+        REQUIRE(save(file, baked));
+        Image loaded;
+        // Requested format is ignored for containers
+        REQUIRE(load(file, ColorFormat::RGB24, loaded));
+        std::remove(file.c_str());
+
+        CHECK(loaded.m_format == format);
+        CHECK(loaded.m_width == baked.m_width);
+        CHECK(loaded.m_height == baked.m_height);
+        CHECK(loaded.m_levels == baked.m_levels);
+        CHECK(loaded.m_data == baked.m_data);
+    }
+}
+
+TEST_CASE("DDS mip counts are validated", "[resource]")
+{
+    Image baked;
+    REQUIRE(encode(createGradient(32, 16), ColorFormat::BC1, true, baked));
+    std::string file = (std::filesystem::temp_directory_path() / "kern_mip_count_test.dds").string();
+    REQUIRE(save(file, baked));
+
+    // Overwrites a 32 bit header field of the saved file
+    auto patch = [&file](std::streamoff offset, std::uint32_t value) {
+        std::fstream stream(file, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(offset);
+        stream.write((const char *)&value, sizeof(value));
+    };
+
+    // Counts beyond the full mip chain are rejected before sizing the chain
+    Image loaded;
+    patch(28, 0xFFFFFFFF);
+    CHECK_FALSE(load(file, ColorFormat::RGB24, loaded));
+    patch(28, baked.m_levels);
+
+    // Sizes beyond the texture limit are rejected, also where the block count would wrap
+    patch(16, 0xFFFFFFFF);
+    CHECK_FALSE(load(file, ColorFormat::RGB24, loaded));
+    patch(16, 16385);
+    CHECK_FALSE(load(file, ColorFormat::RGB24, loaded));
+    patch(16, 32);
+
+    // Without the mip count flag only the base level is loaded
+    patch(8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x80000);
+    REQUIRE(load(file, ColorFormat::RGB24, loaded));
+    CHECK(loaded.m_levels == 1);
+    CHECK(loaded.m_data.size() == getImageSize(ColorFormat::BC1, 32, 16));
+    std::remove(file.c_str());
+}
+
+TEST_CASE("DDS sRGB formats are rejected", "[resource]")
+{
+    Image baked;
+    REQUIRE(encode(createGradient(16, 16), ColorFormat::BC7, false, baked));
+    std::string file = (std::filesystem::temp_directory_path() / "kern_srgb_test.dds").string();
+    REQUIRE(save(file, baked));
+
+    // DXGI format of the DX10 header, BC7 sRGB
+    {
+        std::fstream stream(file, std::ios::binary | std::ios::in | std::ios::out);
+        std::uint32_t format = 99;
+        stream.seekp(128);
+        stream.write((const char *)&format, sizeof(format));
+    }
+    Image loaded;
+    CHECK_FALSE(load(file, ColorFormat::RGB24, loaded));
+    std::remove(file.c_str());
+}
@@ -0,0 +1,373 @@
+#include <fmtlog/fmtlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "kern/foundation/JobSystem.h"
+#include "kern/graphics/IRenderer.h"
+#include "kern/graphics/Window.h"
+#include "kern/graphics/animation/AnimationWorld.h"
+#include "kern/graphics/camera/FirstPersonCamera.h"
+#include "kern/graphics/io/SceneLoader.h"
+#include "kern/graphics/renderer/DeferredRenderer.h"
+#include "kern/graphics/renderer/ForwardRenderer.h"
+#include "kern/graphics/renderer/RenderStats.h"
+#include "kern/graphics/renderer/RendererCoreConfig.h"
+#include "kern/graphics/resource/GraphicsResourceManager.h"
+#include "kern/graphics/scene/Scene.h"
+#include "kern/resource/ResourceManager.h"
+
+/**
+ * \brief Benchmark parameters, set from the command line.
+ */
+struct SConfig
+{
+    std::string dataDirectory = std::string(KERN_DEMO_DIRECTORY) + "/RTR2014";
+    std::string output;
+    unsigned int objects = 1000;
+    unsigned int lights = 32;
+    unsigned int frames = 200;
+    unsigned int warmupFrames = 30;
+    unsigned int width = 1280;
+    unsigned int height = 720;
+};
+
+/**
+ * \brief Measurements of a single frame.
+ */
+struct SFrame
+{
+    double cpuMs = 0.0;
+    double gpuMs = 0.0;
+    SRenderStats stats;
+};
+
+// Parses a non-negative count, std::stoul throws on invalid input and accepts signs and trailing characters
+static bool parseCount(const std::string &name, const std::string &value, unsigned int &count)
+{
+    std::size_t length = 0;
+    unsigned long result = 0;
+    try
+    {
+        result = std::stoul(value, &length);
+    }
+    catch (const std::invalid_argument &)
+    {
+        length = 0;
+    }
+    catch (const std::out_of_range &)
+    {
+        length = 0;
+    }
+    if (length == 0 || length != value.size() || value[0] == '-' || value[0] == '+' ||
+        result > std::numeric_limits<unsigned int>::max())
+    {
+        loge("Invalid value {} for argument {}.", value, name);
+        return false;
+    }
+    count = (unsigned int)result;
+    return true;
+}
+
+static bool parseArguments(int argc, const char **argv, SConfig &config)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string name = argv[i];
+        std::string value = argv[i + 1];
+        bool valid = true;
+        if (name == "--data")
+        {
+            config.dataDirectory = value;
+        }
+        else if (name == "--out")
+        {
+            config.output = value;
+        }
+        else if (name == "--objects")
+        {
+            valid = parseCount(name, value, config.objects);
+        }
+        else if (name == "--lights")
+        {
+            valid = parseCount(name, value, config.lights);
+        }
+        else if (name == "--frames")
+        {
+            valid = parseCount(name, value, config.frames);
+        }
+        else if (name == "--warmup")
+        {
+            valid = parseCount(name, value, config.warmupFrames);
+        }
+        else if (name == "--width")
+        {
+            valid = parseCount(name, value, config.width);
+        }
+        else if (name == "--height")
+        {
+            valid = parseCount(name, value, config.height);
+        }
+        else
+        {
+            loge("Unknown argument {}.", name);
+            valid = false;
+        }
+        if (!valid)
+        {
+            return false;
+        }
+    }
+    return argc % 2 == 1 && config.frames > 0;
+}
+
+// Grid of objects with the meshes and materials of the test scenes, lights above the grid
+static bool writeScene(const std::string &file, unsigned int objectCount, unsigned int lightCount)
+{
+    const char *meshes[] = {"data/mesh/cube.obj", "data/mesh/sphere.obj"};
+    const char *materials[] = {"data/material/brick_1_diffuse_normal_specular.ini",
+                               "data/material/moss_1_diffuse_normal.ini",
+                               "data/material/metal_1_diffuse_specular.ini"};
+    unsigned int columns = std::max(1u, (unsigned int)std::ceil(std::sqrt((float)objectCount)));
+    float extent = (float)columns * 2.f;
+
+    nlohmann::json root;
+    root["scene_objects"] = nlohmann::json::array();
+    for (unsigned int i = 0; i < objectCount; ++i)
+    {
+        float x = (float)(i % columns) * 2.f;
+        float z = (float)(i / columns) * 2.f;
+        root["scene_objects"].push_back({{"mesh", meshes[i % 2]},
+                                         {"material", materials[i % 3]},
+                                         {"position", {x, 0.f, z}},
+                                         {"rotation", {0.f, (float)((i * 37) % 360), 0.f}},
+                                         {"scale", {0.8f, 0.8f, 0.8f}}});
+    }
+    root["point_lights"] = nlohmann::json::array();
+    unsigned int lightColumns = std::max(1u, (unsigned int)std::ceil(std::sqrt((float)lightCount)));
+    for (unsigned int i = 0; i < lightCount; ++i)
+    {
+        float x = ((float)(i % lightColumns) + 0.5f) / (float)lightColumns * extent;
+        float z = ((float)(i / lightColumns) + 0.5f) / (float)lightColumns * extent;
+        root["point_lights"].push_back({{"position", {x, 2.f, z}},
+                                        {"color", {0.5f + (float)(i % 2) * 0.5f, 0.8f, 1.f - (float)(i % 3) * 0.3f}},
+                                        {"radius", extent / (float)lightColumns * 1.5f},
+                                        {"intensity", 2.f},
+                                        {"casts_shadow", false}});
+    }
+    root["directional_lights"] = {{{"direction", {-0.3f, -1.f, -0.2f}},
+                                   {"color", {1.f, 0.95f, 0.9f}},
+                                   {"intensity", 0.8f},
+                                   {"casts_shadow", true}}};
+    root["ambient_light"] = {{"color", {1.f, 1.f, 1.f}}, {"intensity", 0.1f}};
+
+    std::ofstream stream(file);
+    stream << root.dump(4);
+    return (bool)stream;
+}
+
+static nlohmann::json summarize(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double value : values)
+    {
+        sum += value;
+    }
+    return {{"mean", sum / (double)values.size()},
+            {"median", values[values.size() / 2]},
+            {"min", values.front()},
+            {"max", values.back()}};
+}
+
+static nlohmann::json summarize(const std::vector<SFrame> &frames)
+{
+    std::vector<double> cpu;
+    std::vector<double> gpu;
+    double drawCalls = 0.0;
+    double programBinds = 0.0;
+    double textureBinds = 0.0;
+    double frameBufferBinds = 0.0;
+    double uniformUpdates = 0.0;
+    for (const auto &frame : frames)
+    {
+        cpu.push_back(frame.cpuMs);
+        gpu.push_back(frame.gpuMs);
+        drawCalls += frame.stats.drawCalls;
+        programBinds += frame.stats.programBinds;
+        textureBinds += frame.stats.textureBinds;
+        frameBufferBinds += frame.stats.frameBufferBinds;
+        uniformUpdates += frame.stats.uniformUpdates;
+    }
+    double count = (double)frames.size();
+    return {{"cpuMs", summarize(cpu)},
+            {"gpuMs", summarize(gpu)},
+            {"glCallsPerFrame",
+             {{"drawCalls", drawCalls / count},
+              {"programBinds", programBinds / count},
+              {"textureBinds", textureBinds / count},
+              {"frameBufferBinds", frameBufferBinds / count},
+              {"uniformUpdates", uniformUpdates / count}}}};
+}
+
+// Draws the warmup frames unmeasured, texture streaming and shader linking settle during warmup
+static std::vector<SFrame> runFrames(IRenderer &renderer, const IScene &scene, const ICamera &camera,
+                                     const Window &window, GraphicsResourceManager &manager,
+                                     const SConfig &config)
+{
+    GLuint query = 0;
+    glGenQueries(1, &query);
+
+    std::vector<SFrame> frames;
+    for (unsigned int i = 0; i < config.warmupFrames + config.frames; ++i)
+    {
+        manager.update();
+
+        SFrame frame;
+        resetRenderStats();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        auto start = std::chrono::steady_clock::now();
+        renderer.draw(scene, camera, window, manager);
+        auto end = std::chrono::steady_clock::now();
+        glEndQuery(GL_TIME_ELAPSED);
+        frame.stats = getRenderStats();
+
+        // Waits for the GPU, keeps frames from overlapping so the timer covers a single frame
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+        frame.cpuMs = std::chrono::duration<double, std::milli>(end - start).count();
+        frame.gpuMs = (double)elapsed / 1000000.0;
+        if (i >= config.warmupFrames)
+        {
+            frames.push_back(frame);
+        }
+    }
+
+    glDeleteQueries(1, &query);
+    return frames;
+}
+
+// Flushes pending log messages
+static int finish(int code)
+{
+    fmtlog::stopPollingThread();
+    return code;
+}
+
+static std::string getString(GLenum name)
+{
+    const GLubyte *value = glGetString(name);
+    return value == nullptr ? "" : (const char *)value;
+}
+
+// Usage: RenderBench [--data <demo directory>] [--out <results.json>] [--objects N] [--lights N] [--frames N]
+//                    [--warmup N] [--width N] [--height N]
+// Renders into a hidden window, on machines without GPU use Mesa llvmpipe (LIBGL_ALWAYS_SOFTWARE=1) with a virtual
+// display, e.g. xvfb-run.
+int main(int argc, const char **argv)
+{
+    fmtlog::setLogLevel(fmtlog::WRN);
+    fmtlog::startPollingThread();
+
+    SConfig config;
+    if (!parseArguments(argc, argv, config))
+    {
+        loge("Usage: RenderBench [--data <demo directory>] [--out <results.json>] [--objects N] [--lights N] "
+             "[--frames N] [--warmup N] [--width N] [--height N]");
+        return finish(EXIT_FAILURE);
+    }
+
+    // Resources of the renderers and the scene are relative to the demo directory
+    std::error_code error;
+    if (!config.output.empty())
+    {
+        config.output = std::filesystem::absolute(config.output).string();
+    }
+    std::filesystem::current_path(config.dataDirectory, error);
+    if (error)
+    {
+        loge("Failed to open data directory {}.", config.dataDirectory);
+        return finish(EXIT_FAILURE);
+    }
+
+    Window window;
+    try
+    {
+        if (!window.init(config.width, config.height, "RenderBench", false))
+        {
+            loge("Failed to create offscreen GL context.");
+            return finish(EXIT_FAILURE);
+        }
+    }
+    catch (const std::runtime_error &e)
+    {
+        loge("Failed to create offscreen GL context: {}", e.what());
+        return finish(EXIT_FAILURE);
+    }
+
+    ResourceManager resourceManager;
+    GraphicsResourceManager graphicsResourceManager;
+    resourceManager.addResourceListener(&graphicsResourceManager);
+
+    std::unique_ptr<DeferredRenderer> deferredRenderer(DeferredRenderer::create(resourceManager));
+    std::unique_ptr<ForwardRenderer> forwardRenderer(ForwardRenderer::create(resourceManager));
+    if (deferredRenderer == nullptr || forwardRenderer == nullptr)
+    {
+        loge("Failed to initialize renderers.");
+        return finish(EXIT_FAILURE);
+    }
+
+    std::string sceneFile = (std::filesystem::temp_directory_path() / "kern_render_bench_scene.json").string();
+    JobSystem jobs(0);
+    Scene scene(&graphicsResourceManager, jobs);
+    AnimationWorld animationWorld;
+    if (!writeScene(sceneFile, config.objects, config.lights) ||
+        !SceneLoader(resourceManager).load(sceneFile, scene, animationWorld))
+    {
+        loge("Failed to load benchmark scene.");
+        return finish(EXIT_FAILURE);
+    }
+    std::filesystem::remove(sceneFile, error);
+    graphicsResourceManager.resolveShaderPrograms(true);
+
+    // Looks diagonally over the grid, about half of the objects are visible
+    float extent = std::ceil(std::sqrt((float)std::max(1u, config.objects))) * 2.f;
+    FirstPersonCamera camera(glm::vec3(-4.f, extent * 0.25f + 2.f, -4.f), glm::vec3(extent * 0.5f, 0.f, extent * 0.5f),
+                             glm::vec3(0.f, 1.f, 0.f), 45.f, (float)window.getWidth() / (float)window.getHeight(),
+                             0.1f, extent * 2.f);
+
+    nlohmann::json results;
+    results["config"] = {{"objects", config.objects}, {"lights", config.lights},
+                         {"frames", config.frames},   {"warmupFrames", config.warmupFrames},
+                         {"width", window.getWidth()}, {"height", window.getHeight()}};
+    results["gl"] = {{"vendor", getString(GL_VENDOR)},
+                     {"renderer", getString(GL_RENDERER)},
+                     {"version", getString(GL_VERSION)}};
+    results["renderers"]["deferred"] =
+        summarize(runFrames(*deferredRenderer, scene, camera, window, graphicsResourceManager, config));
+    results["renderers"]["forward"] =
+        summarize(runFrames(*forwardRenderer, scene, camera, window, graphicsResourceManager, config));
+
+    if (config.output.empty())
+    {
+        std::cout << results.dump(4) << std::endl;
+    }
+    else
+    {
+        std::ofstream(config.output) << results.dump(4);
+        logi("Saved benchmark results to {}.", config.output);
+    }
+    return finish(EXIT_SUCCESS);
+}
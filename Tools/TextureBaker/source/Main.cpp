@@ -0,0 +1,63 @@
+#include <fmtlog/fmtlog.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "kern/resource/EncodeImage.h"
+#include "kern/resource/LoadImage.h"
+#include "kern/resource/SaveImage.h"
+
+// Usage: TextureBaker <input image> <output.dds> <bc1|bc3|bc5|bc7> [--no-mipmaps]
+int main(int argc, const char** argv)
+{
+    fmtlog::setLogLevel(fmtlog::INF);
+
+    if (argc < 4)
+    {
+        loge("Usage: TextureBaker <input image> <output.dds> <bc1|bc3|bc5|bc7> [--no-mipmaps]");
+        fmtlog::poll(true);
+        return EXIT_FAILURE;
+    }
+
+    std::string input = argv[1];
+    std::string output = argv[2];
+    std::string formatName = argv[3];
+    bool createMipmaps = !(argc > 4 && std::strcmp(argv[4], "--no-mipmaps") == 0);
+
+    ColorFormat format = ColorFormat::Invalid;
+    if (formatName == "bc1")
+    {
+        format = ColorFormat::BC1;
+    }
+    else if (formatName == "bc3")
+    {
+        format = ColorFormat::BC3;
+    }
+    else if (formatName == "bc5")
+    {
+        format = ColorFormat::BC5;
+    }
+    else if (formatName == "bc7")
+    {
+        format = ColorFormat::BC7;
+    }
+    else
+    {
+        loge("Unknown target format {}.", formatName);
+        fmtlog::poll(true);
+        return EXIT_FAILURE;
+    }
+
+    // Loaded flipped, as the engine expects baked textures
+    Image source;
+    Image baked;
+    bool success = load(input, ColorFormat::RGBA32, source) && encode(source, format, createMipmaps, baked) &&
+                   save(output, baked);
+    if (success)
+    {
+        logi("Baked {} to {} with {} levels, {} bytes.", input, output, baked.m_levels, baked.m_data.size());
+    }
+    fmtlog::poll(true);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}